@@ -0,0 +1,166 @@
+#include "../benchmark.hpp"
+
+#include <bit/tools/args/arg_parser.hpp>
+
+#include <memory> // std::unique_ptr
+#include <string> // std::string, std::to_string
+#include <vector> // std::vector
+
+namespace {
+
+  using namespace bit::tools;
+
+  enum class flag_mix
+  {
+    single, ///< Only single-value flags
+    multi,  ///< Only multi-value flags
+    option, ///< Only option flags
+    mixed,  ///< An even mix of all three
+  };
+
+  const char* to_string( flag_mix mix )
+  {
+    switch( mix ) {
+    case flag_mix::single: return "single";
+    case flag_mix::multi:  return "multi";
+    case flag_mix::option: return "option";
+    case flag_mix::mixed:  return "mixed";
+    }
+    return "";
+  }
+
+  //--------------------------------------------------------------------------
+
+  //////////////////////////////////////////////////////////////////////////
+  /// \brief An arg_set populated with generated flags, along with a
+  ///        generated command line that only refers to those flags
+  //////////////////////////////////////////////////////////////////////////
+  struct parser_fixture
+  {
+    arg_set set;
+
+    std::vector<std::string> names;
+    std::vector<std::unique_ptr<single_arg>> singles;
+    std::vector<std::unique_ptr<multi_arg>>  multis;
+    std::vector<std::unique_ptr<option_arg>> options;
+    std::vector<std::unique_ptr<alias_arg>>  aliases;
+
+    std::vector<std::string> tokens;
+    std::vector<const char*> argv;
+
+    parser_fixture( std::size_t argc,
+                    std::size_t flags,
+                    std::size_t alias_depth,
+                    flag_mix mix )
+    {
+      // Names are reserved up front so that the string_views stored in the
+      // flags are never invalidated
+      names.reserve( flags * (alias_depth + 1) );
+
+      auto kinds = std::vector<flag_mix>{};
+      auto spelling = std::vector<std::size_t>{};
+
+      for( auto i = std::size_t{0}; i < flags; ++i ) {
+        const auto kind = (mix == flag_mix::mixed) ? static_cast<flag_mix>(i % 3) : mix;
+
+        names.push_back( "--flag-" + std::to_string(i) );
+        const auto& name = names.back();
+
+        alias_arg* alias = nullptr;
+        const auto make_alias = [&]( auto& target, std::size_t depth ) {
+          names.push_back( name + "-alias-" + std::to_string(depth) );
+          aliases.emplace_back( new alias_arg( target, names.back() ) );
+          alias = aliases.back().get();
+        };
+
+        switch( kind ) {
+        case flag_mix::single:
+          singles.emplace_back( new single_arg( set, name ) );
+          if( alias_depth ) make_alias( *singles.back(), 1 );
+          break;
+        case flag_mix::multi:
+          multis.emplace_back( new multi_arg( set, name ) );
+          if( alias_depth ) make_alias( *multis.back(), 1 );
+          break;
+        default:
+          options.emplace_back( new option_arg( set, name ) );
+          if( alias_depth ) make_alias( *options.back(), 1 );
+          break;
+        }
+        for( auto d = std::size_t{2}; d <= alias_depth; ++d ) {
+          make_alias( *alias, d );
+        }
+        kinds.push_back( kind );
+        spelling.push_back( names.size() - 1 );
+      }
+
+      // Generate a command line that cycles through the flags, where every
+      // value is consumed by a flag so nothing is left unmatched
+      for( auto i = std::size_t{0}; tokens.size() < argc; ++i ) {
+        const auto f = (i * 7919) % flags;
+
+        tokens.push_back( names[spelling[f]] );
+        switch( kinds[f] ) {
+        case flag_mix::single:
+          tokens.push_back( "value" );
+          break;
+        case flag_mix::multi:
+          tokens.push_back( "first" );
+          tokens.push_back( "second" );
+          break;
+        default:
+          break;
+        }
+      }
+      tokens.resize( argc );
+
+      for( const auto& token : tokens ) {
+        argv.push_back( token.c_str() );
+      }
+    }
+
+    arg_vector args() const noexcept
+    {
+      return arg_vector( static_cast<int>(argv.size()), argv.data() );
+    }
+  };
+
+} // anonymous namespace
+
+//----------------------------------------------------------------------------
+
+BIT_TOOLS_BENCHMARK(parse_arguments_benchmark)
+{
+  const std::size_t argcs[]        = { 8, 64, 512 };
+  const std::size_t flag_counts[]  = { 8, 32, 128 };
+  const std::size_t alias_depths[] = { 0, 2 };
+  const flag_mix mixes[] = {
+    flag_mix::single, flag_mix::multi, flag_mix::option, flag_mix::mixed
+  };
+
+  for( auto argc : argcs ) {
+    for( auto flags : flag_counts ) {
+      for( auto depth : alias_depths ) {
+        for( auto mix : mixes ) {
+          const auto name = "parse_arguments/argc:" + std::to_string(argc) +
+                            "/flags:" + std::to_string(flags) +
+                            "/alias:" + std::to_string(depth) +
+                            "/mix:" + to_string(mix);
+
+          if( !context.enabled(name) ) continue;
+
+          auto fixture = std::unique_ptr<parser_fixture>(
+            new parser_fixture( argc, flags, depth, mix )
+          );
+          const auto args = fixture->args();
+          auto* set = &fixture->set;
+
+          context.run( name, argc, "arg", [&]{
+            auto result = parse_arguments( set, args );
+            bit::tools::benchmark::do_not_optimize( result );
+          });
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,1650 @@
+#include "../benchmark.hpp"
+
+#include <bit/tools/args/arg_suggestor.hpp>
+#include <bit/tools/args/bk_tree_index.hpp>
+#include <bit/tools/args/mapped_symspell_index.hpp>
+#include <bit/tools/args/suggestion_cache.hpp>
+#include <bit/tools/args/symspell_index.hpp>
+#include <bit/tools/args/trie_index.hpp>
+#include <bit/tools/args/trigram_index.hpp>
+#include <bit/tools/args/weighted_distance.hpp>
+
+#include <algorithm> // std::min, std::sort, std::unique
+#include <atomic>    // std::atomic
+#include <cstdio>    // std::remove
+#include <fstream>   // std::ofstream
+#include <random>    // std::mt19937
+#include <string>    // std::string, std::to_string
+#include <thread>    // std::thread
+#include <utility>   // std::pair, std::swap
+#include <vector>    // std::vector
+
+namespace {
+
+  using namespace bit::tools;
+
+  /// \brief Generates \p count pairs of flag-like strings of length
+  ///        \p length, where the second of each pair has \p edits typos
+  std::vector<std::pair<std::string,std::string>>
+    make_pairs( std::size_t count, std::size_t length, std::size_t edits )
+  {
+    auto rng = std::mt19937{ static_cast<std::mt19937::result_type>(length) };
+    auto pairs = std::vector<std::pair<std::string,std::string>>{};
+
+    for( auto i = std::size_t{0}; i < count; ++i ) {
+      auto lhs = std::string( length, 'a' );
+      for( auto& c : lhs ) {
+        c = static_cast<char>('a' + rng() % 26);
+      }
+      auto rhs = lhs;
+      for( auto e = std::size_t{0}; e < edits && !rhs.empty(); ++e ) {
+        const auto pos = rng() % rhs.size();
+        switch( rng() % 3 ) {
+        case 0:  rhs[pos] = static_cast<char>('a' + rng() % 26); break;
+        case 1:  rhs.erase( pos, 1 ); break;
+        default: rhs.insert( pos, 1, static_cast<char>('a' + rng() % 26) ); break;
+        }
+      }
+      pairs.emplace_back( std::move(lhs), std::move(rhs) );
+    }
+    return pairs;
+  }
+
+  /// \brief The textbook full-matrix optimal string alignment distance,
+  ///        used as the baseline for damerau_levenshtein_distance
+  std::size_t reference_osa_distance( const std::string& lhs,
+                                      const std::string& rhs )
+  {
+    const auto n = lhs.size();
+    const auto m = rhs.size();
+    auto d = std::vector<std::size_t>( (n + 1) * (m + 1) );
+    const auto at = [&]( std::size_t i, std::size_t j ) -> std::size_t& {
+      return d[i * (m + 1) + j];
+    };
+
+    for( auto i = std::size_t{0}; i <= n; ++i ) at(i,0) = i;
+    for( auto j = std::size_t{0}; j <= m; ++j ) at(0,j) = j;
+
+    for( auto i = std::size_t{1}; i <= n; ++i ) {
+      for( auto j = std::size_t{1}; j <= m; ++j ) {
+        const auto cost = (lhs[i-1] == rhs[j-1]) ? 0u : 1u;
+        at(i,j) = std::min( std::min( at(i-1,j) + 1, at(i,j-1) + 1 ), at(i-1,j-1) + cost );
+        if( i > 1 && j > 1 && lhs[i-1] == rhs[j-2] && lhs[i-2] == rhs[j-1] ) {
+          at(i,j) = std::min( at(i,j), at(i-2,j-2) + 1 );
+        }
+      }
+    }
+    return at(n,m);
+  }
+
+} // anonymous namespace
+
+//----------------------------------------------------------------------------
+
+BIT_TOOLS_BENCHMARK(distance_benchmark)
+{
+  const std::size_t lengths[] = { 8, 16, 32, 64, 128, 256, 1024 };
+
+  for( auto length : lengths ) {
+    const auto pairs = make_pairs( 64, length, 3 );
+
+    context.run( "levenshtein_distance/length:" + std::to_string(length),
+                 pairs.size(), "pair", [&]{
+      auto total = std::size_t{0};
+      for( const auto& p : pairs ) {
+        total += levenshtein_distance( p.first, p.second );
+      }
+      bit::tools::benchmark::do_not_optimize( total );
+    });
+
+    context.run( "damerau_levenshtein_distance/length:" + std::to_string(length),
+                 pairs.size(), "pair", [&]{
+      auto total = std::size_t{0};
+      for( const auto& p : pairs ) {
+        total += damerau_levenshtein_distance( p.first, p.second );
+      }
+      bit::tools::benchmark::do_not_optimize( total );
+    });
+
+    context.run( "reference_osa_distance/length:" + std::to_string(length),
+                 pairs.size(), "pair", [&]{
+      auto total = std::size_t{0};
+      for( const auto& p : pairs ) {
+        total += reference_osa_distance( p.first, p.second );
+      }
+      bit::tools::benchmark::do_not_optimize( total );
+    });
+  }
+}
+
+//----------------------------------------------------------------------------
+
+BIT_TOOLS_BENCHMARK(distance_verification)
+{
+  // Every pair measured above, and the same pairs with a few adjacent
+  // characters swapped, so that transpositions are checked too. Lengths
+  // above 64 take the multi-word kernels
+  const std::size_t lengths[]   = { 1, 8, 16, 32, 63, 64, 65, 128, 256, 1024 };
+  const std::size_t edits[]     = { 0, 1, 3, 8 };
+  const std::size_t distances[] = { 0, 1, 2, 4, 16 };
+
+  for( auto length : lengths ) {
+    const auto name = "damerau_levenshtein_distance/verify/length:" + std::to_string(length);
+    if( !context.enabled( name ) ) continue;
+
+    auto rng = std::mt19937{ static_cast<std::mt19937::result_type>(length) };
+    auto passed = true;
+
+    for( auto e : edits ) {
+      auto pairs = make_pairs( 64, length, e );
+      for( auto i = std::size_t{0}, n = pairs.size(); i < n; ++i ) {
+        auto swapped = pairs[i].second;
+        for( auto s = std::size_t{0}; s < e + 1 && swapped.size() > 1; ++s ) {
+          const auto pos = rng() % (swapped.size() - 1);
+          std::swap( swapped[pos], swapped[pos + 1] );
+        }
+        pairs.emplace_back( pairs[i].first, std::move(swapped) );
+      }
+
+      for( const auto& p : pairs ) {
+        const auto expected = reference_osa_distance( p.first, p.second );
+
+        passed = passed && damerau_levenshtein_distance( p.first, p.second ) == expected;
+        for( auto max : distances ) {
+          const auto bounded = (expected <= max) ? expected : max + 1;
+          passed = passed && damerau_levenshtein_distance( p.first, p.second, max ) == bounded;
+        }
+      }
+    }
+    context.verify( name, passed );
+  }
+}
+
+//----------------------------------------------------------------------------
+
+BIT_TOOLS_BENCHMARK(bounded_distance_benchmark)
+{
+  // Mostly-unrelated pairs, as seen when scanning a list of candidates for
+  // a typo: nearly every pair is rejected by the bound
+  const std::size_t lengths[]   = { 8, 16, 64, 256, 1024 };
+  const std::size_t distances[] = { 1, 2, 4 };
+
+  for( auto length : lengths ) {
+    const auto pairs = make_pairs( 64, length, length / 2 );
+
+    for( auto max : distances ) {
+      const auto suffix = "/length:" + std::to_string(length) +
+                          "/max:" + std::to_string(max);
+
+      context.run( "levenshtein_distance/bounded" + suffix,
+                   pairs.size(), "pair", [&]{
+        auto total = std::size_t{0};
+        for( const auto& p : pairs ) {
+          total += levenshtein_distance( p.first, p.second, max );
+        }
+        bit::tools::benchmark::do_not_optimize( total );
+      });
+
+      context.run( "damerau_levenshtein_distance/bounded" + suffix,
+                   pairs.size(), "pair", [&]{
+        auto total = std::size_t{0};
+        for( const auto& p : pairs ) {
+          total += damerau_levenshtein_distance( p.first, p.second, max );
+        }
+        bit::tools::benchmark::do_not_optimize( total );
+      });
+    }
+
+    context.run( "levenshtein_distance/unbounded/length:" + std::to_string(length),
+                 pairs.size(), "pair", [&]{
+      auto total = std::size_t{0};
+      for( const auto& p : pairs ) {
+        total += levenshtein_distance( p.first, p.second );
+      }
+      bit::tools::benchmark::do_not_optimize( total );
+    });
+  }
+}
+
+//----------------------------------------------------------------------------
+
+BIT_TOOLS_BENCHMARK(batch_distance_benchmark)
+{
+  // A dictionary of flag-like candidates, scored against a single query
+  const std::size_t counts[] = { 64, 4096, 65536 };
+
+  for( auto count : counts ) {
+    auto rng = std::mt19937{ static_cast<std::mt19937::result_type>(count) };
+
+    auto words = std::vector<std::string>{};
+    words.reserve( count );
+    for( auto i = std::size_t{0}; i < count; ++i ) {
+      auto word = std::string( 6 + rng() % 15, 'a' );
+      for( auto& c : word ) {
+        c = static_cast<char>('a' + rng() % 26);
+      }
+      words.push_back( std::move(word) );
+    }
+    const auto candidates = std::vector<bit::stl::string_view>( words.begin(), words.end() );
+    const auto query = bit::stl::string_view{ "--recursive" };
+
+    auto distances = std::vector<std::size_t>( count );
+
+    const auto scalar = context.run( "levenshtein_distance/candidates:" + std::to_string(count),
+                                     count, "cand", [&]{
+      for( auto i = std::size_t{0}; i < count; ++i ) {
+        distances[i] = levenshtein_distance( query, candidates[i] );
+      }
+      bit::tools::benchmark::do_not_optimize( distances.data() );
+    });
+    if( scalar.iterations ) {
+      context.report( "throughput", 1e3 / scalar.ns_per_item, "Mcand/s" );
+    }
+
+    const auto batched = context.run( "levenshtein_distances/candidates:" + std::to_string(count),
+                                      count, "cand", [&]{
+      levenshtein_distances( distances.data(), query, candidates.data(), count );
+      bit::tools::benchmark::do_not_optimize( distances.data() );
+    });
+    if( batched.iterations ) {
+      context.report( "throughput", 1e3 / batched.ns_per_item, "Mcand/s" );
+    }
+
+    // As scored by letter_set_index, which bounds every candidate by the
+    // suggestor's max distance
+    const auto bounded_scalar = context.run( "levenshtein_distance/max:2/candidates:" + std::to_string(count),
+                                             count, "cand", [&]{
+      for( auto i = std::size_t{0}; i < count; ++i ) {
+        distances[i] = levenshtein_distance( query, candidates[i], 2 );
+      }
+      bit::tools::benchmark::do_not_optimize( distances.data() );
+    });
+    if( bounded_scalar.iterations ) {
+      context.report( "throughput", 1e3 / bounded_scalar.ns_per_item, "Mcand/s" );
+    }
+
+    const auto bounded_batched = context.run( "levenshtein_distances/max:2/candidates:" + std::to_string(count),
+                                              count, "cand", [&]{
+      levenshtein_distances( distances.data(), query, candidates.data(), count, 2 );
+      bit::tools::benchmark::do_not_optimize( distances.data() );
+    });
+    if( bounded_batched.iterations ) {
+      context.report( "throughput", 1e3 / bounded_batched.ns_per_item, "Mcand/s" );
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+
+BIT_TOOLS_BENCHMARK(batch_distance_verification)
+{
+  // Candidates of every length around the query, so that batches mix lanes
+  // that are rejected by length, retired early, and scored to the end.
+  // Queries above 64 characters take the one-at-a-time path
+  const std::size_t lengths[]   = { 1, 8, 16, 40, 64, 65, 100 };
+  const std::size_t distances[] = { 0, 1, 2, 4, 16 };
+
+  for( auto length : lengths ) {
+    const auto name = "levenshtein_distances/verify/length:" + std::to_string(length);
+    if( !context.enabled( name ) ) continue;
+
+    auto passed = true;
+    for( auto e : { std::size_t{0}, std::size_t{1}, std::size_t{3}, std::size_t{8} } ) {
+      const auto pairs = make_pairs( 64, length, e );
+
+      for( auto j = std::size_t{0}; j < pairs.size(); j += 16 ) {
+        const auto query = bit::stl::string_view{ pairs[j].first };
+
+        // Every typo'd string, of which one is e typos from the query, and
+        // each prefix of that one
+        auto candidates = std::vector<bit::stl::string_view>{};
+        for( const auto& p : pairs ) {
+          candidates.emplace_back( p.second );
+        }
+        for( auto n = std::size_t{0}; n <= pairs[j].second.size(); ++n ) {
+          candidates.emplace_back( pairs[j].second.data(), n );
+        }
+
+        auto actual = std::vector<std::size_t>( candidates.size() );
+        for( auto max : distances ) {
+          levenshtein_distances( actual.data(), query, candidates.data(), candidates.size(), max );
+          for( auto i = std::size_t{0}; i < candidates.size(); ++i ) {
+            passed = passed && actual[i] == levenshtein_distance( query, candidates[i], max );
+          }
+        }
+        levenshtein_distances( actual.data(), query, candidates.data(), candidates.size() );
+        for( auto i = std::size_t{0}; i < candidates.size(); ++i ) {
+          passed = passed && actual[i] == levenshtein_distance( query, candidates[i] );
+        }
+      }
+    }
+    context.verify( name, passed );
+  }
+}
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+  /// \brief Copies \p str into \p CharT, moving each character up by
+  ///        \p offset so that wide alphabets can be measured too
+  template<typename CharT>
+  std::basic_string<CharT> widen( const std::string& str, char32_t offset )
+  {
+    auto result = std::basic_string<CharT>{};
+    result.reserve( str.size() );
+    for( auto c : str ) {
+      result.push_back( static_cast<CharT>(static_cast<char32_t>(c) + offset) );
+    }
+    return result;
+  }
+
+  /// \brief Measures the bounded distance of \p pairs, widened into
+  ///        \p CharT
+  template<typename CharT>
+  bit::tools::benchmark::result
+    run_wide_distance( bit::tools::benchmark::context& context,
+                       const std::string& name,
+                       const std::vector<std::pair<std::string,std::string>>& pairs,
+                       char32_t offset,
+                       std::size_t max )
+  {
+    using string_view_type = bit::stl::basic_string_view<CharT>;
+
+    auto wide = std::vector<std::pair<std::basic_string<CharT>,std::basic_string<CharT>>>{};
+    for( const auto& p : pairs ) {
+      wide.emplace_back( widen<CharT>( p.first, offset ), widen<CharT>( p.second, offset ) );
+    }
+
+    return context.run( name, wide.size(), "pair", [&]{
+      auto total = std::size_t{0};
+      for( const auto& p : wide ) {
+        total += levenshtein_distance( string_view_type{ p.first }, string_view_type{ p.second }, max );
+      }
+      bit::tools::benchmark::do_not_optimize( total );
+    });
+  }
+
+} // anonymous namespace
+
+BIT_TOOLS_BENCHMARK(wide_distance_benchmark)
+{
+  // The same pairs in each character type: ASCII in wchar_t looks up the
+  // table of small characters, and CJK in char32_t the hashed table
+  const std::size_t lengths[] = { 8, 16, 32, 64, 128 };
+  const auto max = std::size_t{3};
+
+  for( auto length : lengths ) {
+    const auto suffix = "/length:" + std::to_string(length);
+    const auto pairs  = make_pairs( 64, length, 2 );
+
+    const auto narrow = context.run( "levenshtein_distance/char" + suffix, pairs.size(), "pair", [&]{
+      auto total = std::size_t{0};
+      for( const auto& p : pairs ) {
+        total += levenshtein_distance( p.first, p.second, max );
+      }
+      bit::tools::benchmark::do_not_optimize( total );
+    });
+    const auto ascii = run_wide_distance<wchar_t>( context, "levenshtein_distance/wchar_t" + suffix,
+                                                   pairs, 0, max );
+    const auto cjk   = run_wide_distance<char32_t>( context, "levenshtein_distance/char32_t:cjk" + suffix,
+                                                    pairs, 0x4E00 - 'a', max );
+
+    if( narrow.iterations && ascii.iterations ) {
+      context.report( "wchar_t relative to char", narrow.ns_per_op / ascii.ns_per_op, "x" );
+    }
+    if( narrow.iterations && cjk.iterations ) {
+      context.report( "char32_t relative to char", narrow.ns_per_op / cjk.ns_per_op, "x" );
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+
+BIT_TOOLS_BENCHMARK(utf8_distance_benchmark)
+{
+  // ASCII pairs measure the cost of the check before the byte kernels;
+  // accented pairs replace every vowel with a two-byte letter
+  const std::size_t lengths[] = { 8, 16, 32, 64, 256 };
+  const auto max = std::size_t{2};
+
+  for( auto length : lengths ) {
+    const auto suffix = "/length:" + std::to_string(length);
+    const auto pairs  = make_pairs( 64, length, 1 );
+
+    auto accented = std::vector<std::pair<std::string,std::string>>{};
+    for( const auto& p : pairs ) {
+      const auto accent = []( const std::string& str ) {
+        auto result = std::string{};
+        for( auto c : str ) {
+          switch( c ) {
+          case 'a': result += "\xc3\xa0"; break; // a with grave
+          case 'e': result += "\xc3\xa9"; break; // e with acute
+          case 'i': result += "\xc3\xaf"; break; // i with diaeresis
+          case 'o': result += "\xc3\xb4"; break; // o with circumflex
+          case 'u': result += "\xc3\xbc"; break; // u with diaeresis
+          default:  result += c; break;
+          }
+        }
+        return result;
+      };
+      accented.emplace_back( accent( p.first ), accent( p.second ) );
+    }
+
+    const auto run = [&]( const std::string& name,
+                          const std::vector<std::pair<std::string,std::string>>& cases,
+                          std::size_t(*fn)(bit::stl::string_view,bit::stl::string_view,std::size_t) ) {
+      return context.run( name + suffix, cases.size(), "pair", [&]{
+        auto total = std::size_t{0};
+        for( const auto& p : cases ) {
+          total += fn( p.first, p.second, max );
+        }
+        bit::tools::benchmark::do_not_optimize( total );
+      });
+    };
+
+    const auto bytes = run( "levenshtein_distance/ascii", pairs, &levenshtein_distance );
+    const auto ascii = run( "utf8_levenshtein_distance/ascii", pairs, &utf8_levenshtein_distance );
+    if( bytes.iterations && ascii.iterations ) {
+      context.report( "ascii relative to bytes", bytes.ns_per_op / ascii.ns_per_op, "x" );
+    }
+
+    const auto accented_bytes = run( "levenshtein_distance/accented", accented, &levenshtein_distance );
+    const auto decoded        = run( "utf8_levenshtein_distance/accented", accented, &utf8_levenshtein_distance );
+    if( accented_bytes.iterations && decoded.iterations ) {
+      context.report( "decoded relative to bytes", accented_bytes.ns_per_op / decoded.ns_per_op, "x" );
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+  /// \brief Checks the suggestions of a letter_set_index searched with
+  ///        \c Metric against every argument within reach, for words of
+  ///        code points from 1 to 4 bytes long
+  template<typename Metric>
+  bool verify_utf8_suggestions( std::size_t(*distance)(bit::stl::string_view,bit::stl::string_view,std::size_t) )
+  {
+    static const char* const code_points[] = {
+      "a", "b", "c", "-", "\xc3\xa9", "\xc3\xbc", "\xe6\x97\xa5", "\xe6\x9c\xac",
+      "\xe8\xaa\x9e", "\xf0\x9f\x98\x80"
+    };
+    constexpr auto code_point_count = sizeof(code_points) / sizeof(code_points[0]);
+
+    auto rng = std::mt19937{ 48 };
+    const auto make_word = [&]( std::size_t length ) {
+      auto word = std::vector<std::string>{ "-", "-" };
+      for( auto i = std::size_t{0}; i < length; ++i ) {
+        word.emplace_back( code_points[rng() % code_point_count] );
+      }
+      return word;
+    };
+    const auto join = []( const std::vector<std::string>& word ) {
+      auto result = std::string{};
+      for( const auto& c : word ) result += c;
+      return result;
+    };
+
+    // The case of a missing CJK character, three bytes shorter
+    const auto words = std::vector<std::string>{ "--\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e", "--verbose" };
+    const auto exact = metric_suggestor<Metric>{ words.begin(), words.end(), 1 };
+    auto passed = exact.suggest( "--\xe6\x97\xa5\xe6\x9c\xac" ) == words[0];
+
+    auto dictionary = std::vector<std::string>{};
+    for( auto i = 0; i < 2000; ++i ) {
+      dictionary.push_back( join( make_word( 1 + rng() % 8 ) ) );
+    }
+
+    for( auto max : { std::size_t{1}, std::size_t{2} } ) {
+      const auto suggestor = metric_suggestor<Metric>{ dictionary.begin(), dictionary.end(), max };
+
+      for( auto q = 0; q < 200; ++q ) {
+        // Edit a known word by whole code points, beyond max at times
+        const auto& source = dictionary[rng() % dictionary.size()];
+        auto word = std::vector<std::string>{};
+        for( auto i = std::size_t{0}; i < source.size(); ) {
+          const auto lead = static_cast<unsigned char>(source[i]);
+          const auto size = (lead < 0x80) ? 1u : (lead < 0xe0) ? 2u : (lead < 0xf0) ? 3u : 4u;
+          word.push_back( source.substr( i, size ) );
+          i += size;
+        }
+        for( auto e = rng() % (max + 2); e > 0; --e ) {
+          const auto pos = 2 + rng() % (word.size() - 1);
+          switch( rng() % 3 ) {
+          case 0: word.insert( word.begin() + pos, code_points[rng() % code_point_count] ); break;
+          case 1: if( pos < word.size() ) word.erase( word.begin() + pos ); break;
+          default: if( pos < word.size() ) word[pos] = code_points[rng() % code_point_count]; break;
+          }
+        }
+        const auto query = join( word );
+
+        auto expected = std::vector<bit::stl::string_view>{};
+        for( const auto& candidate : dictionary ) {
+          if( distance( query, candidate, max ) <= max ) expected.push_back( candidate );
+        }
+        auto actual = suggestor.suggestions( query );
+        std::sort( expected.begin(), expected.end() );
+        std::sort( actual.begin(), actual.end() );
+        expected.erase( std::unique( expected.begin(), expected.end() ), expected.end() );
+        actual.erase( std::unique( actual.begin(), actual.end() ), actual.end() );
+
+        passed = passed && actual == expected;
+      }
+    }
+    return passed;
+  }
+
+} // anonymous namespace
+
+BIT_TOOLS_BENCHMARK(utf8_suggestor_verification)
+{
+  if( context.enabled( "utf8_levenshtein_metric/verify" ) ) {
+    context.verify( "utf8_levenshtein_metric/verify",
+                    verify_utf8_suggestions<utf8_levenshtein_metric>( &utf8_levenshtein_distance ) );
+  }
+  if( context.enabled( "utf8_damerau_levenshtein_metric/verify" ) ) {
+    context.verify( "utf8_damerau_levenshtein_metric/verify",
+                    verify_utf8_suggestions<utf8_damerau_levenshtein_metric>( &utf8_damerau_levenshtein_distance ) );
+  }
+}
+
+//----------------------------------------------------------------------------
+
+BIT_TOOLS_BENCHMARK(weighted_distance_benchmark)
+{
+  // A plain edit costs 2 in the keyboard table, so a bound of 2 * max admits
+  // the same pairs as a bound of max does for the unit-cost kernel, and
+  // more. Pairs 8 edits apart are rejected by every bound
+  const std::size_t lengths[] = { 8, 16, 32, 64 };
+  const std::size_t edits[]   = { 1, 2, 4, 8 };
+  const std::size_t bounds[]  = { 2, 4 };
+
+  for( auto length : lengths ) {
+    for( auto e : edits ) {
+      const auto pairs = make_pairs( 64, length, e );
+
+      for( auto max : bounds ) {
+        const auto suffix = "/length:" + std::to_string(length) + "/edits:" + std::to_string(e) +
+                            "/max:" + std::to_string(max);
+
+        const auto unit = context.run( "damerau_levenshtein_distance" + suffix, pairs.size(), "pair", [&]{
+          auto total = std::size_t{0};
+          for( const auto& p : pairs ) {
+            total += damerau_levenshtein_distance( p.first, p.second, max );
+          }
+          bit::tools::benchmark::do_not_optimize( total );
+        });
+
+        const auto weighted = context.run( "keyboard_distance" + suffix, pairs.size(), "pair", [&]{
+          auto total = std::size_t{0};
+          for( const auto& p : pairs ) {
+            total += keyboard_distance( p.first, p.second, 2 * max );
+          }
+          bit::tools::benchmark::do_not_optimize( total );
+        });
+
+        if( unit.iterations && weighted.iterations ) {
+          context.report( "weighted relative to unit", unit.ns_per_op / weighted.ns_per_op, "x" );
+        }
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+  /// \brief Generates \p count distinct-ish flag-like words from a small
+  ///        set of syllables, so that words share letters as real flags do
+  std::vector<std::string> make_dictionary( std::size_t count )
+  {
+    static const char* const syllables[] = {
+      "re", "cur", "sive", "ver", "bose", "out", "put", "in", "dex", "no",
+      "color", "force", "all", "dry", "run", "quiet", "path", "max", "depth",
+      "jobs", "log", "level", "file", "name", "ex", "clude", "ig", "ore"
+    };
+    constexpr auto syllable_count = sizeof(syllables) / sizeof(syllables[0]);
+
+    auto rng   = std::mt19937{ 42 };
+    auto words = std::vector<std::string>{};
+    words.reserve( count );
+
+    for( auto i = std::size_t{0}; i < count; ++i ) {
+      auto word = std::string{"--"};
+      const auto parts = 2 + rng() % 3;
+      for( auto p = 0u; p < parts; ++p ) {
+        if( p ) word += '-';
+        word += syllables[rng() % syllable_count];
+      }
+      // Disambiguate with a short random tail, as generated names often are
+      word += static_cast<char>('a' + rng() % 26);
+      word += static_cast<char>('a' + rng() % 26);
+      words.push_back( std::move(word) );
+    }
+    return words;
+  }
+
+  /// \brief Draws \p count words from \p words, and makes up to \p edits
+  ///        random insertions, deletions, substitutions and transpositions
+  ///        in each
+  std::vector<std::string> make_typos( const std::vector<std::string>& words,
+                                       std::size_t count,
+                                       std::size_t edits,
+                                       std::mt19937::result_type seed )
+  {
+    auto rng = std::mt19937{ seed };
+    auto queries = std::vector<std::string>{};
+    queries.reserve( count );
+
+    for( auto i = std::size_t{0}; i < count; ++i ) {
+      auto query = words[rng() % words.size()];
+      for( auto e = rng() % (edits + 1); e > 0; --e ) {
+        const auto pos = rng() % (query.size() + 1);
+        const auto c   = static_cast<char>('a' + rng() % 26);
+        switch( rng() % 4 ) {
+        case 0:  query.insert( pos, 1, c ); break;
+        case 1:  if( pos < query.size() ) query.erase( pos, 1 ); break;
+        case 2:  if( pos < query.size() ) query[pos] = c; break;
+        default: if( pos + 1 < query.size() ) std::swap( query[pos], query[pos + 1] ); break;
+        }
+      }
+      queries.push_back( std::move(query) );
+    }
+    return queries;
+  }
+
+  /// \brief Checks that searching \p index reports exactly the arguments of
+  ///        \p words within \p max of each of \p queries, at the distances
+  ///        that a scan with \p distance finds
+  template<typename Index>
+  bool matches_scan( const Index& index,
+                     const std::vector<std::string>& words,
+                     const std::vector<std::string>& queries,
+                     std::size_t max,
+                     std::size_t(*distance)(bit::stl::string_view,bit::stl::string_view,std::size_t) )
+  {
+    using match = std::pair<bit::stl::string_view,std::size_t>;
+
+    auto passed = true;
+    for( const auto& query : queries ) {
+      auto expected = std::vector<match>{};
+      for( const auto& word : words ) {
+        const auto d = distance( query, word, max );
+        if( d <= max ) expected.emplace_back( word, d );
+      }
+      auto actual = std::vector<match>{};
+      index.search( query, max, [&]( bit::stl::string_view arg, std::size_t d ) {
+        actual.emplace_back( arg, d );
+      });
+
+      // Dictionaries may repeat a word, which an index may store once
+      std::sort( expected.begin(), expected.end() );
+      std::sort( actual.begin(), actual.end() );
+      expected.erase( std::unique( expected.begin(), expected.end() ), expected.end() );
+      actual.erase( std::unique( actual.begin(), actual.end() ), actual.end() );
+
+      passed = passed && actual == expected;
+    }
+    return passed;
+  }
+
+} // anonymous namespace
+
+BIT_TOOLS_BENCHMARK(suggestor_benchmark)
+{
+  const std::size_t sizes[] = { 100, 1000, 10000, 100000, 1000000 };
+
+  for( auto size : sizes ) {
+    const auto name = "arg_suggestor/entries:" + std::to_string(size);
+    if( !context.enabled( name ) ) continue;
+
+    const auto words = make_dictionary( size );
+
+    // Queries are known words with a single typo
+    auto rng = std::mt19937{ 7 };
+    auto queries = std::vector<std::string>{};
+    for( auto i = 0; i < 64; ++i ) {
+      auto query = words[rng() % words.size()];
+      query[2 + rng() % (query.size() - 2)] = static_cast<char>('a' + rng() % 26);
+      queries.push_back( std::move(query) );
+    }
+
+    const auto allocations = bit::tools::benchmark::allocation_count();
+    const auto suggestor   = arg_suggestor<char>( words.begin(), words.end() );
+    const auto constructed = bit::tools::benchmark::allocation_count() - allocations;
+
+    context.run( name + "/suggest", queries.size(), "query", [&]{
+      for( const auto& q : queries ) {
+        bit::tools::benchmark::do_not_optimize( suggestor.suggest( q ) );
+      }
+    });
+
+    const auto indexed = context.run( name + "/suggestions", queries.size(), "query", [&]{
+      for( const auto& q : queries ) {
+        bit::tools::benchmark::do_not_optimize( suggestor.suggestions( q ) );
+      }
+    });
+
+    // The same queries scored against every entry, without bucketing
+    const auto linear = context.run( name + "/linear_scan", queries.size(), "query", [&]{
+      for( const auto& q : queries ) {
+        auto found = std::size_t{0};
+        for( const auto& w : words ) {
+          found += levenshtein_distance( q, w, arg_suggestor<char>::default_max_distance ) <=
+                   arg_suggestor<char>::default_max_distance;
+        }
+        bit::tools::benchmark::do_not_optimize( found );
+      }
+    });
+
+    if( indexed.iterations && linear.iterations ) {
+      context.report( "speedup over linear scan", linear.ns_per_op / indexed.ns_per_op, "x" );
+    }
+    if( indexed.iterations ) {
+      auto scored = std::size_t{0};
+      for( const auto& q : queries ) {
+        scored += suggestor.index().search( q, suggestor.max_distance(), []( bit::stl::string_view, std::size_t ){} );
+      }
+      const auto total = static_cast<double>(queries.size() * size);
+      context.report( "pruned before scoring", 100.0 * (1.0 - static_cast<double>(scored) / total), "%" );
+    }
+
+    auto text_size = std::size_t{0};
+    for( const auto& w : words ) {
+      text_size += w.size();
+    }
+    const auto memory  = static_cast<double>(suggestor.index().memory_usage());
+    const auto entries = static_cast<double>(size);
+
+    context.report( "memory per entry", memory / entries, "bytes" );
+    context.report( "overhead per entry", (memory - static_cast<double>(text_size)) / entries, "bytes" );
+    context.report( "construction allocations", static_cast<double>(constructed), "allocs" );
+  }
+}
+
+//----------------------------------------------------------------------------
+
+BIT_TOOLS_BENCHMARK(wide_suggestor_benchmark)
+{
+  const std::size_t sizes[] = { 1000, 100000 };
+
+  for( auto size : sizes ) {
+    const auto name = "arg_suggestor/wchar_t/entries:" + std::to_string(size);
+    if( !context.enabled( name ) ) continue;
+
+    const auto words = make_dictionary( size );
+
+    auto rng = std::mt19937{ 7 };
+    auto queries = std::vector<std::string>{};
+    for( auto i = 0; i < 64; ++i ) {
+      auto query = words[rng() % words.size()];
+      query[2 + rng() % (query.size() - 2)] = static_cast<char>('a' + rng() % 26);
+      queries.push_back( std::move(query) );
+    }
+
+    auto wide_words   = std::vector<std::wstring>{};
+    auto wide_queries = std::vector<std::wstring>{};
+    for( const auto& w : words ) wide_words.push_back( widen<wchar_t>( w, 0 ) );
+    for( const auto& q : queries ) wide_queries.push_back( widen<wchar_t>( q, 0 ) );
+
+    const auto narrow_suggestor = arg_suggestor<char>( words.begin(), words.end() );
+    const auto wide_suggestor   = arg_suggestor<wchar_t>( wide_words.begin(), wide_words.end() );
+
+    const auto narrow = context.run( name + "/char", queries.size(), "query", [&]{
+      for( const auto& q : queries ) {
+        bit::tools::benchmark::do_not_optimize( narrow_suggestor.suggest( q ) );
+      }
+    });
+    const auto wide = context.run( name + "/wchar_t", wide_queries.size(), "query", [&]{
+      for( const auto& q : wide_queries ) {
+        bit::tools::benchmark::do_not_optimize( wide_suggestor.suggest( q ) );
+      }
+    });
+
+    if( narrow.iterations && wide.iterations ) {
+      context.report( "wchar_t relative to char", narrow.ns_per_op / wide.ns_per_op, "x" );
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+
+BIT_TOOLS_BENCHMARK(metric_suggestor_benchmark)
+{
+  const std::size_t sizes[] = { 1000, 100000 };
+
+  for( auto size : sizes ) {
+    const auto name = "arg_suggestor/metric/entries:" + std::to_string(size);
+    if( !context.enabled( name ) ) continue;
+
+    const auto words = make_dictionary( size );
+
+    auto rng = std::mt19937{ 7 };
+    auto queries = std::vector<std::string>{};
+    for( auto i = 0; i < 64; ++i ) {
+      auto query = words[rng() % words.size()];
+      query[2 + rng() % (query.size() - 2)] = static_cast<char>('a' + rng() % 26);
+      queries.push_back( std::move(query) );
+    }
+
+    const auto pointer  = metric_suggestor<distance_function>( words.begin(), words.end() );
+    const auto inlined  = metric_suggestor<levenshtein_metric>( words.begin(), words.end() );
+    const auto jaro     = metric_suggestor<jaro_winkler_metric>( words.begin(), words.end(), 10 );
+    const auto weighted = metric_suggestor<prefix_weighted_metric>( words.begin(), words.end(), 5 );
+
+    const auto run = [&]( const std::string& label, const auto& suggestor ) {
+      return context.run( name + "/" + label, queries.size(), "query", [&]{
+        for( const auto& q : queries ) {
+          bit::tools::benchmark::do_not_optimize( suggestor.suggest( q ) );
+        }
+      });
+    };
+
+    const auto by_pointer = run( "distance_function", pointer );
+    const auto by_policy  = run( "levenshtein_metric", inlined );
+    run( "jaro_winkler_metric", jaro );
+    run( "prefix_weighted_metric", weighted );
+
+    if( by_pointer.iterations && by_policy.iterations ) {
+      context.report( "inlined relative to pointer", by_pointer.ns_per_op / by_policy.ns_per_op, "x" );
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+
+BIT_TOOLS_BENCHMARK(parallel_suggestor_benchmark)
+{
+  const std::size_t sizes[] = { 1000, 100000, 1000000 };
+  const std::size_t thread_counts[] = { 1, 2, 4, 8, 16, 32 };
+  constexpr auto count = std::size_t{10};
+
+  for( auto size : sizes ) {
+    const auto name = "arg_suggestor/entries:" + std::to_string(size) + "/top:10";
+    if( !context.enabled( name ) ) continue;
+
+    const auto words = make_dictionary( size );
+
+    auto rng = std::mt19937{ 7 };
+    auto queries = std::vector<std::string>{};
+    for( auto i = 0; i < 64; ++i ) {
+      auto query = words[rng() % words.size()];
+      query[2 + rng() % (query.size() - 2)] = static_cast<char>('a' + rng() % 26);
+      queries.push_back( std::move(query) );
+    }
+
+    const auto suggestor = arg_suggestor<char>( words.begin(), words.end(), 3 );
+
+    auto single = 0.0;
+    for( auto threads : thread_counts ) {
+      const auto r = context.run( name + "/threads:" + std::to_string(threads), queries.size(), "query", [&]{
+        for( const auto& q : queries ) {
+          bit::tools::benchmark::do_not_optimize( suggestor.suggestions( q, count, threads ) );
+        }
+      });
+      if( !r.iterations ) continue;
+
+      if( threads == 1 ) single = r.ns_per_op;
+      if( single > 0.0 ) {
+        context.report( "speedup over 1 thread", single / r.ns_per_op, "x" );
+      }
+    }
+    context.report( "hardware threads", static_cast<double>(std::thread::hardware_concurrency()), "threads" );
+  }
+}
+
+//----------------------------------------------------------------------------
+
+BIT_TOOLS_BENCHMARK(parallel_suggestor_verification)
+{
+  using match = std::pair<std::size_t,bit::stl::string_view>;
+
+  const auto name = std::string{"arg_suggestor/verify/top:10"};
+  if( !context.enabled( name ) ) return;
+
+  // The thread count is capped by the hardware and by min_partition_size,
+  // so the partitions are searched directly, one after another, in the
+  // way that suggestions(input, count, threads) searches them at once
+  constexpr auto count = std::size_t{10};
+  constexpr auto max   = std::size_t{3};
+  const std::size_t part_counts[] = { 1, 2, 3, 7, 16, 64 };
+
+  // Clusters of near-identical words fill each heap, and tie at its
+  // furthest distance, so the shared bound is lowered early and often
+  auto words = make_dictionary( 20000 );
+  const auto clusters = make_typos( std::vector<std::string>( words.begin(), words.begin() + 20 ), 2000, 3, 44 );
+  words.insert( words.end(), clusters.begin(), clusters.end() );
+  std::sort( words.begin(), words.end() );
+  words.erase( std::unique( words.begin(), words.end() ), words.end() );
+
+  auto queries = make_typos( words, 100, 4, 43 );
+  const auto near_clusters = make_typos( clusters, 100, 2, 45 );
+  queries.insert( queries.end(), near_clusters.begin(), near_clusters.end() );
+  queries.insert( queries.end(), { "", "-", "--", "--verbos" } );
+
+  const auto suggestor = arg_suggestor<char>( words.begin(), words.end(), max );
+  const auto& index    = suggestor.index();
+
+  auto passed = true;
+  for( const auto& query : queries ) {
+    auto expected = std::vector<match>{};
+    for( const auto& word : words ) {
+      const auto d = levenshtein_distance( query, word, max );
+      if( d <= max ) expected.emplace_back( d, word );
+    }
+    std::sort( expected.begin(), expected.end() );
+
+    auto top = std::vector<bit::stl::string_view>{};
+    for( auto i = std::size_t{0}; i < std::min( count, expected.size() ); ++i ) {
+      top.push_back( expected[i].second );
+    }
+    passed = passed && suggestor.suggestions( query, count, 8 ) == top;
+
+    for( auto parts : part_counts ) {
+      // Together, the partitions visit every argument within max exactly
+      // once, when the visitor keeps max where it is
+      auto visited = std::vector<match>{};
+      for( auto part = std::size_t{0}; part < parts; ++part ) {
+        index.search( query, max, part, parts, [&]( bit::stl::string_view arg, std::size_t d ) {
+          visited.emplace_back( d, arg );
+          return max;
+        });
+      }
+      std::sort( visited.begin(), visited.end() );
+      passed = passed && visited == expected;
+
+      // A shared bound, lowered by whichever partition fills its heap
+      // first, keeps the closest count matches, in either order of parts
+      for( auto reversed : { false, true } ) {
+        auto bound = max;
+        auto kept  = std::vector<match>{};
+
+        for( auto i = std::size_t{0}; i < parts; ++i ) {
+          const auto part = reversed ? parts - 1 - i : i;
+          auto heap = std::vector<match>{};
+
+          index.search( query, max, part, parts, [&]( bit::stl::string_view arg, std::size_t d ) {
+            heap.emplace_back( d, arg );
+            std::push_heap( heap.begin(), heap.end() );
+            if( heap.size() > count ) {
+              std::pop_heap( heap.begin(), heap.end() );
+              heap.pop_back();
+            }
+            if( heap.size() == count ) bound = std::min( bound, heap.front().first );
+            return bound;
+          });
+          kept.insert( kept.end(), heap.begin(), heap.end() );
+        }
+        std::sort( kept.begin(), kept.end() );
+        if( kept.size() > count ) kept.resize( count );
+
+        auto result = std::vector<bit::stl::string_view>{};
+        for( const auto& m : kept ) {
+          result.push_back( m.second );
+        }
+        passed = passed && result == top;
+      }
+    }
+  }
+  context.verify( name, passed );
+}
+
+//----------------------------------------------------------------------------
+
+BIT_TOOLS_BENCHMARK(shared_suggestor_benchmark)
+{
+  const std::size_t thread_counts[] = { 1, 2, 4, 8, 16 };
+
+  auto words = std::vector<std::string>{};
+  auto queries = std::vector<std::string>{};
+  auto single = 0.0;
+
+  for( auto threads : thread_counts ) {
+    const auto name = "arg_suggestor/shared/threads:" + std::to_string(threads);
+    if( !context.enabled( name ) ) continue;
+
+    if( words.empty() ) {
+      words = make_dictionary( 100000 );
+
+      auto rng = std::mt19937{ 7 };
+      for( auto i = 0; i < 64; ++i ) {
+        auto query = words[rng() % words.size()];
+        query[2 + rng() % (query.size() - 2)] = static_cast<char>('a' + rng() % 26);
+        queries.push_back( std::move(query) );
+      }
+    }
+    const auto suggestor = arg_suggestor<char>( words.begin(), words.end() );
+
+    // The workers outlive the measurement, so that starting them is not
+    // counted; each iteration releases them all to run every query once
+    std::atomic<std::size_t> round( 0 );
+    std::atomic<std::size_t> finished( 0 );
+    std::atomic<bool>        stop( false );
+
+    const auto work = [&]{
+      auto result = std::vector<bit::stl::string_view>{};
+      auto seen   = std::size_t{0};
+      while( true ) {
+        while( round.load() == seen && !stop.load() ) std::this_thread::yield();
+        if( stop.load() ) return;
+        ++seen;
+
+        for( const auto& q : queries ) {
+          suggestor.suggestions( &result, q );
+          bit::tools::benchmark::do_not_optimize( result.data() );
+        }
+        finished.fetch_add( 1 );
+      }
+    };
+
+    auto workers = std::vector<std::thread>{};
+    for( auto t = std::size_t{0}; t < threads; ++t ) {
+      workers.emplace_back( work );
+    }
+
+    const auto r = context.run( name, queries.size() * threads, "query", [&]{
+      finished.store( 0 );
+      round.fetch_add( 1 );
+      while( finished.load() != threads ) std::this_thread::yield();
+    });
+
+    stop.store( true );
+    for( auto& worker : workers ) worker.join();
+
+    if( !r.iterations ) continue;
+    if( threads == 1 ) single = r.ns_per_item;
+
+    context.report( "throughput", 1e9 / r.ns_per_item, "queries/s" );
+    if( single > 0.0 ) {
+      context.report( "scaling over 1 thread", single / r.ns_per_item, "x" );
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+
+BIT_TOOLS_BENCHMARK(suggestion_cache_benchmark)
+{
+  using cache_type = suggestion_cache<arg_suggestor<char>>;
+
+  const std::size_t capacities[] = { 64, 256, 1024 };
+
+  auto words = std::vector<std::string>{};
+  auto queries = std::vector<std::string>{};
+
+  for( auto capacity : capacities ) {
+    const auto name = "suggestion_cache/entries:100000/capacity:" + std::to_string(capacity);
+    if( !context.enabled( name ) ) continue;
+
+    // A stream of 4096 queries drawn from 512 distinct typos, in which a
+    // few typos recur far more often than the rest, as in shell history
+    if( words.empty() ) {
+      words = make_dictionary( 100000 );
+
+      auto rng = std::mt19937{ 11 };
+      auto typos = std::vector<std::string>{};
+      for( auto i = 0; i < 512; ++i ) {
+        auto typo = words[rng() % words.size()];
+        typo[2 + rng() % (typo.size() - 2)] = static_cast<char>('a' + rng() % 26);
+        typos.push_back( std::move(typo) );
+      }
+      auto weights = std::vector<double>{};
+      for( auto i = 0; i < 512; ++i ) {
+        weights.push_back( 1.0 / static_cast<double>(i + 1) );
+      }
+      auto pick = std::discrete_distribution<std::size_t>( weights.begin(), weights.end() );
+      for( auto i = 0; i < 4096; ++i ) {
+        queries.push_back( typos[pick( rng )] );
+      }
+    }
+    const auto suggestor = arg_suggestor<char>( words.begin(), words.end() );
+
+    auto result = std::vector<bit::stl::string_view>{};
+    cache_type cache( suggestor, capacity );
+
+    const auto cached = context.run( name + "/suggestions", queries.size(), "query", [&]{
+      for( const auto& q : queries ) {
+        cache.suggestions( &result, q );
+        bit::tools::benchmark::do_not_optimize( result.data() );
+      }
+    });
+    const auto uncached = context.run( name + "/uncached", queries.size(), "query", [&]{
+      for( const auto& q : queries ) {
+        suggestor.suggestions( &result, q );
+        bit::tools::benchmark::do_not_optimize( result.data() );
+      }
+    });
+    if( !cached.iterations ) continue;
+
+    const auto stats = cache.statistics();
+    const auto hits   = static_cast<double>(stats.hits ? stats.hits : 1);
+    const auto misses = static_cast<double>(stats.misses ? stats.misses : 1);
+
+    context.report( "hit ratio", 100.0 * stats.hit_ratio(), "%" );
+    context.report( "mean hit latency", static_cast<double>(stats.hit_time.count()) / hits, "ns" );
+    context.report( "mean miss latency", static_cast<double>(stats.miss_time.count()) / misses, "ns" );
+    if( uncached.iterations ) {
+      context.report( "speedup over uncached", uncached.ns_per_op / cached.ns_per_op, "x" );
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+
+BIT_TOOLS_BENCHMARK(bk_tree_benchmark)
+{
+  using bk_suggestor = arg_suggestor<char,std::char_traits<char>,bk_tree_index>;
+
+  const std::size_t sizes[] = { 1000, 10000, 100000, 500000 };
+  const std::size_t distances[] = { 1, 2 };
+
+  for( auto size : sizes ) {
+    const auto name = "bk_tree_index/entries:" + std::to_string(size);
+    if( !context.enabled( name ) ) continue;
+
+    const auto words = make_dictionary( size );
+
+    auto rng = std::mt19937{ 7 };
+    auto queries = std::vector<std::string>{};
+    for( auto i = 0; i < 64; ++i ) {
+      auto query = words[rng() % words.size()];
+      query[2 + rng() % (query.size() - 2)] = static_cast<char>('a' + rng() % 26);
+      queries.push_back( std::move(query) );
+    }
+
+    for( auto max : distances ) {
+      const auto suggestor = bk_suggestor( words.begin(), words.end(), max );
+      const auto case_name = name + "/max:" + std::to_string(max);
+
+      const auto r = context.run( case_name + "/suggestions", queries.size(), "query", [&]{
+        for( const auto& q : queries ) {
+          bit::tools::benchmark::do_not_optimize( suggestor.suggestions( q ) );
+        }
+      });
+      if( !r.iterations ) continue;
+
+      auto visited = std::size_t{0};
+      for( const auto& q : queries ) {
+        visited += suggestor.index().search( q, max, []( bit::stl::string_view, std::size_t ){} );
+      }
+      const auto per_query = static_cast<double>(visited) / static_cast<double>(queries.size());
+
+      context.report( "nodes visited", per_query, "nodes/query" );
+      context.report( "fraction visited", 100.0 * per_query / static_cast<double>(size), "%" );
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+
+BIT_TOOLS_BENCHMARK(bk_tree_verification)
+{
+  const auto name = std::string{"bk_tree_index/verify"};
+  if( !context.enabled( name ) ) return;
+
+  // Repeated words land at key 0 below their first copy, and a few very
+  // short words sit at large keys from the root. Bounds up to 4 reach far
+  // into the tree
+  auto words = make_dictionary( 5000 );
+  words.insert( words.end(), words.begin(), words.begin() + 100 );
+  words.insert( words.end(), { "-", "--x", "-v", "--verbose" } );
+
+  auto queries = make_typos( words, 300, 4, 37 );
+  queries.insert( queries.end(), { "", "-", "--", "--verbos", "--no-color-quietxx" } );
+
+  const auto index = bk_tree_index( words.begin(), words.end(), &levenshtein_distance );
+
+  auto passed = index.size() == words.size();
+  for( auto max : { std::size_t{0}, std::size_t{1}, std::size_t{2}, std::size_t{4} } ) {
+    passed = passed && matches_scan( index, words, queries, max, &levenshtein_distance );
+  }
+  context.verify( name, passed );
+}
+
+//----------------------------------------------------------------------------
+
+BIT_TOOLS_BENCHMARK(symspell_benchmark)
+{
+  using symspell_suggestor = arg_suggestor<char,std::char_traits<char>,symspell_index>;
+
+  const std::size_t sizes[] = { 10000, 100000, 500000 };
+  const std::size_t distances[] = { 1, 2 };
+
+  for( auto size : sizes ) {
+    const auto name = "symspell_index/entries:" + std::to_string(size);
+    if( !context.enabled( name ) ) continue;
+
+    const auto words = make_dictionary( size );
+
+    auto rng = std::mt19937{ 7 };
+    auto queries = std::vector<std::string>{};
+    for( auto i = 0; i < 64; ++i ) {
+      auto query = words[rng() % words.size()];
+      query[2 + rng() % (query.size() - 2)] = static_cast<char>('a' + rng() % 26);
+      queries.push_back( std::move(query) );
+    }
+
+    auto text_size = std::size_t{0};
+    for( const auto& w : words ) {
+      text_size += w.size();
+    }
+
+    for( auto max : distances ) {
+      const auto suggestor = symspell_suggestor( words.begin(), words.end(), max );
+      const auto case_name = name + "/max:" + std::to_string(max);
+
+      const auto r = context.run( case_name + "/suggestions", queries.size(), "query", [&]{
+        for( const auto& q : queries ) {
+          bit::tools::benchmark::do_not_optimize( suggestor.suggestions( q ) );
+        }
+      });
+      if( !r.iterations ) continue;
+
+      auto scored = std::size_t{0};
+      for( const auto& q : queries ) {
+        scored += suggestor.index().search( q, max, []( bit::stl::string_view, std::size_t ){} );
+      }
+      const auto memory = suggestor.index().memory_usage();
+
+      context.report( "throughput", 1e9 / r.ns_per_item, "queries/s" );
+      context.report( "candidates verified", static_cast<double>(scored) / static_cast<double>(queries.size()), "args/query" );
+      context.report( "memory", static_cast<double>(memory) / (1024.0 * 1024.0), "MiB" );
+      context.report( "memory per entry", static_cast<double>(memory) / static_cast<double>(size), "bytes" );
+      context.report( "text per entry", static_cast<double>(text_size) / static_cast<double>(size), "bytes" );
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+
+BIT_TOOLS_BENCHMARK(symspell_verification)
+{
+  using distance_fn_type = std::size_t(*)(bit::stl::string_view,bit::stl::string_view,std::size_t);
+
+  // Words are 8 to 25 characters long, so typos land both inside and
+  // between the two windows that deletions are taken from. A bound above
+  // max_edits scores every argument
+  const std::pair<const char*,distance_fn_type> metrics[] = {
+    { "levenshtein_distance", &levenshtein_distance },
+    { "damerau_levenshtein_distance", &damerau_levenshtein_distance }
+  };
+  const std::size_t distances[] = { 0, 1, 2, 3 };
+  const auto path = std::string{"symspell_verification.benchmark.index"};
+
+  const auto words = make_dictionary( 5000 );
+
+  auto queries = make_typos( words, 300, 3, 38 );
+  queries.insert( queries.end(), { "", "-", "--", "--re", "--no-color-quietxx" } );
+
+  for( const auto& metric : metrics ) {
+    const auto name      = std::string{"symspell_index/verify/"} + metric.first;
+    const auto file_name = std::string{"mapped_symspell_index/verify/"} + metric.first;
+    if( !context.enabled( name ) && !context.enabled( file_name ) ) continue;
+
+    const auto index = symspell_index( words.begin(), words.end(), metric.second );
+
+    if( context.enabled( name ) ) {
+      auto passed = index.size() == words.size();
+      for( auto max : distances ) {
+        passed = passed && matches_scan( index, words, queries, max, metric.second );
+      }
+      context.verify( name, passed );
+    }
+    if( !context.enabled( file_name ) ) continue;
+
+    // The same searches, of the tables as they are read back from a file
+    {
+      std::ofstream out( path, std::ios::binary );
+      index.save( out );
+    }
+    const auto mapped = mapped_symspell_index( path, metric.second );
+
+    auto mapped_passed = mapped.verify() && mapped.size() == index.size();
+    for( auto max : distances ) {
+      mapped_passed = mapped_passed && matches_scan( mapped, words, queries, max, metric.second );
+    }
+    context.verify( file_name, mapped_passed );
+  }
+  std::remove( path.c_str() );
+}
+
+//----------------------------------------------------------------------------
+
+BIT_TOOLS_BENCHMARK(symspell_file_benchmark)
+{
+  using symspell_suggestor = arg_suggestor<char,std::char_traits<char>,symspell_index>;
+  using mapped_suggestor   = arg_suggestor<char,std::char_traits<char>,mapped_symspell_index>;
+
+  const std::size_t sizes[] = { 10000, 100000, 500000 };
+  const auto path = std::string{"symspell_file.benchmark.index"};
+
+  for( auto size : sizes ) {
+    const auto name = "symspell_file/entries:" + std::to_string(size);
+    if( !context.enabled( name ) ) continue;
+
+    const auto words = make_dictionary( size );
+
+    auto query = words[size / 2];
+    query[2] = (query[2] == 'z') ? 'y' : 'z';
+
+    {
+      const auto suggestor = symspell_suggestor( words.begin(), words.end() );
+      std::ofstream out( path, std::ios::binary );
+      suggestor.index().save( out );
+    }
+
+    // Each case is the start of a process: make the index, then suggest
+    const auto rebuild = context.run( name + "/rebuild", 1, "start", [&]{
+      const auto suggestor = symspell_suggestor( words.begin(), words.end() );
+      bit::tools::benchmark::do_not_optimize( suggestor.suggest( query ) );
+    });
+
+    const auto open = context.run( name + "/open", 1, "start", [&]{
+      const auto suggestor = mapped_suggestor( mapped_symspell_index( path, &levenshtein_distance ) );
+      bit::tools::benchmark::do_not_optimize( suggestor.suggest( query ) );
+    });
+    if( rebuild.iterations && open.iterations ) {
+      context.report( "speedup vs rebuild", rebuild.ns_per_op / open.ns_per_op, "x" );
+    }
+
+    const auto verified = context.run( name + "/open+verify", 1, "start", [&]{
+      auto index = mapped_symspell_index( path, &levenshtein_distance );
+      bit::tools::benchmark::do_not_optimize( index.verify() );
+
+      const auto suggestor = mapped_suggestor( std::move(index) );
+      bit::tools::benchmark::do_not_optimize( suggestor.suggest( query ) );
+    });
+    if( verified.iterations ) {
+      const auto file = mapped_symspell_index( path, &levenshtein_distance );
+      context.report( "file size", static_cast<double>(file.file_size()) / (1024.0 * 1024.0), "MiB" );
+    }
+  }
+  std::remove( path.c_str() );
+}
+
+//----------------------------------------------------------------------------
+
+BIT_TOOLS_BENCHMARK(trie_automaton_benchmark)
+{
+  using trie_suggestor = arg_suggestor<char,std::char_traits<char>,trie_index>;
+
+  const std::size_t sizes[] = { 1000, 10000, 100000, 500000 };
+  const std::size_t distances[] = { 1, 2 };
+
+  for( auto size : sizes ) {
+    const auto name = "trie_index/entries:" + std::to_string(size);
+    if( !context.enabled( name ) ) continue;
+
+    const auto words = make_dictionary( size );
+
+    auto rng = std::mt19937{ 11 };
+    auto queries = std::vector<std::string>{};
+    auto keystrokes = std::size_t{0};
+    for( auto i = 0; i < 16; ++i ) {
+      auto query = words[rng() % words.size()];
+      query[2 + rng() % (query.size() - 2)] = static_cast<char>('a' + rng() % 26);
+      keystrokes += query.size();
+      queries.push_back( std::move(query) );
+    }
+
+    for( auto max : distances ) {
+      const auto suggestor = trie_suggestor( words.begin(), words.end(), max );
+      const auto case_name = name + "/max:" + std::to_string(max);
+
+      // Each query is typed one character at a time, with the suggestions
+      // read after every keystroke
+      auto active = std::size_t{0};
+      const auto incremental = context.run( case_name + "/incremental", keystrokes, "keystroke", [&]{
+        active = 0;
+        for( const auto& q : queries ) {
+          auto state = suggestor.automaton();
+          for( auto c : q ) {
+            state.push_back( c );
+            active += state.active_count();
+            bit::tools::benchmark::do_not_optimize( suggestor.suggestions( state ) );
+          }
+        }
+      });
+      if( incremental.iterations ) {
+        context.report( "active nodes", static_cast<double>(active) / static_cast<double>(keystrokes), "nodes/keystroke" );
+      }
+
+      const auto scratch = context.run( case_name + "/from_scratch", keystrokes, "keystroke", [&]{
+        for( const auto& q : queries ) {
+          for( auto i = std::size_t{1}; i <= q.size(); ++i ) {
+            bit::tools::benchmark::do_not_optimize( suggestor.suggestions( bit::stl::string_view{q}.substr( 0, i ) ) );
+          }
+        }
+      });
+      if( incremental.iterations && scratch.iterations ) {
+        context.report( "speedup", scratch.ns_per_op / incremental.ns_per_op, "x" );
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+
+BIT_TOOLS_BENCHMARK(trie_verification)
+{
+  using match = std::pair<bit::stl::string_view,std::size_t>;
+
+  const auto name = std::string{"trie_index/verify"};
+  if( !context.enabled( name ) ) return;
+
+  auto words = make_dictionary( 5000 );
+  words.insert( words.end(), { "-", "--x", "-v", "--verbose", "--verbose-all" } );
+
+  auto queries = make_typos( words, 200, 3, 40 );
+  queries.insert( queries.end(), { "", "-", "--", "--verbos", "--no-color-quietxx" } );
+
+  const auto index = trie_index( words.begin(), words.end(), &levenshtein_distance );
+
+  auto passed = index.size() == words.size();
+  for( auto max : { std::size_t{0}, std::size_t{1}, std::size_t{2}, std::size_t{3} } ) {
+    passed = passed && matches_scan( index, words, queries, max, &levenshtein_distance );
+  }
+
+  // The automaton is typed into one character at a time, with backspaces
+  // and retyped characters along the way, and must match a scan of its
+  // query after every keystroke
+  const auto matches_query = [&]( const levenshtein_automaton& state,
+                                  const std::string& query ) {
+    auto expected = std::vector<match>{};
+    for( const auto& word : words ) {
+      const auto d = levenshtein_distance( query, word, state.max_distance() );
+      if( d <= state.max_distance() ) expected.emplace_back( word, d );
+    }
+    auto actual = std::vector<match>{};
+    state.search( [&]( bit::stl::string_view arg, std::size_t d ) {
+      actual.emplace_back( arg, d );
+    });
+    std::sort( expected.begin(), expected.end() );
+    std::sort( actual.begin(), actual.end() );
+    expected.erase( std::unique( expected.begin(), expected.end() ), expected.end() );
+    actual.erase( std::unique( actual.begin(), actual.end() ), actual.end() );
+
+    return state.query() == bit::stl::string_view{ query } && actual == expected;
+  };
+
+  auto rng = std::mt19937{ 41 };
+  for( auto max : { std::size_t{1}, std::size_t{2} } ) {
+    auto state = index.automaton( max );
+    passed = passed && matches_query( state, "" );
+
+    for( auto q = std::size_t{0}; q < 40; ++q ) {
+      const auto& target = queries[q];
+      auto typed = std::string{};
+
+      for( auto i = std::size_t{0}; i < target.size(); ) {
+        // A typo, sometimes, that is then deleted again
+        if( rng() % 4 == 0 ) {
+          const auto typo = static_cast<char>('a' + rng() % 26);
+          state.push_back( typo );
+          typed.push_back( typo );
+          passed = passed && matches_query( state, typed );
+
+          state.pop_back();
+          typed.pop_back();
+          passed = passed && matches_query( state, typed );
+        }
+        state.push_back( target[i] );
+        typed.push_back( target[i++] );
+        passed = passed && matches_query( state, typed );
+      }
+
+      // Backspace over half the query, then reset for the next one
+      for( auto i = typed.size() / 2; i > 0; --i ) {
+        state.pop_back();
+        typed.pop_back();
+        passed = passed && matches_query( state, typed );
+      }
+      state.clear();
+      passed = passed && matches_query( state, "" );
+    }
+  }
+  context.verify( name, passed );
+}
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+  /// \brief Generates \p count configuration keys and paths of 40 to 200
+  ///        characters, built from a small vocabulary of segments
+  std::vector<std::string> make_long_keys( std::size_t count )
+  {
+    static const char* const segments[] = {
+      "config", "server", "client", "cache", "timeout", "retry", "policy",
+      "logging", "level", "output", "format", "path", "storage", "backend",
+      "network", "proxy", "auth", "token", "limit", "queue", "worker",
+      "thread", "pool", "metrics", "export", "interval", "buffer", "size"
+    };
+    constexpr auto segment_count = sizeof(segments) / sizeof(segments[0]);
+    static const char separators[] = { '.', '/', '_' };
+
+    auto rng  = std::mt19937{ 99 };
+    auto keys = std::vector<std::string>{};
+    keys.reserve( count );
+
+    for( auto i = std::size_t{0}; i < count; ++i ) {
+      const auto length = 40 + rng() % 161;
+
+      auto key = std::string{};
+      while( key.size() < length ) {
+        if( !key.empty() ) key += separators[rng() % 3];
+        key += segments[rng() % segment_count];
+      }
+      // Generated keys often end in an identifier
+      for( auto c = 0; c < 4; ++c ) {
+        key += static_cast<char>('a' + rng() % 26);
+      }
+      keys.push_back( std::move(key) );
+    }
+    return keys;
+  }
+
+} // anonymous namespace
+
+BIT_TOOLS_BENCHMARK(trigram_benchmark)
+{
+  using trigram_suggestor = arg_suggestor<char,std::char_traits<char>,trigram_index>;
+
+  const std::size_t sizes[] = { 10000, 100000, 1000000 };
+  const std::size_t distances[] = { 2, 4 };
+
+  for( auto size : sizes ) {
+    const auto name = "trigram_index/entries:" + std::to_string(size);
+    if( !context.enabled( name ) ) continue;
+
+    const auto keys = make_long_keys( size );
+
+    // Queries are known keys with two typos
+    auto rng = std::mt19937{ 5 };
+    auto queries = std::vector<std::string>{};
+    for( auto i = 0; i < 32; ++i ) {
+      auto query = keys[rng() % keys.size()];
+      for( auto e = 0; e < 2; ++e ) {
+        query[rng() % query.size()] = static_cast<char>('a' + rng() % 26);
+      }
+      queries.push_back( std::move(query) );
+    }
+
+    for( auto max : distances ) {
+      const auto suggestor = trigram_suggestor( keys.begin(), keys.end(), max );
+      const auto case_name = name + "/max:" + std::to_string(max);
+
+      const auto r = context.run( case_name + "/suggestions", queries.size(), "query", [&]{
+        for( const auto& q : queries ) {
+          bit::tools::benchmark::do_not_optimize( suggestor.suggestions( q ) );
+        }
+      });
+      if( !r.iterations ) continue;
+
+      auto scored = std::size_t{0};
+      for( const auto& q : queries ) {
+        scored += suggestor.index().search( q, max, []( bit::stl::string_view, std::size_t ){} );
+      }
+      const auto memory = suggestor.index().memory_usage();
+
+      context.report( "throughput", 1e9 / r.ns_per_item, "queries/s" );
+      context.report( "candidates verified", static_cast<double>(scored) / static_cast<double>(queries.size()), "args/query" );
+      context.report( "memory", static_cast<double>(memory) / (1024.0 * 1024.0), "MiB" );
+
+      // The default index, on the same keys and queries
+      const auto baseline = arg_suggestor<char>( keys.begin(), keys.end(), max );
+      const auto b = context.run( case_name + "/letter_set_index", queries.size(), "query", [&]{
+        for( const auto& q : queries ) {
+          bit::tools::benchmark::do_not_optimize( baseline.suggestions( q ) );
+        }
+      });
+      if( b.iterations ) {
+        context.report( "speedup of trigram_index", b.ns_per_op / r.ns_per_op, "x" );
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+
+BIT_TOOLS_BENCHMARK(trigram_verification)
+{
+  using distance_fn_type = std::size_t(*)(bit::stl::string_view,bit::stl::string_view,std::size_t);
+
+  const std::pair<const char*,distance_fn_type> metrics[] = {
+    { "levenshtein_distance", &levenshtein_distance },
+    { "damerau_levenshtein_distance", &damerau_levenshtein_distance }
+  };
+  const std::size_t distances[] = { 0, 1, 2, 4, 8 };
+
+  // Keys of 40 to 200 characters, and a few short ones that only queries
+  // too short to filter can reach
+  auto keys = make_long_keys( 3000 );
+  keys.insert( keys.end(), { "path", "cache", "pool.size", "auth/token", "aaaaaaaaaaaa" } );
+
+  auto queries = make_typos( keys, 200, 10, 42 );
+
+  // Queries with no more distinct trigrams than a bound of 4 can spend:
+  // short ones, prefixes of keys, and long runs of a repeated character
+  queries.insert( queries.end(), { "", "p", "pa", "pth", "cahce", "pool.sise", "auth/tokn",
+                                   "aaaaaaaaaaaaa", std::string( 60, 'a' ) } );
+  for( auto n : { 3, 10, 18 } ) {
+    queries.push_back( keys[n].substr( 0, n ) );
+  }
+
+  for( const auto& metric : metrics ) {
+    const auto name = std::string{"trigram_index/verify/"} + metric.first;
+    if( !context.enabled( name ) ) continue;
+
+    const auto index = trigram_index( keys.begin(), keys.end(), metric.second );
+
+    auto passed = index.size() == keys.size();
+    for( auto max : distances ) {
+      passed = passed && matches_scan( index, keys, queries, max, metric.second );
+    }
+    context.verify( name, passed );
+  }
+}
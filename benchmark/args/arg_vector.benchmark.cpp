@@ -0,0 +1,74 @@
+#include "../benchmark.hpp"
+
+#include <bit/tools/args/arg_vector.hpp>
+
+#include <string> // std::string, std::to_string
+#include <vector> // std::vector
+
+namespace {
+
+  using namespace bit::tools;
+
+  //////////////////////////////////////////////////////////////////////////
+  /// \brief A generated argv of \c argc arguments
+  //////////////////////////////////////////////////////////////////////////
+  struct vector_fixture
+  {
+    std::vector<std::string> tokens;
+    std::vector<const char*> argv;
+
+    explicit vector_fixture( std::size_t argc )
+    {
+      for( auto i = std::size_t{0}; i < argc; ++i ) {
+        tokens.push_back( (i % 2) ? "--flag-" + std::to_string(i) : "value" );
+      }
+      for( const auto& token : tokens ) {
+        argv.push_back( token.c_str() );
+      }
+    }
+
+    arg_vector args() const noexcept
+    {
+      return arg_vector( static_cast<int>(argv.size()), argv.data() );
+    }
+  };
+
+} // anonymous namespace
+
+//----------------------------------------------------------------------------
+
+BIT_TOOLS_BENCHMARK(arg_vector_benchmark)
+{
+  const std::size_t argcs[] = { 8, 64, 512, 4096 };
+
+  for( auto argc : argcs ) {
+    const auto fixture = vector_fixture( argc );
+    const auto args    = fixture.args();
+
+    context.run( "arg_vector/iterate/argc:" + std::to_string(argc), argc, "arg", [&]{
+      auto total = std::size_t{0};
+      for( auto arg : args ) {
+        total += arg.size();
+      }
+      bit::tools::benchmark::do_not_optimize( total );
+    });
+
+    context.run( "arg_vector/index/argc:" + std::to_string(argc), argc, "arg", [&]{
+      auto total = std::size_t{0};
+      for( auto i = std::ptrdiff_t{0}; i < static_cast<std::ptrdiff_t>(args.size()); ++i ) {
+        total += args[i].size();
+      }
+      bit::tools::benchmark::do_not_optimize( total );
+    });
+
+    // Successively peel off the leading argument, as subcommand dispatch
+    // and multi_arg parsing do
+    context.run( "arg_vector/subvec/argc:" + std::to_string(argc), argc, "arg", [&]{
+      auto current = args;
+      while( !current.empty() ) {
+        current = current.subvec(1);
+        bit::tools::benchmark::do_not_optimize( current );
+      }
+    });
+  }
+}
@@ -0,0 +1,148 @@
+#include "benchmark.hpp"
+
+#include <atomic>  // std::atomic
+#include <cstdio>  // std::printf
+#include <cstdlib> // std::malloc, std::free
+#include <new>     // std::bad_alloc
+#include <vector>  // std::vector
+
+namespace {
+
+  std::atomic<std::size_t> g_allocations{0};
+
+  std::vector<bit::tools::benchmark::benchmark_fn>& registry()
+  {
+    static std::vector<bit::tools::benchmark::benchmark_fn> benchmarks;
+
+    return benchmarks;
+  }
+
+} // anonymous namespace
+
+//----------------------------------------------------------------------------
+// Allocation Tracking
+//----------------------------------------------------------------------------
+
+void* operator new( std::size_t size )
+{
+  g_allocations.fetch_add( 1, std::memory_order_relaxed );
+
+  if( auto p = std::malloc( size ? size : 1 ) ) return p;
+  throw std::bad_alloc{};
+}
+
+void* operator new[]( std::size_t size )
+{
+  return ::operator new( size );
+}
+
+void operator delete( void* p ) noexcept
+{
+  std::free( p );
+}
+
+void operator delete[]( void* p ) noexcept
+{
+  std::free( p );
+}
+
+void operator delete( void* p, std::size_t ) noexcept
+{
+  std::free( p );
+}
+
+void operator delete[]( void* p, std::size_t ) noexcept
+{
+  std::free( p );
+}
+
+std::size_t bit::tools::benchmark::allocation_count()
+  noexcept
+{
+  return g_allocations.load( std::memory_order_relaxed );
+}
+
+//----------------------------------------------------------------------------
+// context
+//----------------------------------------------------------------------------
+
+bit::tools::benchmark::context::context( std::string filter )
+  : m_filter(std::move(filter)),
+    m_failures(0)
+{
+
+}
+
+//----------------------------------------------------------------------------
+
+void bit::tools::benchmark::context::report( const std::string& name,
+                                             double value,
+                                             const char* unit )
+{
+  std::printf( "  %-58s %14.2f %s\n", name.c_str(), value, unit );
+}
+
+bool bit::tools::benchmark::context::enabled( const std::string& name )
+  const
+{
+  return m_filter.empty() || name.find(m_filter) != std::string::npos;
+}
+
+//----------------------------------------------------------------------------
+
+void bit::tools::benchmark::context::verify( const std::string& name,
+                                             bool passed )
+{
+  if( !enabled(name) ) return;
+
+  std::printf( "%-60s %12s\n", name.c_str(), passed ? "passed" : "FAILED" );
+  if( !passed ) ++m_failures;
+}
+
+std::size_t bit::tools::benchmark::context::failures()
+  const noexcept
+{
+  return m_failures;
+}
+
+//----------------------------------------------------------------------------
+
+void bit::tools::benchmark::context::print( const std::string& name,
+                                            const char* item_name,
+                                            const result& r )
+{
+  std::printf( "%-60s %12.1f ns/op %10.2f ns/%-10s %8.2f allocs/op\n",
+               name.c_str(),
+               r.ns_per_op,
+               r.ns_per_item,
+               item_name,
+               r.allocs_per_op );
+}
+
+//----------------------------------------------------------------------------
+// Registration
+//----------------------------------------------------------------------------
+
+bool bit::tools::benchmark::register_benchmark( benchmark_fn fn )
+{
+  registry().push_back( fn );
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Driver
+//----------------------------------------------------------------------------
+
+int main( int argc, char** argv )
+{
+  // An optional first argument filters which cases are run
+  auto ctx = bit::tools::benchmark::context( argc > 1 ? argv[1] : "" );
+
+  for( auto fn : registry() ) {
+    fn( ctx );
+  }
+
+  // A benchmark of a wrong result is meaningless, so failed checks fail
+  // the run
+  return (ctx.failures() == 0) ? 0 : 1;
+}
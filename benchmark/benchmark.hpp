@@ -0,0 +1,194 @@
+/**
+ * \file benchmark.hpp
+ *
+ * \brief A minimal benchmarking harness for the bit::tools benchmarks
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ */
+
+#ifndef BIT_TOOLS_BENCHMARK_HPP
+#define BIT_TOOLS_BENCHMARK_HPP
+
+#include <chrono>  // std::chrono::steady_clock
+#include <cstddef> // std::size_t
+#include <string>  // std::string
+
+namespace bit {
+  namespace tools {
+    namespace benchmark {
+
+      //////////////////////////////////////////////////////////////////////////
+      /// \brief The results of a single measured benchmark case
+      //////////////////////////////////////////////////////////////////////////
+      struct result
+      {
+        std::size_t iterations;    ///< Number of iterations that were timed
+        double      ns_per_op;     ///< Nanoseconds per iteration
+        double      ns_per_item;   ///< Nanoseconds per processed item
+        double      allocs_per_op; ///< Heap allocations per iteration
+      };
+
+      //////////////////////////////////////////////////////////////////////////
+      /// \brief The context passed to each registered benchmark
+      ///
+      /// A benchmark calls \ref run once for every parameter set it wants
+      /// to measure.
+      //////////////////////////////////////////////////////////////////////////
+      class context
+      {
+      public:
+
+        /// \brief Constructs a context that only runs cases whose name
+        ///        contains \p filter
+        ///
+        /// \param filter the filter for benchmark case names
+        explicit context( std::string filter );
+
+        /// \brief Measures \p fn, reporting it under \p name
+        ///
+        /// The number of iterations is calibrated so that each case runs for
+        /// a fixed minimum time
+        ///
+        /// \param name the name of the case
+        /// \param items the number of items processed per call to \p fn
+        /// \param item_name the name of each item (e.g. "arg")
+        /// \param fn the function to benchmark
+        /// \return the measured result
+        template<typename Fn>
+        result run( const std::string& name,
+                    std::size_t items,
+                    const char* item_name,
+                    Fn&& fn );
+
+        /// \brief Reports an additional metric for the previous case
+        ///
+        /// \param name the name of the metric
+        /// \param value the value of the metric
+        /// \param unit the unit of the metric
+        void report( const std::string& name, double value, const char* unit );
+
+        /// \brief Records and reports the outcome of a correctness check
+        ///        called \p name
+        ///
+        /// A check is only recorded if its name matches the filter, so the
+        /// checks can be run on their own
+        ///
+        /// \param name the name of the check
+        /// \param passed whether the check passed
+        void verify( const std::string& name, bool passed );
+
+        /// \brief Returns whether a case called \p name should be run
+        ///
+        /// \param name the name of the case
+        /// \return \c true if the case matches the filter
+        bool enabled( const std::string& name ) const;
+
+        /// \brief Returns the number of checks that have failed
+        ///
+        /// \return the number of failed checks
+        std::size_t failures() const noexcept;
+
+      private:
+
+        std::string m_filter;
+        std::size_t m_failures;
+
+        void print( const std::string& name,
+                    const char* item_name,
+                    const result& r );
+      };
+
+      /// \brief The type of registered benchmark functions
+      using benchmark_fn = void(*)( context& );
+
+      /// \brief Registers \p fn to be run by the benchmark driver
+      ///
+      /// \param fn the function to register
+      /// \return \c true
+      bool register_benchmark( benchmark_fn fn );
+
+      /// \brief Returns the number of heap allocations performed so far
+      ///
+      /// \return the allocation count
+      std::size_t allocation_count() noexcept;
+
+      /// \brief Prevents the compiler from optimizing away \p value
+      ///
+      /// \param value the value to keep alive
+      template<typename T>
+      void do_not_optimize( const T& value );
+
+    } // namespace benchmark
+  } // namespace tools
+} // namespace bit
+
+/// Registers the function \p fn as a benchmark. The body of the function
+/// receives the benchmark::context as \c context
+#define BIT_TOOLS_BENCHMARK(fn)                                        \
+  static void fn( ::bit::tools::benchmark::context& );                 \
+  static const bool fn##_registered =                                  \
+    ::bit::tools::benchmark::register_benchmark( &fn );                \
+  static void fn( ::bit::tools::benchmark::context& context )
+
+//----------------------------------------------------------------------------
+// Inline Definitions
+//----------------------------------------------------------------------------
+
+template<typename Fn>
+inline bit::tools::benchmark::result
+  bit::tools::benchmark::context::run( const std::string& name,
+                                       std::size_t items,
+                                       const char* item_name,
+                                       Fn&& fn )
+{
+  using clock = std::chrono::steady_clock;
+
+  auto r = result{ 0, 0, 0, 0 };
+
+  if( !enabled(name) ) return r;
+
+  const auto target = std::chrono::milliseconds(200);
+
+  // Warm up, and give an estimate of a single iteration
+  fn();
+
+  auto iterations = std::size_t{1};
+  while( true ) {
+    const auto allocs = allocation_count();
+    const auto start  = clock::now();
+    for( auto i = std::size_t{0}; i < iterations; ++i ) {
+      fn();
+    }
+    const auto elapsed = clock::now() - start;
+    const auto count   = allocation_count() - allocs;
+
+    if( elapsed >= target || iterations >= (std::size_t{1} << 30) ) {
+      const auto ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+      r.iterations    = iterations;
+      r.ns_per_op     = ns / static_cast<double>(iterations);
+      r.ns_per_item   = r.ns_per_op / static_cast<double>(items ? items : 1);
+      r.allocs_per_op = static_cast<double>(count) / static_cast<double>(iterations);
+      break;
+    }
+    iterations *= 2;
+  }
+
+  print( name, item_name, r );
+  return r;
+}
+
+//----------------------------------------------------------------------------
+
+template<typename T>
+inline void bit::tools::benchmark::do_not_optimize( const T& value )
+{
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+#endif // BIT_TOOLS_BENCHMARK_HPP
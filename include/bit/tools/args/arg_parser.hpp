@@ -2,6 +2,7 @@
 #define BIT_TOOLS_ARG_PARSER_HPP
 
 #include "arg_vector.hpp"
+#include "parse_statistics.hpp"
 
 #include <bit/stl/utility.hpp>
 #include <bit/stl/hashed_string_view.hpp>
@@ -71,8 +72,8 @@ namespace bit {
       using string_type = stl::basic_string_view<CharT,Traits>;
       using size_type   = std::size_t;
 
-      using unmatched_range = stl::range<typename unmatched_type::iterator,
-                                         typename unmatched_type::iterator>;
+      using unmatched_range = stl::range<typename unmatched_type::const_iterator,
+                                         typename unmatched_type::const_iterator>;
 
       //----------------------------------------------------------------------
       // Constructor
@@ -421,6 +422,10 @@ namespace bit {
     /// \brief Parses all \p args and stores the results in the variable
     ///        pointed to by \p arg_set
     ///
+    /// When compiled with \c BIT_TOOLS_ENABLE_PARSE_INSTRUMENTATION, the
+    /// counters for each call are reported to the callback installed with
+    /// set_parse_statistics_callback
+    ///
     /// \param arg_set
     /// \param args
     /// \return \c true if parsing was successful
@@ -470,4 +475,33 @@ namespace bit {
 
 #include "detail/arg_parser.inl"
 
+//----------------------------------------------------------------------------
+// Explicit Instantiations
+//----------------------------------------------------------------------------
+
+// The char and wchar_t argument types are instantiated once in the bit_tools
+// library (src/bit/tools/args/arg_parser.cpp), rather than in every
+// translation unit that includes this header
+namespace bit {
+  namespace tools {
+
+    extern template class basic_arg_set<char>;
+    extern template class basic_single_arg<char>;
+    extern template class basic_multi_arg<char>;
+    extern template class basic_option_arg<char>;
+    extern template class basic_alias_arg<char>;
+    extern template bool parse_arguments( basic_arg_set<char>*,
+                                          basic_arg_vector<char> );
+
+    extern template class basic_arg_set<wchar_t>;
+    extern template class basic_single_arg<wchar_t>;
+    extern template class basic_multi_arg<wchar_t>;
+    extern template class basic_option_arg<wchar_t>;
+    extern template class basic_alias_arg<wchar_t>;
+    extern template bool parse_arguments( basic_arg_set<wchar_t>*,
+                                          basic_arg_vector<wchar_t> );
+
+  } // namespace tools
+} // namespace bit
+
 #endif // BIT_TOOLS_ARG_PARSER_HPP
@@ -1,21 +1,78 @@
 #ifndef BIT_TOOLS_ARG_SUGGESTOR_HPP
 #define BIT_TOOLS_ARG_SUGGESTOR_HPP
 
+#include "distance_metric.hpp"
+#include "letter_set_index.hpp"
+
 #include <bit/stl/string_view.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
 #include <initializer_list>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
-#include <map>
-#include <bitset>
 
 namespace bit {
   namespace tools {
 
-    std::size_t levenshtein_distance( stl::string_view lhs, stl::string_view rhs ) noexcept;
-    std::size_t damerau_levenshtien_distance( stl::string_view lhs, stl::string_view rhs ) noexcept;
-
-    template<typename CharT, typename Traits = std::char_traits<char>>
+    //////////////////////////////////////////////////////////////////////////
+    /// \brief Suggests the known arguments closest to an unrecognized one
+    ///
+    /// The search for candidates is delegated to an \p Index backend:
+    ///
+    /// - letter_set_index (the default) rejects arguments whose character
+    ///   sets and lengths are too different from the input's, several at a
+    ///   time, without reading their text. It suits the argument lists of
+    ///   a typical command line.
+    /// - bk_tree_index visits only a fraction of a metric tree, and suits
+    ///   vocabularies of hundreds of thousands of entries.
+    /// - symspell_index finds candidates with a few hash probes, and is the
+    ///   fastest for distances of at most 2, at the cost of memory.
+    /// - mapped_symspell_index searches a symspell_index saved to a file
+    ///   in place, so that it need not be rebuilt on every start.
+    /// - trie_index walks a trie with a Levenshtein automaton, whose state
+    ///   can be kept and extended as the input is typed; see automaton().
+    /// - trigram_index counts shared trigrams in compressed posting lists,
+    ///   and suits long arguments such as configuration keys and paths.
+    ///
+    /// Only letter_set_index is included here; the header of any other
+    /// index, such as <tt><bit/tools/args/trie_index.hpp></tt>, is included
+    /// by the code that chooses it, so that no program pays for backends
+    /// it does not use.
+    ///
+    /// An \p Index must provide \c size(),
+    /// <tt>search(query, max, visitor)</tt> and a \c metric_type, and be
+    /// constructible from <tt>(first, last, metric)</tt> or passed to the
+    /// suggestor ready-made.
+    ///
+    /// Candidates are scored by the metric of the index. A letter_set_index
+    /// takes it as a template policy, such as basic_jaro_winkler_metric, so
+    /// that the metric is inlined into the search; see metric_suggestor.
+    /// The other indices call a distance_function through a pointer.
+    ///
+    /// A suggestor is never modified after construction, so one instance
+    /// may be shared by any number of threads, which may call its const
+    /// member functions concurrently without synchronization. The buffers
+    /// used while scoring and ordering candidates are kept per thread and
+    /// reused, so with letter_set_index, suggest() and the suggestions()
+    /// that stores into an existing vector do not allocate once a thread's
+    /// buffers have grown to fit its queries.
+    ///
+    /// Arguments and input are compared in \p CharT, without transcoding;
+    /// with a wide \p CharT, the index must be a basic_letter_set_index of
+    /// the same character type, as the other indices only hold \c char.
+    ///
+    /// \tparam CharT the character type
+    /// \tparam Traits the character traits
+    /// \tparam Index the index used to find candidates
+    //////////////////////////////////////////////////////////////////////////
+    template<typename CharT,
+             typename Traits = std::char_traits<CharT>,
+             typename Index = basic_letter_set_index<CharT,Traits>>
     class arg_suggestor
     {
       //----------------------------------------------------------------------
@@ -23,32 +80,69 @@ namespace bit {
       //----------------------------------------------------------------------
     public:
 
+      using char_type        = CharT;
+      using traits_type      = Traits;
       using size_type        = std::size_t;
-      using distance_fn_type = std::size_t(*)(stl::string_view,stl::string_view);
+      using string_view_type = stl::basic_string_view<CharT,Traits>;
+      using index_type       = Index;
+      using metric_type      = typename Index::metric_type;
+
+      /// The default largest distance at which a suggestion is made, which
+      /// is that of a default-constructed metric, as the scale of each
+      /// metric is its own
+      static constexpr size_type default_max_distance = metric_type::default_max_distance;
+
+      /// The fewest known arguments worth searching on a thread of their
+      /// own; starting a thread costs about as much as scoring this many
+      static constexpr size_type min_partition_size = 65536;
 
       //----------------------------------------------------------------------
       // Constructors
       //----------------------------------------------------------------------
     public:
 
+      /// \brief Constructs a suggestor from the range of known arguments
+      ///        <tt>[first, last)</tt>
       ///
-      ///
-      /// \param first
-      /// \param last
+      /// \param first the start of the range of known arguments
+      /// \param last the end of the range of known arguments
+      /// \param max_distance the largest distance at which to suggest
+      /// \param metric the metric that scores candidates
       template<typename InputIt>
-      explicit arg_suggestor( InputIt first, InputIt last );
+      explicit arg_suggestor( InputIt first, InputIt last,
+                              size_type max_distance = default_max_distance,
+                              metric_type metric = metric_type{} );
+
+      /// \brief Constructs a suggestor from a list of known arguments
+      ///
+      /// \param ilist the known arguments
+      /// \param max_distance the largest distance at which to suggest
+      /// \param metric the metric that scores candidates
+      explicit arg_suggestor( std::initializer_list<std::basic_string<CharT,Traits>> ilist,
+                              size_type max_distance = default_max_distance,
+                              metric_type metric = metric_type{} );
 
-      /// \brief
+      /// \brief Constructs a suggestor from an existing \p index, such as
+      ///        one loaded from a file
       ///
-      /// \param ilist
-      explicit arg_suggestor( std::initializer_list<std::string> ilist );
+      /// \param index the index of known arguments
+      /// \param max_distance the largest distance at which to suggest
+      explicit arg_suggestor( index_type index,
+                              size_type max_distance = default_max_distance );
 
       //----------------------------------------------------------------------
       // Capacity
       //----------------------------------------------------------------------
     public:
 
+      /// \brief Returns whether this suggestor knows of any arguments
+      ///
+      /// \return \c true if there are no known arguments
       bool empty() const noexcept;
+
+      /// \brief Returns the number of known arguments
+      ///
+      /// \return the number of known arguments
       size_type size() const noexcept;
 
       //----------------------------------------------------------------------
@@ -56,21 +150,192 @@ namespace bit {
       //----------------------------------------------------------------------
     public:
 
-      stl::string_view suggest( stl::string_view input ) const;
+      /// \brief Returns the largest distance at which a known argument is
+      ///        suggested
+      ///
+      /// \return the maximum distance
+      size_type max_distance() const noexcept;
+
+      /// \brief Returns the index used to find candidates
+      ///
+      /// \return reference to the index
+      const index_type& index() const noexcept;
+
+      /// \brief Gets the known argument closest to \p input
+      ///
+      /// Ties are broken in favour of the lexicographically smallest
+      /// argument.
+      ///
+      /// \param input the unrecognized argument
+      /// \return the closest argument, or an empty view if none is within
+      ///         max_distance() edits
+      string_view_type suggest( string_view_type input ) const;
+
+      /// \brief Gets every known argument within max_distance() edits of \p input
+      ///
+      /// Candidates are compared with the bounded metric, so any candidate
+      /// further than max_distance() is rejected after only a few
+      /// characters.
+      ///
+      /// \param input the unrecognized argument
+      /// \return the suggestions, ordered from closest to furthest
+      std::vector<string_view_type> suggestions( string_view_type input ) const;
+
+      /// \brief Stores every known argument within max_distance() edits of
+      ///        \p input in \p result
+      ///
+      /// The contents of \p result are replaced, and its capacity reused;
+      /// a thread that keeps one vector for all of its queries does not
+      /// allocate once the vector has grown to fit them.
+      ///
+      /// \param result the vector to store the suggestions in, ordered
+      ///        from closest to furthest
+      /// \param input the unrecognized argument
+      void suggestions( std::vector<string_view_type>* result,
+                        string_view_type input ) const;
+
+      /// \brief Gets the \p count known arguments closest to \p input,
+      ///        searching the index with \p threads threads
+      ///
+      /// The index is split into one partition per thread, and each thread
+      /// keeps the \p count closest arguments of its partition. Once a
+      /// thread has \p count, the distance of its furthest is an upper bound
+      /// for every thread, which is shared atomically so that each thread
+      /// prunes with the best bound found by any of them. The result does
+      /// not depend on the number of threads, nor on their scheduling.
+      ///
+      /// Threads are started for the call, so fewer than \p threads are
+      /// used when the index is too small to give each of them
+      /// min_partition_size arguments, and no more than the hardware runs
+      /// at once. An index smaller than twice min_partition_size is
+      /// searched on the calling thread alone.
+      ///
+      /// This only takes part in overload resolution with an index that
+      /// can be searched in partitions, such as letter_set_index, through
+      /// <tt>search(query, max, part, parts, visitor)</tt>.
+      ///
+      /// \param input the unrecognized argument
+      /// \param count the largest number of suggestions
+      /// \param threads the largest number of threads to search with,
+      ///        including the calling thread
+      /// \return the suggestions, ordered from closest to furthest, with
+      ///         ties broken in favour of the lexicographically smallest
+      template<typename I = Index,
+               typename = decltype(std::declval<const I&>().search( std::declval<string_view_type>(),
+                                                                    size_type{}, size_type{}, size_type{},
+                                                                    std::declval<size_type(&)(string_view_type,size_type)>() ))>
+      std::vector<string_view_type> suggestions( string_view_type input,
+                                                 size_type count,
+                                                 size_type threads ) const;
+
+      //----------------------------------------------------------------------
+      // Incremental Suggestions
+      //----------------------------------------------------------------------
+    public:
+
+      // These only take part in overload resolution with an index that
+      // names an automaton_type, such as trie_index
+
+      /// \brief Creates an automaton of the empty input, for suggesting
+      ///        while the input is typed
+      ///
+      /// Each character typed is passed to the automaton's \c push_back,
+      /// which only does the work that the new character adds, and the
+      /// suggestions are read with suggest or suggestions.
+      ///
+      /// \return the automaton; it must not outlive this suggestor
+      template<typename I = Index>
+      typename I::automaton_type automaton() const;
+
+      /// \brief Gets the known argument closest to the input read by
+      ///        \p state
+      ///
+      /// \param state the automaton of the input
+      /// \return the closest argument, or an empty view if none is within
+      ///         max_distance() edits
+      template<typename I = Index>
+      string_view_type suggest( const typename I::automaton_type& state ) const;
+
+      /// \brief Gets every known argument within max_distance() edits of
+      ///        the input read by \p state
+      ///
+      /// \param state the automaton of the input
+      /// \return the suggestions, ordered from closest to furthest
+      template<typename I = Index>
+      std::vector<string_view_type> suggestions( const typename I::automaton_type& state ) const;
+
+      //----------------------------------------------------------------------
+      // Private Member Types
+      //----------------------------------------------------------------------
+    private:
+
+      struct match
+      {
+        size_type        distance;
+        string_view_type arg;
+      };
 
-      std::vector<stl::string_view> suggestions( stl::string_view input ) const;
+      //----------------------------------------------------------------------
+      // Private Members
+      //----------------------------------------------------------------------
+    private:
+
+      index_type m_index;        ///< The index of known arguments
+      size_type  m_max_distance; ///< The largest distance to suggest
 
+      //----------------------------------------------------------------------
+      // Private Member Functions
+      //----------------------------------------------------------------------
     private:
 
-      using bits            = std::bitset<27>;
-      using match_container = std::vector<std::string>;
+      /// \brief Gets the closest of the matches produced by \p search
+      ///
+      /// \param search a function that calls its argument with each match
+      /// \return the closest match, or an empty view if there are none
+      template<typename Search>
+      string_view_type closest( Search&& search ) const;
 
+      /// \brief Stores the matches produced by \p search in \p result,
+      ///        ordered from closest to furthest
+      ///
+      /// \param result the vector to store the matches in
+      /// \param search a function that calls its argument with each match
+      template<typename Search>
+      void ordered( std::vector<string_view_type>* result, Search&& search ) const;
 
-      distance_fn_type m_distance_fn; ///< The function used for computing distance
-      std::map<bits,match_container> m_args;
+      /// \brief Returns whether \p lhs is ordered before \p rhs; closer
+      ///        matches first, then lexicographically
+      ///
+      /// \param lhs the first match
+      /// \param rhs the second match
+      /// \return \c true if \p lhs is ordered first
+      static bool closer( const match& lhs, const match& rhs ) noexcept;
     };
 
+    //------------------------------------------------------------------------
+    // Type Aliases
+    //------------------------------------------------------------------------
+
+    /// \brief A suggestor that scores candidates with \p Metric, inlined
+    ///        into the search of a letter_set_index
+    ///
+    /// \code
+    /// auto suggestor = bit::tools::metric_suggestor<bit::tools::jaro_winkler_metric>{
+    ///   first, last
+    /// };
+    /// \endcode
+    ///
+    /// \tparam Metric the metric, of the same character type
+    /// \tparam CharT the character type
+    /// \tparam Traits the character traits
+    template<typename Metric,
+             typename CharT = typename Metric::char_type,
+             typename Traits = typename Metric::traits_type>
+    using metric_suggestor = arg_suggestor<CharT,Traits,basic_letter_set_index<CharT,Traits,Metric>>;
+
   } // namespace tools
 } // namespace bit
 
+#include "detail/arg_suggestor.inl"
+
 #endif // BIT_TOOLS_ARG_SUGGESTOR_HPP
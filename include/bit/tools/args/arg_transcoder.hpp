@@ -0,0 +1,135 @@
+#ifndef BIT_TOOLS_ARG_TRANSCODER_HPP
+#define BIT_TOOLS_ARG_TRANSCODER_HPP
+
+#include "arg_vector.hpp"
+
+#include <cstddef> // std::size_t
+#include <memory>  // std::unique_ptr
+
+namespace bit {
+  namespace tools {
+    namespace detail {
+
+      struct arg_transcoder;
+
+    } // namespace detail
+
+    //////////////////////////////////////////////////////////////////////////
+    /// \brief An owning UTF-8 argument vector, produced by transcoding a
+    ///        wide argument vector
+    ///
+    /// All arguments, along with the argv table that refers to them, are
+    /// stored in a single contiguous allocation. Each argument remains
+    /// null-terminated, and the table ends in a null pointer after the
+    /// last argument, so the result is usable anywhere an \c argv from
+    /// \c main is.
+    //////////////////////////////////////////////////////////////////////////
+    class transcoded_arg_vector
+    {
+      //----------------------------------------------------------------------
+      // Public Member Types
+      //----------------------------------------------------------------------
+    public:
+
+      using size_type = std::size_t;
+
+      //----------------------------------------------------------------------
+      // Constructors
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs a transcoded_arg_vector that contains no arguments
+      transcoded_arg_vector() noexcept;
+
+      /// \brief Move-constructs a transcoded_arg_vector from \p other
+      ///
+      /// \param other the other transcoded_arg_vector to move
+      transcoded_arg_vector( transcoded_arg_vector&& other ) noexcept = default;
+
+      transcoded_arg_vector( const transcoded_arg_vector& ) = delete;
+
+      /// \brief Move-assigns a transcoded_arg_vector from \p other
+      ///
+      /// \param other the other transcoded_arg_vector to move
+      /// \return reference to \c (*this)
+      transcoded_arg_vector& operator=( transcoded_arg_vector&& other ) noexcept = default;
+
+      transcoded_arg_vector& operator=( const transcoded_arg_vector& ) = delete;
+
+      //----------------------------------------------------------------------
+      // Capacity
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Returns whether this vector contains any arguments
+      ///
+      /// \return \c true if there are no arguments
+      bool empty() const noexcept;
+
+      /// \brief Returns the number of arguments in this vector
+      ///
+      /// \return the number of arguments
+      size_type size() const noexcept;
+
+      //----------------------------------------------------------------------
+      // Element Access
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Gets a non-owning view of the transcoded arguments
+      ///
+      /// \return the arguments, valid for the lifetime of this object
+      arg_vector args() const noexcept;
+
+      //----------------------------------------------------------------------
+      // Private Members
+      //----------------------------------------------------------------------
+    private:
+
+      std::unique_ptr<char[]> m_buffer; ///< The null-terminated argv table, followed by the text
+      int                     m_argc;   ///< The number of arguments
+
+      friend struct detail::arg_transcoder;
+    };
+
+    //------------------------------------------------------------------------
+    // Transcoding
+    //------------------------------------------------------------------------
+
+    /// \brief Transcodes all UTF-16 \p args into UTF-8, and stores the
+    ///        result in the vector pointed to by \p result
+    ///
+    /// Runs of ASCII are converted with a vectorized fast path. Unpaired
+    /// surrogates are rejected.
+    ///
+    /// \param result the vector to store the transcoded arguments in
+    /// \param args the arguments to transcode
+    /// \return \c true if every argument was valid UTF-16
+    bool transcode_arguments( transcoded_arg_vector* result, u16arg_vector args );
+
+    /// \brief Transcodes all UTF-32 \p args into UTF-8, and stores the
+    ///        result in the vector pointed to by \p result
+    ///
+    /// Runs of ASCII are converted with a vectorized fast path. Surrogate
+    /// code points, and values beyond U+10FFFF, are rejected.
+    ///
+    /// \param result the vector to store the transcoded arguments in
+    /// \param args the arguments to transcode
+    /// \return \c true if every argument was valid UTF-32
+    bool transcode_arguments( transcoded_arg_vector* result, u32arg_vector args );
+
+    /// \brief Transcodes all wide \p args into UTF-8, and stores the
+    ///        result in the vector pointed to by \p result
+    ///
+    /// Wide strings are treated as UTF-16 when \c wchar_t is 16 bits (as on
+    /// Windows), and as UTF-32 otherwise.
+    ///
+    /// \param result the vector to store the transcoded arguments in
+    /// \param args the arguments to transcode
+    /// \return \c true if every argument was valid
+    bool transcode_arguments( transcoded_arg_vector* result, warg_vector args );
+
+  } // namespace tools
+} // namespace bit
+
+#endif // BIT_TOOLS_ARG_TRANSCODER_HPP
@@ -324,4 +324,22 @@ namespace bit {
 
 #include "detail/arg_vector.inl"
 
+//----------------------------------------------------------------------------
+// Explicit Instantiations
+//----------------------------------------------------------------------------
+
+// The char and wchar_t arg vectors are instantiated once in the bit_tools
+// library (src/bit/tools/args/arg_vector.cpp)
+namespace bit {
+  namespace tools {
+
+    extern template class arg_vector_iterator<char>;
+    extern template class basic_arg_vector<char>;
+
+    extern template class arg_vector_iterator<wchar_t>;
+    extern template class basic_arg_vector<wchar_t>;
+
+  } // namespace tools
+} // namespace bit
+
 #endif
@@ -0,0 +1,122 @@
+#ifndef BIT_TOOLS_BK_TREE_INDEX_HPP
+#define BIT_TOOLS_BK_TREE_INDEX_HPP
+
+#include "distance_metric.hpp"
+
+#include <bit/stl/string_view.hpp>
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+#include <string>  // std::string
+#include <vector>  // std::vector
+
+namespace bit {
+  namespace tools {
+
+    //////////////////////////////////////////////////////////////////////////
+    /// \brief A suggestion index that arranges arguments in a
+    ///        Burkhard-Keller tree
+    ///
+    /// Each child of a node is keyed by its distance to that node. By the
+    /// triangle inequality, a query at distance \c d from a node can only
+    /// match within the children whose keys lie in <tt>[d - max, d + max]</tt>,
+    /// so a search with a small \c max visits only a fraction of the tree.
+    ///
+    /// Nodes are stored in a single array in breadth-first order, with the
+    /// children of each node contiguous and sorted by key, and each node at
+    /// the same index as its argument.
+    ///
+    /// \note The distance function must be a metric. levenshtein_distance
+    ///       is; the optimal string alignment distance computed by
+    ///       damerau_levenshtein_distance is not, and may miss matches.
+    //////////////////////////////////////////////////////////////////////////
+    class bk_tree_index
+    {
+      //----------------------------------------------------------------------
+      // Public Member Types
+      //----------------------------------------------------------------------
+    public:
+
+      using size_type        = std::size_t;
+      using distance_fn_type = std::size_t(*)(stl::string_view,stl::string_view,std::size_t);
+      using metric_type      = distance_function;
+
+      //----------------------------------------------------------------------
+      // Constructors
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs an index of the arguments in <tt>[first, last)</tt>
+      ///
+      /// \param first the start of the range of arguments
+      /// \param last the end of the range of arguments
+      /// \param fn the bounded distance function; must be a metric
+      template<typename InputIt>
+      bk_tree_index( InputIt first, InputIt last, metric_type fn );
+
+      //----------------------------------------------------------------------
+      // Capacity
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Returns the number of indexed arguments
+      ///
+      /// \return the number of arguments
+      size_type size() const noexcept;
+
+      //----------------------------------------------------------------------
+      // Search
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Calls \p visitor with each argument, and its distance,
+      ///        that is within \p max of \p query
+      ///
+      /// \param query the string to search for
+      /// \param max the largest distance to report
+      /// \param visitor a function callable as
+      ///        <tt>visitor(stl::string_view, size_type)</tt>
+      /// \return the number of nodes that were visited
+      template<typename Visitor>
+      size_type search( stl::string_view query,
+                        size_type max,
+                        Visitor&& visitor ) const;
+
+      //----------------------------------------------------------------------
+      // Private Member Types
+      //----------------------------------------------------------------------
+    private:
+
+      struct node
+      {
+        std::uint32_t key;         ///< The distance to the parent node
+        std::uint32_t first_child; ///< The index of the first child
+        std::uint32_t child_count; ///< The number of children
+      };
+
+      //----------------------------------------------------------------------
+      // Private Members
+      //----------------------------------------------------------------------
+    private:
+
+      metric_type              m_distance_fn; ///< The function used for computing distance
+      std::vector<node>        m_nodes;       ///< The nodes, in breadth-first order
+      std::vector<std::string> m_args;        ///< The argument of each node
+
+      //----------------------------------------------------------------------
+      // Private Member Functions
+      //----------------------------------------------------------------------
+    private:
+
+      /// \brief Builds the tree from \p args
+      ///
+      /// \param args the arguments to index
+      void build( std::vector<std::string> args );
+    };
+
+  } // namespace tools
+} // namespace bit
+
+#include "detail/bk_tree_index.inl"
+
+#endif // BIT_TOOLS_BK_TREE_INDEX_HPP
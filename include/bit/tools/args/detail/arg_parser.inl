@@ -27,7 +27,7 @@ template<typename CharT, typename Traits>
 inline bool bit::tools::basic_arg_set<CharT,Traits>::empty()
   const noexcept
 {
-  return m_head;
+  return m_head == nullptr;
 }
 
 template<typename CharT, typename Traits>
@@ -35,10 +35,11 @@ inline typename bit::tools::basic_arg_set<CharT,Traits>::size_type
   bit::tools::basic_arg_set<CharT,Traits>::size()
   const noexcept
 {
-  auto size = 0;
+  auto size = size_type{0};
+  auto node = m_head;
 
-  while(m_head){
-    m_head=m_head->next;
+  while(node){
+    node=node->next;
     ++size;
   }
 
@@ -65,7 +66,7 @@ template<typename CharT, typename Traits>
 inline bit::tools::basic_single_arg<CharT,Traits>
   ::basic_single_arg( set_type& parent, key_type flag )
   noexcept
-  : basic_single_arg( parent, flag, "" )
+  : basic_single_arg( parent, flag, value_type{} )
 {
 
 }
@@ -323,15 +324,23 @@ bool bit::tools::parse_arguments( basic_arg_set<CharT,Traits>* arg_set,
 
   //--------------------------------------------------------------------------
 
+  BIT_TOOLS_DETAIL_PARSE_PROBE( const auto parse_start = detail::parse_clock::now(); )
+  BIT_TOOLS_DETAIL_PARSE_PROBE( auto stats = parse_statistics{}; )
+
   // Find the argument from the intrinsically-linked list
   const auto find_arg = [&]( auto arg ) -> arg_node*
   {
+    BIT_TOOLS_DETAIL_PARSE_PROBE( detail::scoped_parse_timer timer{&stats.lookup_time}; )
+    BIT_TOOLS_DETAIL_PARSE_PROBE( ++stats.flag_lookups; )
+
     auto ptr = arg_set->m_head;
 
     while(ptr) {
+      BIT_TOOLS_DETAIL_PARSE_PROBE( ++stats.string_comparisons; )
       if( ptr->flag == arg ) {
         // Follow all aliases
         while( ptr->type == arg_node::node_type::alias ) {
+          BIT_TOOLS_DETAIL_PARSE_PROBE( ++stats.alias_hops; )
           ptr = ptr->storage.alias;
         }
         return ptr;
@@ -348,12 +357,13 @@ bool bit::tools::parse_arguments( basic_arg_set<CharT,Traits>* arg_set,
   auto i    = std::ptrdiff_t{0};
   auto size = narrow_cast<std::ptrdiff_t>(args.size());
 
-  while( i < args.size() ) {
+  while( i < size ) {
     auto node = find_arg( args[i] );
 
     if( !node ) {
       // It's not matched anywhere
       arg_set->m_unmatched.push_back( args[i] );
+      BIT_TOOLS_DETAIL_PARSE_PROBE( ++stats.unmatched; )
       ++i;
       continue;
     }
@@ -366,15 +376,13 @@ bool bit::tools::parse_arguments( basic_arg_set<CharT,Traits>* arg_set,
 
     case arg_node::node_type::single:
     {
-      if( i+1 < args.size() ) {
-        // If the next argument is not a known flag
-        if( !find_arg( args[i+1] ) ) {
-          node->storage.single = args[i+1];
-          ++i;
-        }
+      // If there is a next argument, and it is not a known flag
+      if( i+1 < size && !find_arg( args[i+1] ) ) {
+        node->storage.single = args[i+1];
         ++i;
-        node->set = true;
       }
+      ++i;
+      node->set = true;
       break;
     }
 
@@ -386,7 +394,7 @@ bool bit::tools::parse_arguments( basic_arg_set<CharT,Traits>* arg_set,
     {
       auto j = i+1;
       // Find each argument that is not a known flag
-      while( j < args.size() && !find_arg( args[j] ) ) {
+      while( j < size && !find_arg( args[j] ) ) {
         ++j;
       }
       node->storage.multi = args.subvec(i+1,j-i-1);
@@ -414,6 +422,8 @@ bool bit::tools::parse_arguments( basic_arg_set<CharT,Traits>* arg_set,
     } // switch
   } // while
 
+  BIT_TOOLS_DETAIL_PARSE_PROBE( detail::report_parse_statistics( stats, parse_start ); )
+
   return true;
 }
 
@@ -0,0 +1,313 @@
+#ifndef BIT_TOOLS_ARGS_DETAIL_ARG_SUGGESTOR_INL
+#define BIT_TOOLS_ARGS_DETAIL_ARG_SUGGESTOR_INL
+
+//============================================================================
+// arg_suggestor
+//============================================================================
+
+template<typename CharT, typename Traits, typename Index>
+constexpr typename bit::tools::arg_suggestor<CharT,Traits,Index>::size_type
+  bit::tools::arg_suggestor<CharT,Traits,Index>::default_max_distance;
+
+template<typename CharT, typename Traits, typename Index>
+constexpr typename bit::tools::arg_suggestor<CharT,Traits,Index>::size_type
+  bit::tools::arg_suggestor<CharT,Traits,Index>::min_partition_size;
+
+//----------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits, typename Index>
+template<typename InputIt>
+inline bit::tools::arg_suggestor<CharT,Traits,Index>
+  ::arg_suggestor( InputIt first, InputIt last,
+                   size_type max_distance,
+                   metric_type metric )
+  : m_index(first, last, std::move(metric)),
+    m_max_distance(max_distance)
+{
+
+}
+
+template<typename CharT, typename Traits, typename Index>
+inline bit::tools::arg_suggestor<CharT,Traits,Index>
+  ::arg_suggestor( std::initializer_list<std::basic_string<CharT,Traits>> ilist,
+                   size_type max_distance,
+                   metric_type metric )
+  : arg_suggestor( ilist.begin(), ilist.end(), max_distance, std::move(metric) )
+{
+
+}
+
+template<typename CharT, typename Traits, typename Index>
+inline bit::tools::arg_suggestor<CharT,Traits,Index>
+  ::arg_suggestor( index_type index, size_type max_distance )
+  : m_index(std::move(index)),
+    m_max_distance(max_distance)
+{
+
+}
+
+//----------------------------------------------------------------------------
+// Capacity
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits, typename Index>
+inline bool bit::tools::arg_suggestor<CharT,Traits,Index>::empty()
+  const noexcept
+{
+  return m_index.size() == 0;
+}
+
+template<typename CharT, typename Traits, typename Index>
+inline typename bit::tools::arg_suggestor<CharT,Traits,Index>::size_type
+  bit::tools::arg_suggestor<CharT,Traits,Index>::size()
+  const noexcept
+{
+  return m_index.size();
+}
+
+//----------------------------------------------------------------------------
+// Observers
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits, typename Index>
+inline typename bit::tools::arg_suggestor<CharT,Traits,Index>::size_type
+  bit::tools::arg_suggestor<CharT,Traits,Index>::max_distance()
+  const noexcept
+{
+  return m_max_distance;
+}
+
+template<typename CharT, typename Traits, typename Index>
+inline const typename bit::tools::arg_suggestor<CharT,Traits,Index>::index_type&
+  bit::tools::arg_suggestor<CharT,Traits,Index>::index()
+  const noexcept
+{
+  return m_index;
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits, typename Index>
+inline typename bit::tools::arg_suggestor<CharT,Traits,Index>::string_view_type
+  bit::tools::arg_suggestor<CharT,Traits,Index>::suggest( string_view_type input )
+  const
+{
+  return closest( [&]( auto&& visitor ) {
+    m_index.search( input, m_max_distance, visitor );
+  });
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits, typename Index>
+inline std::vector<typename bit::tools::arg_suggestor<CharT,Traits,Index>::string_view_type>
+  bit::tools::arg_suggestor<CharT,Traits,Index>::suggestions( string_view_type input )
+  const
+{
+  auto result = std::vector<string_view_type>{};
+  suggestions( &result, input );
+  return result;
+}
+
+template<typename CharT, typename Traits, typename Index>
+inline void
+  bit::tools::arg_suggestor<CharT,Traits,Index>
+  ::suggestions( std::vector<string_view_type>* result, string_view_type input )
+  const
+{
+  ordered( result, [&]( auto&& visitor ) {
+    m_index.search( input, m_max_distance, visitor );
+  });
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits, typename Index>
+template<typename I, typename>
+inline std::vector<typename bit::tools::arg_suggestor<CharT,Traits,Index>::string_view_type>
+  bit::tools::arg_suggestor<CharT,Traits,Index>
+  ::suggestions( string_view_type input, size_type count, size_type threads )
+  const
+{
+  if( count == 0 ) return {};
+
+  // A thread that is started for less work than it costs to start, or
+  // that waits for a core, only slows the search down
+  static const auto hardware = size_type{std::thread::hardware_concurrency()};
+  threads = std::min( threads, m_index.size() / min_partition_size );
+  if( hardware != 0 ) threads = std::min( threads, hardware );
+  if( threads == 0 ) threads = 1;
+
+  std::atomic<size_type> bound( m_max_distance );
+  auto heaps  = std::vector<std::vector<match>>( threads );
+  auto errors = std::vector<std::exception_ptr>( threads );
+
+  const auto tighten = [&]( size_type distance ) {
+    auto current = bound.load( std::memory_order_relaxed );
+    while( distance < current &&
+           !bound.compare_exchange_weak( current, distance, std::memory_order_relaxed ) ) {}
+  };
+
+  // Each worker keeps a max-heap of its count closest matches
+  const auto work = [&]( size_type part ) {
+    try {
+      auto& heap = heaps[part];
+      heap.reserve( count );
+
+      m_index.search( input, m_max_distance, part, threads, [&]( string_view_type arg, size_type distance ) {
+        const auto m = match{ distance, arg };
+        if( heap.size() < count ) {
+          heap.push_back( m );
+          std::push_heap( heap.begin(), heap.end(), &closer );
+        } else if( closer( m, heap.front() ) ) {
+          std::pop_heap( heap.begin(), heap.end(), &closer );
+          heap.back() = m;
+          std::push_heap( heap.begin(), heap.end(), &closer );
+        }
+
+        // Ties are broken by the argument, so those as far as the bound
+        // are still of interest
+        if( heap.size() == count ) tighten( heap.front().distance );
+        return bound.load( std::memory_order_relaxed );
+      });
+    } catch( ... ) {
+      errors[part] = std::current_exception();
+    }
+  };
+
+  auto workers = std::vector<std::thread>{};
+  workers.reserve( threads - 1 );
+  try {
+    for( auto part = size_type{1}; part < threads; ++part ) {
+      workers.emplace_back( work, part );
+    }
+  } catch( ... ) {
+    for( auto& worker : workers ) worker.join();
+    throw;
+  }
+  work( 0 );
+  for( auto& worker : workers ) worker.join();
+
+  for( const auto& error : errors ) {
+    if( error ) std::rethrow_exception( error );
+  }
+
+  // Every match of the result survives in the heap of its partition
+  auto matches = std::vector<match>{};
+  for( const auto& heap : heaps ) {
+    matches.insert( matches.end(), heap.begin(), heap.end() );
+  }
+  std::sort( matches.begin(), matches.end(), &closer );
+  if( matches.size() > count ) matches.resize( count );
+
+  auto result = std::vector<string_view_type>{};
+  result.reserve( matches.size() );
+  for( const auto& m : matches ) {
+    result.push_back( m.arg );
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+// Incremental Suggestions
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits, typename Index>
+template<typename I>
+inline typename I::automaton_type
+  bit::tools::arg_suggestor<CharT,Traits,Index>::automaton()
+  const
+{
+  return m_index.automaton( m_max_distance );
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits, typename Index>
+template<typename I>
+inline typename bit::tools::arg_suggestor<CharT,Traits,Index>::string_view_type
+  bit::tools::arg_suggestor<CharT,Traits,Index>
+  ::suggest( const typename I::automaton_type& state )
+  const
+{
+  return closest( [&]( auto&& visitor ) {
+    state.search( visitor );
+  });
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits, typename Index>
+template<typename I>
+inline std::vector<typename bit::tools::arg_suggestor<CharT,Traits,Index>::string_view_type>
+  bit::tools::arg_suggestor<CharT,Traits,Index>
+  ::suggestions( const typename I::automaton_type& state )
+  const
+{
+  auto result = std::vector<string_view_type>{};
+  ordered( &result, [&]( auto&& visitor ) {
+    state.search( visitor );
+  });
+  return result;
+}
+
+//----------------------------------------------------------------------------
+// Private Member Functions
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits, typename Index>
+template<typename Search>
+inline typename bit::tools::arg_suggestor<CharT,Traits,Index>::string_view_type
+  bit::tools::arg_suggestor<CharT,Traits,Index>::closest( Search&& search )
+  const
+{
+  auto best = match{ m_max_distance + 1, string_view_type{} };
+
+  search( [&]( string_view_type arg, size_type distance ) {
+    const auto m = match{ distance, arg };
+    if( closer( m, best ) ) best = m;
+  });
+  return best.arg;
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits, typename Index>
+template<typename Search>
+inline void
+  bit::tools::arg_suggestor<CharT,Traits,Index>
+  ::ordered( std::vector<string_view_type>* result, Search&& search )
+  const
+{
+  // Kept per thread, so that concurrent queries neither allocate nor
+  // contend for it
+  thread_local auto matches = std::vector<match>{};
+  matches.clear();
+
+  search( [&]( string_view_type arg, size_type distance ) {
+    matches.push_back( match{ distance, arg } );
+  });
+
+  std::sort( matches.begin(), matches.end(), &closer );
+
+  result->clear();
+  result->reserve( matches.size() );
+  for( const auto& m : matches ) {
+    result->push_back( m.arg );
+  }
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits, typename Index>
+inline bool bit::tools::arg_suggestor<CharT,Traits,Index>
+  ::closer( const match& lhs, const match& rhs )
+  noexcept
+{
+  return lhs.distance < rhs.distance ||
+         (lhs.distance == rhs.distance && lhs.arg < rhs.arg);
+}
+
+#endif /* BIT_TOOLS_ARGS_DETAIL_ARG_SUGGESTOR_INL */
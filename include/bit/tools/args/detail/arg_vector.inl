@@ -266,11 +266,12 @@ inline bit::tools::basic_arg_vector<CharT,Traits>
                                                       size_type count )
   const noexcept
 {
-  const auto max_length = (pos > m_argc) ? 0       : m_argc - pos;
-  const auto argv       = (pos > m_argc) ? nullptr : m_argv + pos;
+  const auto argc       = static_cast<size_type>(m_argc);
+  const auto max_length = (pos > argc) ? 0       : argc - pos;
+  const auto argv       = (pos > argc) ? nullptr : m_argv + pos;
   const auto length     = (count > max_length ? max_length : count);
 
-  return basic_arg_vector( length, argv );
+  return basic_arg_vector( static_cast<argc_type>(length), argv );
 
 }
 
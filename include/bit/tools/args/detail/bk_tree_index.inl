@@ -0,0 +1,85 @@
+#ifndef BIT_TOOLS_ARGS_DETAIL_BK_TREE_INDEX_INL
+#define BIT_TOOLS_ARGS_DETAIL_BK_TREE_INDEX_INL
+
+//============================================================================
+// bk_tree_index
+//============================================================================
+
+//----------------------------------------------------------------------------
+// Constructor
+//----------------------------------------------------------------------------
+
+template<typename InputIt>
+inline bit::tools::bk_tree_index
+  ::bk_tree_index( InputIt first, InputIt last, metric_type fn )
+  : m_distance_fn(fn),
+    m_nodes(),
+    m_args()
+{
+  auto args = std::vector<std::string>{};
+  for( ; first != last; ++first ) {
+    args.emplace_back( *first );
+  }
+  build( std::move(args) );
+}
+
+//----------------------------------------------------------------------------
+// Capacity
+//----------------------------------------------------------------------------
+
+inline bit::tools::bk_tree_index::size_type
+  bit::tools::bk_tree_index::size()
+  const noexcept
+{
+  return m_args.size();
+}
+
+//----------------------------------------------------------------------------
+// Search
+//----------------------------------------------------------------------------
+
+template<typename Visitor>
+inline bit::tools::bk_tree_index::size_type
+  bit::tools::bk_tree_index::search( stl::string_view query,
+                                     size_type max,
+                                     Visitor&& visitor )
+  const
+{
+  if( m_nodes.empty() ) return 0;
+
+  auto visited = size_type{0};
+  auto pending = std::vector<std::uint32_t>{ 0 };
+
+  while( !pending.empty() ) {
+    const auto index = pending.back();
+    const auto& n    = m_nodes[index];
+    pending.pop_back();
+    ++visited;
+
+    // Children are sorted by key, so the last has the largest. Any distance
+    // beyond max plus that key rules out every child, so it need not be
+    // computed exactly
+    const auto first = n.first_child;
+    const auto last  = n.first_child + n.child_count;
+    const auto bound = max + (n.child_count ? m_nodes[last - 1].key : 0u);
+
+    const auto distance = m_distance_fn( query, m_args[index], bound );
+
+    if( distance <= max ) {
+      visitor( stl::string_view{m_args[index]}, distance );
+    }
+    if( distance > bound ) continue;
+
+    const auto low  = (distance > max) ? (distance - max) : size_type{0};
+    const auto high = distance + max;
+
+    for( auto child = first; child < last; ++child ) {
+      const auto key = m_nodes[child].key;
+      if( key > high ) break;
+      if( key >= low ) pending.push_back( child );
+    }
+  }
+  return visited;
+}
+
+#endif /* BIT_TOOLS_ARGS_DETAIL_BK_TREE_INDEX_INL */
@@ -0,0 +1,700 @@
+#ifndef BIT_TOOLS_ARGS_DETAIL_DISTANCE_METRIC_INL
+#define BIT_TOOLS_ARGS_DETAIL_DISTANCE_METRIC_INL
+
+//============================================================================
+// Distances
+//============================================================================
+
+template<typename CharT, typename Traits>
+inline std::size_t
+  bit::tools::levenshtein_distance( stl::basic_string_view<CharT,Traits> lhs,
+                                    stl::basic_string_view<CharT,Traits> rhs )
+  noexcept
+{
+  return levenshtein_distance( lhs, rhs, std::max( lhs.size(), rhs.size() ) );
+}
+
+template<typename CharT, typename Traits>
+inline std::size_t
+  bit::tools::levenshtein_distance( stl::basic_string_view<CharT,Traits> lhs,
+                                    stl::basic_string_view<CharT,Traits> rhs,
+                                    std::size_t max )
+  noexcept
+{
+  detail::trim_affixes( lhs, rhs );
+
+  if( lhs.size() < rhs.size() ) std::swap( lhs, rhs );
+
+  if( lhs.size() - rhs.size() > max ) return max + 1;
+
+  if( rhs.empty() ) return lhs.size();
+
+  max = std::min( max, lhs.size() );
+
+  if( rhs.size() <= detail::distance_word_bits ) {
+    return detail::myers_distance( lhs, rhs, max );
+  }
+
+  // Long patterns of wide characters are rare enough that the band, which
+  // spans the whole table once max reaches the length, serves them too
+  const auto band_cells = 2 * max + 3;
+  if( band_cells <= detail::distance_stack_cells ) {
+    std::size_t band[detail::distance_stack_cells];
+    return detail::levenshtein_band( lhs, rhs, max, band );
+  }
+  return detail::levenshtein_band( lhs, rhs, max, detail::scratch_storage<std::size_t>( band_cells ) );
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline std::size_t
+  bit::tools::damerau_levenshtein_distance( stl::basic_string_view<CharT,Traits> lhs,
+                                            stl::basic_string_view<CharT,Traits> rhs )
+  noexcept
+{
+  return damerau_levenshtein_distance( lhs, rhs, std::max( lhs.size(), rhs.size() ) );
+}
+
+template<typename CharT, typename Traits>
+inline std::size_t
+  bit::tools::damerau_levenshtein_distance( stl::basic_string_view<CharT,Traits> lhs,
+                                            stl::basic_string_view<CharT,Traits> rhs,
+                                            std::size_t max )
+  noexcept
+{
+  detail::trim_affixes( lhs, rhs );
+
+  if( lhs.size() < rhs.size() ) std::swap( lhs, rhs );
+
+  if( lhs.size() - rhs.size() > max ) return max + 1;
+
+  if( rhs.empty() ) return lhs.size();
+
+  max = std::min( max, lhs.size() );
+
+  if( rhs.size() <= detail::distance_word_bits ) {
+    return detail::hyyro_distance( lhs, rhs, max );
+  }
+
+  const auto band_cells = 3 * (2 * max + 3);
+  if( band_cells <= detail::distance_stack_cells * 3 ) {
+    std::size_t band[detail::distance_stack_cells * 3];
+    return detail::osa_band( lhs, rhs, max, band );
+  }
+  return detail::osa_band( lhs, rhs, max, detail::scratch_storage<std::size_t>( band_cells ) );
+}
+
+//----------------------------------------------------------------------------
+
+inline std::size_t
+  bit::tools::damerau_levenshtien_distance( stl::string_view lhs,
+                                            stl::string_view rhs )
+  noexcept
+{
+  return damerau_levenshtein_distance( lhs, rhs );
+}
+
+//============================================================================
+// detail
+//============================================================================
+
+template<typename CharT, typename Traits>
+inline void
+  bit::tools::detail::trim_dashes( stl::basic_string_view<CharT,Traits>& lhs,
+                                   stl::basic_string_view<CharT,Traits>& rhs )
+  noexcept
+{
+  const auto dash   = CharT('-');
+  const auto length = std::min( lhs.size(), rhs.size() );
+
+  auto dashes = std::size_t{0};
+  while( dashes < length && Traits::eq( lhs[dashes], dash ) && Traits::eq( rhs[dashes], dash ) ) {
+    ++dashes;
+  }
+  lhs.remove_prefix( dashes );
+  rhs.remove_prefix( dashes );
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline std::size_t
+  bit::tools::detail::common_prefix( stl::basic_string_view<CharT,Traits> lhs,
+                                     stl::basic_string_view<CharT,Traits> rhs,
+                                     std::size_t limit )
+  noexcept
+{
+  const auto length = std::min( std::min( lhs.size(), rhs.size() ), limit );
+
+  auto prefix = std::size_t{0};
+  while( prefix < length && Traits::eq( lhs[prefix], rhs[prefix] ) ) {
+    ++prefix;
+  }
+  return prefix;
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline bool
+  bit::tools::detail::jaro_matches( std::size_t* matches,
+                                    std::size_t* transpositions,
+                                    stl::basic_string_view<CharT,Traits> text,
+                                    stl::basic_string_view<CharT,Traits> pattern,
+                                    std::size_t needed )
+  noexcept
+{
+  const auto n = text.size();
+  const auto m = pattern.size();
+
+  // Characters match at most this far apart
+  const auto window = (n / 2 > 0) ? (n / 2 - 1) : std::size_t{0};
+
+  auto count = std::size_t{0};
+  auto swaps = std::size_t{0};
+
+  // A character of the text can only match while its window overlaps the
+  // pattern, so once more of those have gone unmatched than this allows,
+  // too few can match
+  const auto end = std::min( n, m + window );
+  if( end < needed ) return false;
+
+  const auto spare = end - needed;
+  auto misses = std::size_t{0};
+
+  if( m <= distance_word_bits ) {
+    const auto table = match_table<CharT,Traits>{ text, pattern };
+
+    // The matched characters of the text, in order, to compare with those
+    // of the pattern
+    CharT matched[distance_word_bits];
+    auto  flagged = distance_word{0};
+
+    for( auto i = std::size_t{0}; i < end; ++i ) {
+      const auto low  = (i > window) ? (i - window) : std::size_t{0};
+      const auto high = std::min( i + window, m - 1 );
+
+      // Bits low to high, inclusive; shifting 2 by 63 leaves 0, and
+      // subtracting 1 then sets every bit
+      const auto in_window = ((distance_word{2} << high) - 1) & ~((distance_word{1} << low) - 1);
+      const auto found     = table[text[i]] & in_window & ~flagged;
+      if( found ) {
+        flagged |= found & (~found + 1);
+        matched[count++] = text[i];
+      } else if( ++misses > spare ) {
+        return false;
+      }
+    }
+
+    auto k = std::size_t{0};
+    for( auto j = std::size_t{0}; k < count; ++j ) {
+      if( (flagged >> j) & 1u ) {
+        if( !Traits::eq( pattern[j], matched[k] ) ) ++swaps;
+        ++k;
+      }
+    }
+  } else {
+    auto* const text_flags    = scratch_storage<unsigned char>( n + m );
+    auto* const pattern_flags = text_flags + n;
+    std::fill( text_flags, text_flags + n + m, static_cast<unsigned char>(0) );
+
+    for( auto i = std::size_t{0}; i < end; ++i ) {
+      const auto low  = (i > window) ? (i - window) : std::size_t{0};
+      const auto high = std::min( i + window + 1, m );
+
+      for( auto j = low; j < high; ++j ) {
+        if( !pattern_flags[j] && Traits::eq( text[i], pattern[j] ) ) {
+          text_flags[i] = pattern_flags[j] = 1;
+          ++count;
+          break;
+        }
+      }
+      if( !text_flags[i] && ++misses > spare ) return false;
+    }
+
+    auto j = std::size_t{0};
+    for( auto i = std::size_t{0}; i < n; ++i ) {
+      if( !text_flags[i] ) continue;
+      while( !pattern_flags[j] ) ++j;
+      if( !Traits::eq( text[i], pattern[j] ) ) ++swaps;
+      ++j;
+    }
+  }
+
+  *matches        = count;
+  *transpositions = swaps / 2;
+  return true;
+}
+
+//============================================================================
+// basic_levenshtein_metric
+//============================================================================
+
+template<typename CharT, typename Traits>
+constexpr typename bit::tools::basic_levenshtein_metric<CharT,Traits>::size_type
+  bit::tools::basic_levenshtein_metric<CharT,Traits>::default_max_distance;
+
+//----------------------------------------------------------------------------
+// Distance
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline typename bit::tools::basic_levenshtein_metric<CharT,Traits>::size_type
+  bit::tools::basic_levenshtein_metric<CharT,Traits>
+  ::operator()( string_view_type lhs, string_view_type rhs, size_type max )
+  const noexcept
+{
+  return levenshtein_distance( lhs, rhs, max );
+}
+
+template<typename CharT, typename Traits>
+inline typename bit::tools::basic_levenshtein_metric<CharT,Traits>::size_type
+  bit::tools::basic_levenshtein_metric<CharT,Traits>
+  ::edit_bound( size_type max, string_view_type )
+  const noexcept
+{
+  return max;
+}
+
+template<typename CharT, typename Traits>
+inline typename bit::tools::basic_levenshtein_metric<CharT,Traits>::size_type
+  bit::tools::basic_levenshtein_metric<CharT,Traits>
+  ::edit_bound( size_type max, string_view_type query, size_type )
+  const noexcept
+{
+  return edit_bound( max, query );
+}
+
+//============================================================================
+// basic_damerau_levenshtein_metric
+//============================================================================
+
+template<typename CharT, typename Traits>
+constexpr typename bit::tools::basic_damerau_levenshtein_metric<CharT,Traits>::size_type
+  bit::tools::basic_damerau_levenshtein_metric<CharT,Traits>::default_max_distance;
+
+//----------------------------------------------------------------------------
+// Distance
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline typename bit::tools::basic_damerau_levenshtein_metric<CharT,Traits>::size_type
+  bit::tools::basic_damerau_levenshtein_metric<CharT,Traits>
+  ::operator()( string_view_type lhs, string_view_type rhs, size_type max )
+  const noexcept
+{
+  return damerau_levenshtein_distance( lhs, rhs, max );
+}
+
+template<typename CharT, typename Traits>
+inline typename bit::tools::basic_damerau_levenshtein_metric<CharT,Traits>::size_type
+  bit::tools::basic_damerau_levenshtein_metric<CharT,Traits>
+  ::edit_bound( size_type max, string_view_type )
+  const noexcept
+{
+  // A transposition changes neither the length nor the characters
+  return max;
+}
+
+template<typename CharT, typename Traits>
+inline typename bit::tools::basic_damerau_levenshtein_metric<CharT,Traits>::size_type
+  bit::tools::basic_damerau_levenshtein_metric<CharT,Traits>
+  ::edit_bound( size_type max, string_view_type query, size_type )
+  const noexcept
+{
+  return edit_bound( max, query );
+}
+
+//============================================================================
+// basic_jaro_winkler_metric
+//============================================================================
+
+template<typename CharT, typename Traits>
+constexpr typename bit::tools::basic_jaro_winkler_metric<CharT,Traits>::size_type
+  bit::tools::basic_jaro_winkler_metric<CharT,Traits>::prefix_limit;
+
+template<typename CharT, typename Traits>
+constexpr typename bit::tools::basic_jaro_winkler_metric<CharT,Traits>::size_type
+  bit::tools::basic_jaro_winkler_metric<CharT,Traits>::default_max_distance;
+
+//----------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline bit::tools::basic_jaro_winkler_metric<CharT,Traits>
+  ::basic_jaro_winkler_metric( size_type scale, double prefix_scale )
+  noexcept
+  : m_scale(scale),
+    m_prefix_scale(prefix_scale)
+{
+
+}
+
+//----------------------------------------------------------------------------
+// Distance
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline typename bit::tools::basic_jaro_winkler_metric<CharT,Traits>::size_type
+  bit::tools::basic_jaro_winkler_metric<CharT,Traits>
+  ::operator()( string_view_type lhs, string_view_type rhs, size_type max )
+  const noexcept
+{
+  if( max >= m_scale ) {
+    return static_cast<size_type>((1.0 - similarity( lhs, rhs )) * m_scale + 0.5);
+  }
+
+  // A distance rounds to at most max only above this similarity; the
+  // slack keeps rounding errors from rejecting a string at the bound
+  const auto least = 1.0 - (max + 0.5) / m_scale - 1e-9;
+  const auto value = bounded_similarity( lhs, rhs, least );
+  if( value < 0.0 ) return max + 1;
+
+  const auto distance = static_cast<size_type>((1.0 - value) * m_scale + 0.5);
+  return (distance <= max) ? distance : max + 1;
+}
+
+template<typename CharT, typename Traits>
+inline typename bit::tools::basic_jaro_winkler_metric<CharT,Traits>::size_type
+  bit::tools::basic_jaro_winkler_metric<CharT,Traits>
+  ::edit_bound( size_type max, string_view_type query )
+  const noexcept
+{
+  const auto unbounded = std::numeric_limits<size_type>::max();
+  if( max >= m_scale ) return unbounded;
+
+  // Jaro's similarity is at most (1 + s/l + 1) / 3 for a shorter length s
+  // and a longer length l, which trimming a common run of dashes only
+  // lowers
+  const auto length = query.size();
+  const auto ratio  = 3.0 * least_jaro( max ) - 2.0;
+  if( ratio <= 0.0 ) return unbounded;
+
+  const auto longest = length / ratio + 1.0;
+  if( longest >= static_cast<double>(unbounded) ) return unbounded;
+  return std::max( length, static_cast<size_type>(longest) );
+}
+
+template<typename CharT, typename Traits>
+inline typename bit::tools::basic_jaro_winkler_metric<CharT,Traits>::size_type
+  bit::tools::basic_jaro_winkler_metric<CharT,Traits>
+  ::edit_bound( size_type max, string_view_type query, size_type length )
+  const noexcept
+{
+  const auto n = query.size();
+  if( max >= m_scale ) return std::max( n, length );
+
+  // A letter in only one of the strings has no match, so with c matches
+  // the signatures differ in at most (n - c) + (length - c) bits, and with
+  // the difference in length, in at most twice the longer length less c.
+  // The dashes that both strings start with are trimmed before matching,
+  // and the query bounds how many there can be
+  auto dashes = std::size_t{0};
+  while( dashes < n && dashes < length && Traits::eq( query[dashes], CharT('-') ) ) {
+    ++dashes;
+  }
+
+  const auto fewest = 3.0 * least_jaro( max ) - 1.0;
+
+  auto result = std::size_t{0};
+  for( auto d = std::size_t{0}; d <= dashes; ++d ) {
+    const auto l = n - d;
+    const auto s = length - d;
+    if( l == 0 || s == 0 ) {
+      // Strings that are left empty are only similar when both are
+      if( l == s ) result = std::max( result, std::max( n, length ) - d );
+      continue;
+    }
+
+    // With c matches, Jaro's similarity is at most (c / l + c / s + 1) / 3
+    const auto needed  = fewest * l * s / (l + s);
+    const auto matches = (needed > 0.0) ? static_cast<std::size_t>(std::ceil( needed - 1e-6 ))
+                                        : std::size_t{0};
+    if( matches > std::min( l, s ) ) continue;
+
+    result = std::max( result, std::max( l, s ) - matches );
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+// Observers
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline double
+  bit::tools::basic_jaro_winkler_metric<CharT,Traits>
+  ::similarity( string_view_type lhs, string_view_type rhs )
+  const noexcept
+{
+  return bounded_similarity( lhs, rhs, 0.0 );
+}
+
+template<typename CharT, typename Traits>
+inline typename bit::tools::basic_jaro_winkler_metric<CharT,Traits>::size_type
+  bit::tools::basic_jaro_winkler_metric<CharT,Traits>::scale()
+  const noexcept
+{
+  return m_scale;
+}
+
+//----------------------------------------------------------------------------
+// Private Member Functions
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline double
+  bit::tools::basic_jaro_winkler_metric<CharT,Traits>::least_jaro( size_type max )
+  const noexcept
+{
+  // A distance rounds to at most max only above the similarity least, and
+  // Winkler's weight raises Jaro's similarity j to at most
+  // j + boost * (1 - j), for the longest prefix it rewards
+  const auto boost = prefix_limit * m_prefix_scale;
+  const auto least = 1.0 - (max + 0.5) / m_scale;
+  return (least - boost) / (1.0 - boost);
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline double
+  bit::tools::basic_jaro_winkler_metric<CharT,Traits>
+  ::bounded_similarity( string_view_type lhs, string_view_type rhs, double least )
+  const noexcept
+{
+  detail::trim_dashes( lhs, rhs );
+
+  if( lhs.size() < rhs.size() ) std::swap( lhs, rhs );
+
+  if( rhs.empty() ) {
+    const auto similarity = lhs.empty() ? 1.0 : 0.0;
+    return (similarity >= least) ? similarity : -1.0;
+  }
+
+  const auto n     = static_cast<double>(lhs.size());
+  const auto m     = static_cast<double>(rhs.size());
+  const auto boost = detail::common_prefix( lhs, rhs, prefix_limit ) * m_prefix_scale;
+
+  // Winkler's weight raises Jaro's similarity j to at most
+  // j + boost * (1 - j), so j itself must reach least_j; and with c
+  // matches, j is at most (c / n + c / m + 1) / 3
+  const auto least_j = (least - boost) / (1.0 - boost);
+  const auto fewest  = (3.0 * least_j - 1.0) * n * m / (n + m);
+  if( fewest > m ) return -1.0;
+
+  const auto needed = (fewest > 0.0) ? static_cast<std::size_t>(std::ceil( fewest - 1e-9 ))
+                                     : std::size_t{0};
+
+  auto matches        = std::size_t{0};
+  auto transpositions = std::size_t{0};
+  if( !detail::jaro_matches( &matches, &transpositions, lhs, rhs, needed ) ) return -1.0;
+
+  if( matches == 0 ) return (least <= 0.0) ? 0.0 : -1.0;
+
+  const auto c    = static_cast<double>(matches);
+  const auto jaro = (c / n + c / m + (c - transpositions) / c) / 3.0;
+
+  // Winkler only weights the prefix of strings that are already similar
+  const auto similarity = (jaro > 0.7) ? jaro + boost * (1.0 - jaro) : jaro;
+  return (similarity >= least) ? similarity : -1.0;
+}
+
+//============================================================================
+// basic_prefix_weighted_metric
+//============================================================================
+
+template<typename CharT, typename Traits>
+constexpr typename bit::tools::basic_prefix_weighted_metric<CharT,Traits>::size_type
+  bit::tools::basic_prefix_weighted_metric<CharT,Traits>::default_max_distance;
+
+//----------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline bit::tools::basic_prefix_weighted_metric<CharT,Traits>
+  ::basic_prefix_weighted_metric( size_type edit_cost, size_type prefix_length )
+  noexcept
+  : m_edit_cost(edit_cost),
+    m_prefix_length(prefix_length)
+{
+
+}
+
+//----------------------------------------------------------------------------
+// Distance
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline typename bit::tools::basic_prefix_weighted_metric<CharT,Traits>::size_type
+  bit::tools::basic_prefix_weighted_metric<CharT,Traits>
+  ::operator()( string_view_type lhs, string_view_type rhs, size_type max )
+  const noexcept
+{
+  detail::trim_dashes( lhs, rhs );
+
+  const auto prefix = detail::common_prefix( lhs, rhs, m_prefix_length );
+  lhs.remove_prefix( prefix );
+  rhs.remove_prefix( prefix );
+
+  const auto edits    = (max + prefix) / m_edit_cost;
+  const auto distance = levenshtein_distance( lhs, rhs, edits );
+  if( distance > edits ) return max + 1;
+  if( distance == 0 ) return 0;
+
+  const auto weighted = distance * m_edit_cost - prefix;
+  return (weighted <= max) ? weighted : max + 1;
+}
+
+template<typename CharT, typename Traits>
+inline typename bit::tools::basic_prefix_weighted_metric<CharT,Traits>::size_type
+  bit::tools::basic_prefix_weighted_metric<CharT,Traits>
+  ::edit_bound( size_type max, string_view_type )
+  const noexcept
+{
+  return (max + m_prefix_length) / m_edit_cost;
+}
+
+template<typename CharT, typename Traits>
+inline typename bit::tools::basic_prefix_weighted_metric<CharT,Traits>::size_type
+  bit::tools::basic_prefix_weighted_metric<CharT,Traits>
+  ::edit_bound( size_type max, string_view_type query, size_type )
+  const noexcept
+{
+  return edit_bound( max, query );
+}
+
+//============================================================================
+// basic_distance_function
+//============================================================================
+
+template<typename CharT, typename Traits>
+constexpr typename bit::tools::basic_distance_function<CharT,Traits>::size_type
+  bit::tools::basic_distance_function<CharT,Traits>::default_max_distance;
+
+//----------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline bit::tools::basic_distance_function<CharT,Traits>::basic_distance_function()
+  noexcept
+  : m_fn(&levenshtein_distance)
+{
+
+}
+
+template<typename CharT, typename Traits>
+inline bit::tools::basic_distance_function<CharT,Traits>
+  ::basic_distance_function( distance_fn_type fn )
+  noexcept
+  : m_fn(fn)
+{
+
+}
+
+//----------------------------------------------------------------------------
+// Distance
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline typename bit::tools::basic_distance_function<CharT,Traits>::size_type
+  bit::tools::basic_distance_function<CharT,Traits>
+  ::operator()( string_view_type lhs, string_view_type rhs, size_type max )
+  const
+{
+  return m_fn( lhs, rhs, max );
+}
+
+template<typename CharT, typename Traits>
+inline typename bit::tools::basic_distance_function<CharT,Traits>::size_type
+  bit::tools::basic_distance_function<CharT,Traits>
+  ::edit_bound( size_type max, string_view_type )
+  const noexcept
+{
+  return max;
+}
+
+template<typename CharT, typename Traits>
+inline typename bit::tools::basic_distance_function<CharT,Traits>::size_type
+  bit::tools::basic_distance_function<CharT,Traits>
+  ::edit_bound( size_type max, string_view_type query, size_type )
+  const noexcept
+{
+  return edit_bound( max, query );
+}
+
+//============================================================================
+// utf8_levenshtein_metric
+//============================================================================
+
+//----------------------------------------------------------------------------
+// Distance
+//----------------------------------------------------------------------------
+
+inline bit::tools::utf8_levenshtein_metric::size_type
+  bit::tools::utf8_levenshtein_metric
+  ::operator()( string_view_type lhs, string_view_type rhs, size_type max )
+  const noexcept
+{
+  return utf8_levenshtein_distance( lhs, rhs, max );
+}
+
+inline bit::tools::utf8_levenshtein_metric::size_type
+  bit::tools::utf8_levenshtein_metric
+  ::edit_bound( size_type max, string_view_type )
+  const noexcept
+{
+  // A code point is encoded in up to 4 bytes
+  return 4 * max;
+}
+
+inline bit::tools::utf8_levenshtein_metric::size_type
+  bit::tools::utf8_levenshtein_metric
+  ::edit_bound( size_type max, string_view_type query, size_type length )
+  const noexcept
+{
+  const auto difference = (length < query.size()) ? (query.size() - length)
+                                                  : (length - query.size());
+
+  if( difference > 4 * max ) return 0;
+
+  return std::max( difference, max + (difference + 1) / 2 );
+}
+
+//============================================================================
+// utf8_damerau_levenshtein_metric
+//============================================================================
+
+//----------------------------------------------------------------------------
+// Distance
+//----------------------------------------------------------------------------
+
+inline bit::tools::utf8_damerau_levenshtein_metric::size_type
+  bit::tools::utf8_damerau_levenshtein_metric
+  ::operator()( string_view_type lhs, string_view_type rhs, size_type max )
+  const noexcept
+{
+  return utf8_damerau_levenshtein_distance( lhs, rhs, max );
+}
+
+inline bit::tools::utf8_damerau_levenshtein_metric::size_type
+  bit::tools::utf8_damerau_levenshtein_metric
+  ::edit_bound( size_type max, string_view_type query )
+  const noexcept
+{
+  return utf8_levenshtein_metric{}.edit_bound( max, query );
+}
+
+inline bit::tools::utf8_damerau_levenshtein_metric::size_type
+  bit::tools::utf8_damerau_levenshtein_metric
+  ::edit_bound( size_type max, string_view_type query, size_type length )
+  const noexcept
+{
+  return utf8_levenshtein_metric{}.edit_bound( max, query, length );
+}
+
+#endif /* BIT_TOOLS_ARGS_DETAIL_DISTANCE_METRIC_INL */
@@ -0,0 +1,375 @@
+#ifndef BIT_TOOLS_ARGS_DETAIL_EDIT_DISTANCE_INL
+#define BIT_TOOLS_ARGS_DETAIL_EDIT_DISTANCE_INL
+
+//============================================================================
+// match_table
+//============================================================================
+
+template<typename CharT, typename Traits, bool Bytes>
+inline bit::tools::detail::match_table<CharT,Traits,Bytes>
+  ::match_table( string_view_type text, string_view_type pattern )
+  noexcept
+{
+  const auto index = []( CharT c ) {
+    return static_cast<std::size_t>(static_cast<unsigned char>(c));
+  };
+
+  for( auto c : text ) {
+    m_vectors[index(c)] = 0;
+  }
+  for( auto c : pattern ) {
+    m_vectors[index(c)] = 0;
+  }
+  for( auto i = std::size_t{0}; i < pattern.size(); ++i ) {
+    m_vectors[index(pattern[i])] |= distance_word{1} << i;
+  }
+}
+
+template<typename CharT, typename Traits, bool Bytes>
+inline bit::tools::detail::distance_word
+  bit::tools::detail::match_table<CharT,Traits,Bytes>::operator[]( CharT c )
+  const noexcept
+{
+  return m_vectors[static_cast<unsigned char>(c)];
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+constexpr std::size_t bit::tools::detail::match_table<CharT,Traits,false>::slots;
+
+template<typename CharT, typename Traits>
+inline bit::tools::detail::match_table<CharT,Traits,false>
+  ::match_table( string_view_type text, string_view_type pattern )
+  noexcept
+  : m_small(true),
+    m_shift(32)
+{
+  for( auto c : pattern ) {
+    if( static_cast<unsigned_type>(c) >= 256u ) {
+      m_small = false;
+      break;
+    }
+  }
+
+  if( m_small ) {
+    for( auto c : text ) {
+      const auto u = static_cast<unsigned_type>(c);
+      if( u < 256u ) m_vectors[u] = 0;
+    }
+    for( auto c : pattern ) {
+      m_vectors[static_cast<unsigned_type>(c)] = 0;
+    }
+    for( auto i = std::size_t{0}; i < pattern.size(); ++i ) {
+      m_vectors[static_cast<unsigned_type>(pattern[i])] |= distance_word{1} << i;
+    }
+    return;
+  }
+
+  // The table is kept at most half full, so probes stay short
+  auto used = std::size_t{1};
+  while( used < 2 * pattern.size() ) {
+    used *= 2;
+    --m_shift;
+  }
+  const auto mask = used - 1;
+
+  // Every character of the pattern sets a bit, so an empty slot is zero
+  std::fill( m_slots, m_slots + used, distance_word{0} );
+  for( auto i = std::size_t{0}; i < pattern.size(); ++i ) {
+    const auto u = static_cast<unsigned_type>(pattern[i]);
+
+    auto s = home( u );
+    while( m_slots[s] != 0 && m_keys[s] != u ) s = (s + 1) & mask;
+
+    m_keys[s]   = u;
+    m_slots[s] |= distance_word{1} << i;
+  }
+}
+
+template<typename CharT, typename Traits>
+inline bit::tools::detail::distance_word
+  bit::tools::detail::match_table<CharT,Traits,false>::operator[]( CharT c )
+  const noexcept
+{
+  const auto u = static_cast<unsigned_type>(c);
+
+  if( m_small ) {
+    return (u < 256u) ? m_vectors[u] : distance_word{0};
+  }
+  const auto mask = (std::size_t{1} << (32 - m_shift)) - 1;
+  for( auto s = home( u ); m_slots[s] != 0; s = (s + 1) & mask ) {
+    if( m_keys[s] == u ) return m_slots[s];
+  }
+  return 0;
+}
+
+template<typename CharT, typename Traits>
+inline std::size_t
+  bit::tools::detail::match_table<CharT,Traits,false>::home( unsigned_type c )
+  const noexcept
+{
+  // Fibonacci hashing; the top bits of the product are the best mixed. A
+  // table of one slot keeps none of them
+  const auto product = static_cast<std::uint32_t>(c) * 2654435761u;
+  return (m_shift == 32) ? 0 : static_cast<std::size_t>(product >> m_shift);
+}
+
+//============================================================================
+// Kernels
+//============================================================================
+
+template<typename T>
+inline T* bit::tools::detail::scratch_storage( std::size_t count )
+{
+  thread_local std::vector<T> storage;
+
+  if( storage.size() < count ) storage.resize( count );
+  return storage.data();
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline void
+  bit::tools::detail::trim_affixes( stl::basic_string_view<CharT,Traits>& lhs,
+                                    stl::basic_string_view<CharT,Traits>& rhs )
+  noexcept
+{
+  auto prefix = std::size_t{0};
+  const auto length = std::min( lhs.size(), rhs.size() );
+  while( prefix < length && Traits::eq( lhs[prefix], rhs[prefix] ) ) {
+    ++prefix;
+  }
+  lhs.remove_prefix( prefix );
+  rhs.remove_prefix( prefix );
+
+  auto suffix = std::size_t{0};
+  const auto remaining = std::min( lhs.size(), rhs.size() );
+  while( suffix < remaining &&
+         Traits::eq( lhs[lhs.size() - suffix - 1], rhs[rhs.size() - suffix - 1] ) ) {
+    ++suffix;
+  }
+  lhs.remove_suffix( suffix );
+  rhs.remove_suffix( suffix );
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline std::size_t
+  bit::tools::detail::myers_distance( stl::basic_string_view<CharT,Traits> text,
+                                      stl::basic_string_view<CharT,Traits> pattern,
+                                      std::size_t max )
+  noexcept
+{
+  const auto peq  = match_table<CharT,Traits>( text, pattern );
+  const auto last = distance_word{1} << (pattern.size() - 1);
+
+  auto pv        = ~distance_word{0};
+  auto mv        = distance_word{0};
+  auto score     = pattern.size();
+  auto remaining = text.size();
+
+  for( auto c : text ) {
+    const auto eq = peq[c];
+    const auto xv = eq | mv;
+    const auto xh = (((eq & pv) + pv) ^ pv) | eq;
+
+    auto ph = mv | ~(xh | pv);
+    auto mh = pv & xh;
+
+    if( ph & last ) {
+      ++score;
+    } else if( mh & last ) {
+      --score;
+    }
+
+    // The score can decrease by at most one per remaining column
+    if( score > max + --remaining ) return max + 1;
+
+    // Every column of the first row increases by one
+    ph = (ph << 1) | 1;
+    mh = (mh << 1);
+
+    pv = mh | ~(xv | ph);
+    mv = ph & xv;
+  }
+  return score;
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline std::size_t
+  bit::tools::detail::hyyro_distance( stl::basic_string_view<CharT,Traits> text,
+                                      stl::basic_string_view<CharT,Traits> pattern,
+                                      std::size_t max )
+  noexcept
+{
+  const auto peq  = match_table<CharT,Traits>( text, pattern );
+  const auto last = distance_word{1} << (pattern.size() - 1);
+
+  auto pv        = ~distance_word{0};
+  auto mv        = distance_word{0};
+  auto d0        = distance_word{0};
+  auto previous  = distance_word{0};
+  auto score     = pattern.size();
+  auto remaining = text.size();
+
+  for( auto c : text ) {
+    const auto eq = peq[c];
+
+    // Diagonal zero-differences reachable through a transposition of the
+    // current and previous text characters
+    const auto tr = (((~d0) & eq) << 1) & previous;
+
+    d0 = (((eq & pv) + pv) ^ pv) | eq | mv | tr;
+
+    auto ph = mv | ~(d0 | pv);
+    auto mh = d0 & pv;
+
+    if( ph & last ) {
+      ++score;
+    } else if( mh & last ) {
+      --score;
+    }
+
+    if( score > max + --remaining ) return max + 1;
+
+    ph = (ph << 1) | 1;
+    mh = (mh << 1);
+
+    pv = mh | ~(d0 | ph);
+    mv = ph & d0;
+    previous = eq;
+  }
+  return score;
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline std::size_t
+  bit::tools::detail::levenshtein_band( stl::basic_string_view<CharT,Traits> lhs,
+                                        stl::basic_string_view<CharT,Traits> rhs,
+                                        std::size_t max,
+                                        std::size_t* band )
+  noexcept
+{
+  const auto n     = lhs.size();
+  const auto m     = rhs.size();
+  const auto limit = max + 1;
+  const auto width = 2 * max + 1;
+
+  // band[d + 1] holds the cell in column j = i + d - max of the current
+  // row i; band[0] and band[width + 1] are sentinels outside the band
+  auto* const cells = band + 1;
+
+  band[0] = limit;
+  for( auto d = std::size_t{0}; d <= width; ++d ) {
+    cells[d] = (d < max) ? limit : (d - max);
+  }
+
+  for( auto i = std::size_t{1}; i <= n; ++i ) {
+    auto row_min = limit;
+
+    for( auto d = std::size_t{0}; d < width; ++d ) {
+      if( i + d < max ) continue; // j < 0
+
+      const auto j = i + d - max;
+      if( j > m ) {
+        cells[d] = limit;
+        continue;
+      }
+
+      auto value = i;
+      if( j > 0 ) {
+        const auto cost = std::size_t{Traits::eq( lhs[i - 1], rhs[j - 1] ) ? 0u : 1u};
+
+        // Diagonal d is row i-1, column j-1; d+1 is row i-1, column j;
+        // and d-1 is row i, column j-1
+        value = std::min( std::min( cells[d + 1], cells[d - 1] ) + 1,
+                          cells[d] + cost );
+      }
+      cells[d] = std::min( value, limit );
+      row_min  = std::min( row_min, cells[d] );
+    }
+
+    // Every cell in the band exceeds the limit, so the result must too
+    if( row_min > max ) return limit;
+  }
+  return cells[m + max - n];
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline std::size_t
+  bit::tools::detail::osa_band( stl::basic_string_view<CharT,Traits> lhs,
+                                stl::basic_string_view<CharT,Traits> rhs,
+                                std::size_t max,
+                                std::size_t* band )
+  noexcept
+{
+  const auto n      = lhs.size();
+  const auto m      = rhs.size();
+  const auto limit  = max + 1;
+  const auto width  = 2 * max + 1;
+  const auto stride = width + 2;
+
+  // Rows i-2, i-1 and i, each with a sentinel on either side
+  auto* before   = band + 1;
+  auto* previous = before + stride;
+  auto* current  = previous + stride;
+
+  for( auto d = std::size_t{0}; d <= width; ++d ) {
+    before[d]   = limit;
+    previous[d] = (d < max) ? limit : (d - max);
+  }
+  before[-1] = previous[-1] = current[-1] = limit;
+  current[width] = limit;
+
+  for( auto i = std::size_t{1}; i <= n; ++i ) {
+    auto row_min = limit;
+
+    for( auto d = std::size_t{0}; d < width; ++d ) {
+      if( i + d < max ) {
+        current[d] = limit;
+        continue;
+      }
+
+      const auto j = i + d - max;
+      if( j > m ) {
+        current[d] = limit;
+        continue;
+      }
+
+      auto value = i;
+      if( j > 0 ) {
+        const auto cost = std::size_t{Traits::eq( lhs[i - 1], rhs[j - 1] ) ? 0u : 1u};
+
+        value = std::min( std::min( previous[d + 1], current[d - 1] ) + 1,
+                          previous[d] + cost );
+
+        // Row i-2, column j-2 lies on the same diagonal
+        if( i > 1 && j > 1 && Traits::eq( lhs[i - 1], rhs[j - 2] ) && Traits::eq( lhs[i - 2], rhs[j - 1] ) ) {
+          value = std::min( value, before[d] + 1 );
+        }
+      }
+      current[d] = std::min( value, limit );
+      row_min    = std::min( row_min, current[d] );
+    }
+
+    if( row_min > max ) return limit;
+
+    const auto oldest = before;
+    before   = previous;
+    previous = current;
+    current  = oldest;
+    current[width] = limit;
+  }
+  return previous[m + max - n];
+}
+
+#endif /* BIT_TOOLS_ARGS_DETAIL_EDIT_DISTANCE_INL */
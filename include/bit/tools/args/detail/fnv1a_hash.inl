@@ -0,0 +1,33 @@
+#ifndef BIT_TOOLS_ARGS_DETAIL_FNV1A_HASH_INL
+#define BIT_TOOLS_ARGS_DETAIL_FNV1A_HASH_INL
+
+//============================================================================
+// detail
+//============================================================================
+
+inline constexpr std::uint64_t
+  bit::tools::detail::fnv1a_step( std::uint64_t hash, std::uint64_t value )
+  noexcept
+{
+  return (hash ^ value) * fnv1a_prime;
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline std::uint64_t
+  bit::tools::detail::fnv1a_hash( stl::basic_string_view<CharT,Traits> str,
+                                  std::uint64_t seed )
+  noexcept
+{
+  using unsigned_type = typename std::make_unsigned<CharT>::type;
+
+  auto hash = seed;
+
+  for( auto c : str ) {
+    hash = fnv1a_step( hash, static_cast<unsigned_type>(c) );
+  }
+  return hash;
+}
+
+#endif /* BIT_TOOLS_ARGS_DETAIL_FNV1A_HASH_INL */
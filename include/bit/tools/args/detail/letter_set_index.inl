@@ -0,0 +1,357 @@
+#ifndef BIT_TOOLS_ARGS_DETAIL_LETTER_SET_INDEX_INL
+#define BIT_TOOLS_ARGS_DETAIL_LETTER_SET_INDEX_INL
+
+//============================================================================
+// detail
+//============================================================================
+
+template<typename CharT, typename Traits, typename ForwardIt>
+inline void bit::tools::detail::reserve_args( std::vector<CharT>* text,
+                                              std::vector<std::uint32_t>* offsets,
+                                              ForwardIt first, ForwardIt last,
+                                              std::forward_iterator_tag )
+{
+  auto count     = std::size_t{0};
+  auto text_size = std::size_t{0};
+  for( ; first != last; ++first ) {
+    const auto& arg = *first;
+    text_size += stl::basic_string_view<CharT,Traits>{ arg }.size();
+    ++count;
+  }
+  text->reserve( text_size );
+  offsets->reserve( count + 1 );
+}
+
+template<typename CharT, typename Traits, typename InputIt>
+inline void bit::tools::detail::reserve_args( std::vector<CharT>*,
+                                              std::vector<std::uint32_t>*,
+                                              InputIt, InputIt,
+                                              std::input_iterator_tag )
+{
+
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Metric, typename CharT, typename Traits>
+inline bool bit::tools::detail::score_candidates( std::size_t*,
+                                                  const Metric&,
+                                                  stl::basic_string_view<CharT,Traits>,
+                                                  const stl::basic_string_view<CharT,Traits>*,
+                                                  std::size_t,
+                                                  std::size_t )
+  noexcept
+{
+  return false;
+}
+
+inline bool bit::tools::detail::score_candidates( std::size_t* distances,
+                                                  const basic_levenshtein_metric<char>&,
+                                                  stl::string_view query,
+                                                  const stl::string_view* candidates,
+                                                  std::size_t count,
+                                                  std::size_t max )
+  noexcept
+{
+  levenshtein_distances( distances, query, candidates, count, max );
+  return true;
+}
+
+//============================================================================
+// basic_letter_set_index
+//============================================================================
+
+template<typename CharT, typename Traits, typename Metric>
+constexpr typename bit::tools::basic_letter_set_index<CharT,Traits,Metric>::size_type
+  bit::tools::basic_letter_set_index<CharT,Traits,Metric>::filter_block;
+
+//----------------------------------------------------------------------------
+// Constructor
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits, typename Metric>
+template<typename InputIt>
+inline bit::tools::basic_letter_set_index<CharT,Traits,Metric>
+  ::basic_letter_set_index( InputIt first, InputIt last, metric_type metric )
+  : m_metric(std::move(metric)),
+    m_signatures(),
+    m_offsets(),
+    m_length_starts(),
+    m_arena()
+{
+  // The arguments are copied into a single arena in the order given, and
+  // only sorted from there, so no argument is allocated on its own
+  auto text    = std::vector<CharT>{};
+  auto offsets = std::vector<std::uint32_t>{};
+  detail::reserve_args<CharT,Traits>( &text, &offsets, first, last,
+                                      typename std::iterator_traits<InputIt>::iterator_category{} );
+
+  for( ; first != last; ++first ) {
+    const auto& arg = *first;
+    const auto view = string_view_type{ arg };
+
+    offsets.push_back( static_cast<std::uint32_t>(text.size()) );
+    text.insert( text.end(), view.begin(), view.end() );
+  }
+  offsets.push_back( static_cast<std::uint32_t>(text.size()) );
+
+  build( text, offsets );
+}
+
+//----------------------------------------------------------------------------
+// Capacity
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits, typename Metric>
+inline typename bit::tools::basic_letter_set_index<CharT,Traits,Metric>::size_type
+  bit::tools::basic_letter_set_index<CharT,Traits,Metric>::size()
+  const noexcept
+{
+  return m_signatures.size();
+}
+
+template<typename CharT, typename Traits, typename Metric>
+inline typename bit::tools::basic_letter_set_index<CharT,Traits,Metric>::size_type
+  bit::tools::basic_letter_set_index<CharT,Traits,Metric>::memory_usage()
+  const noexcept
+{
+  return m_signatures.capacity() * sizeof(std::uint64_t) +
+         m_offsets.capacity() * sizeof(std::uint32_t) +
+         m_length_starts.capacity() * sizeof(std::uint32_t) +
+         m_arena.capacity() * sizeof(CharT);
+}
+
+//----------------------------------------------------------------------------
+// Observers
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits, typename Metric>
+inline const typename bit::tools::basic_letter_set_index<CharT,Traits,Metric>::metric_type&
+  bit::tools::basic_letter_set_index<CharT,Traits,Metric>::metric()
+  const noexcept
+{
+  return m_metric;
+}
+
+//----------------------------------------------------------------------------
+// Search
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits, typename Metric>
+template<typename Visitor>
+inline typename bit::tools::basic_letter_set_index<CharT,Traits,Metric>::size_type
+  bit::tools::basic_letter_set_index<CharT,Traits,Metric>::search( string_view_type query,
+                                                                   size_type max,
+                                                                   Visitor&& visitor )
+  const
+{
+  return search( query, max, 0, 1, [&]( string_view_type arg, size_type distance ) {
+    visitor( arg, distance );
+    return max;
+  });
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits, typename Metric>
+template<typename Visitor>
+inline typename bit::tools::basic_letter_set_index<CharT,Traits,Metric>::size_type
+  bit::tools::basic_letter_set_index<CharT,Traits,Metric>::search( string_view_type query,
+                                                                   size_type max,
+                                                                   size_type part,
+                                                                   size_type parts,
+                                                                   Visitor&& visitor )
+  const
+{
+  if( m_signatures.empty() ) return 0;
+
+  const auto query_bits = signature( query );
+  const auto length     = query.size();
+  const auto longest    = m_length_starts.size() - 2;
+
+  // No argument is more edits away than the longer of it and the query,
+  // which keeps the bound of a metric that cannot bound the length finite
+  const auto edit_bound = [&]( size_type distance ) {
+    return std::min( m_metric.edit_bound( distance, query ), std::max( length, longest ) );
+  };
+
+  std::uint32_t survivors[filter_block];
+  auto scored = size_type{0};
+  auto blocks_before = size_type{0};
+  auto edits = edit_bound( max );
+
+  const auto report = [&]( string_view_type candidate, size_type distance ) {
+    ++scored;
+
+    // The visitor may have lowered max since the candidate was scored
+    if( distance <= max ) {
+      const auto bound = size_type{visitor( candidate, distance )};
+      if( bound < max ) {
+        max   = bound;
+        edits = edit_bound( max );
+      }
+    }
+  };
+
+  const auto visit = [&]( size_type l, size_type difference ) {
+    const auto first  = size_type{m_length_starts[l]};
+    const auto last   = size_type{m_length_starts[l + 1]};
+    const auto blocks = (last - first + filter_block - 1) / filter_block;
+
+    // Block b of this length is block blocks_before + b overall, and
+    // belongs to the partition it is congruent to
+    const auto start = (part + parts - blocks_before % parts) % parts;
+    blocks_before += blocks;
+
+    for( auto b = start; b < blocks; b += parts ) {
+      // A metric may afford fewer edits to some lengths than to others
+      const auto bound = std::min( edits, m_metric.edit_bound( max, query, l ) );
+      if( bound < difference ) break;
+
+      // Every edit spent on the length difference is one that cannot also
+      // change two bits of the signature
+      const auto threshold = 2 * bound - difference;
+      const auto offset    = first + b * filter_block;
+      const auto count     = std::min( filter_block, last - offset );
+      const auto kept      = detail::filter_signatures( survivors, m_signatures.data() + offset,
+                                                        count, query_bits, threshold );
+
+      // A block that keeps enough survivors is scored all at once, if the
+      // metric has a batched kernel
+      if( kept >= detail::min_batch_candidates ) {
+        string_view_type candidates[filter_block];
+        size_type distances[filter_block];
+
+        for( auto k = size_type{0}; k < kept; ++k ) {
+          candidates[k] = arg( offset + survivors[k] );
+        }
+        if( detail::score_candidates( distances, m_metric, query, candidates, kept, max ) ) {
+          for( auto k = size_type{0}; k < kept; ++k ) {
+            report( candidates[k], distances[k] );
+          }
+          continue;
+        }
+      }
+
+      for( auto k = size_type{0}; k < kept; ++k ) {
+        const auto candidate = arg( offset + survivors[k] );
+        report( candidate, m_metric( query, candidate, max ) );
+      }
+    }
+  };
+
+  // The closest lengths are the likeliest to hold the closest arguments,
+  // and so to lower max soonest
+  for( auto difference = size_type{0}; difference <= edits; ++difference ) {
+    if( difference <= length && length - difference <= longest ) {
+      visit( length - difference, difference );
+    }
+    if( difference > 0 && length + difference <= longest ) {
+      visit( length + difference, difference );
+    }
+  }
+  return scored;
+}
+
+//----------------------------------------------------------------------------
+// Private Member Functions
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits, typename Metric>
+inline void
+  bit::tools::basic_letter_set_index<CharT,Traits,Metric>
+  ::build( const std::vector<CharT>& text,
+           const std::vector<std::uint32_t>& offsets )
+{
+  const auto count  = offsets.size() - 1;
+  const auto length = [&]( std::uint32_t index ) {
+    return offsets[index + 1] - offsets[index];
+  };
+
+  // Sorting by length lets a search skip every length out of reach; within
+  // a length, equal signatures are kept together
+  auto signatures = std::vector<std::uint64_t>( count );
+  auto order      = std::vector<std::uint32_t>( count );
+  auto longest    = std::size_t{0};
+  for( auto i = std::size_t{0}; i < count; ++i ) {
+    const auto index = static_cast<std::uint32_t>(i);
+
+    signatures[i] = signature( string_view_type{ text.data() + offsets[i], length( index ) } );
+    order[i]      = index;
+    longest       = std::max( longest, std::size_t{length( index )} );
+  }
+  std::sort( order.begin(), order.end(), [&]( std::uint32_t lhs, std::uint32_t rhs ) {
+    if( length( lhs ) != length( rhs ) ) {
+      return length( lhs ) < length( rhs );
+    }
+    return signatures[lhs] < signatures[rhs] ||
+           (signatures[lhs] == signatures[rhs] && lhs < rhs);
+  });
+
+  m_signatures.reserve( count );
+  m_offsets.reserve( count + 1 );
+  m_arena.reserve( text.size() );
+  m_length_starts.assign( longest + 2, 0 );
+
+  for( auto index : order ) {
+    const auto first = text.begin() + offsets[index];
+    const auto last  = text.begin() + offsets[index + 1];
+
+    m_signatures.push_back( signatures[index] );
+    m_offsets.push_back( static_cast<std::uint32_t>(m_arena.size()) );
+    m_arena.insert( m_arena.end(), first, last );
+    ++m_length_starts[length( index ) + 1];
+  }
+  m_offsets.push_back( static_cast<std::uint32_t>(m_arena.size()) );
+
+  // Turn the count of each length into the start of the next length
+  for( auto l = std::size_t{1}; l < m_length_starts.size(); ++l ) {
+    m_length_starts[l] += m_length_starts[l - 1];
+  }
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits, typename Metric>
+inline typename bit::tools::basic_letter_set_index<CharT,Traits,Metric>::string_view_type
+  bit::tools::basic_letter_set_index<CharT,Traits,Metric>::arg( size_type index )
+  const noexcept
+{
+  const auto first = m_offsets[index];
+  const auto last  = m_offsets[index + 1];
+
+  return string_view_type{ m_arena.data() + first, last - first };
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits, typename Metric>
+inline std::uint64_t
+  bit::tools::basic_letter_set_index<CharT,Traits,Metric>::signature( string_view_type str )
+  noexcept
+{
+  auto result = std::uint64_t{0};
+
+  // Characters without a bit of their own are left out; an edit then
+  // changes fewer bits, which keeps the bound a lower bound
+  for( auto c : str ) {
+    auto position = 64u;
+    if( c >= CharT('a') && c <= CharT('z') ) {
+      position = static_cast<unsigned>(c - CharT('a'));
+    } else if( c >= CharT('A') && c <= CharT('Z') ) {
+      position = 26u + static_cast<unsigned>(c - CharT('A'));
+    } else if( c >= CharT('0') && c <= CharT('9') ) {
+      position = 52u + static_cast<unsigned>(c - CharT('0'));
+    } else if( c == CharT('-') ) {
+      position = 62u;
+    } else if( c == CharT('_') ) {
+      position = 63u;
+    }
+    if( position < 64u ) {
+      result |= std::uint64_t{1} << position;
+    }
+  }
+  return result;
+}
+
+#endif /* BIT_TOOLS_ARGS_DETAIL_LETTER_SET_INDEX_INL */
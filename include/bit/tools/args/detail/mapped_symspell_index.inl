@@ -0,0 +1,47 @@
+#ifndef BIT_TOOLS_ARGS_DETAIL_MAPPED_SYMSPELL_INDEX_INL
+#define BIT_TOOLS_ARGS_DETAIL_MAPPED_SYMSPELL_INDEX_INL
+
+//============================================================================
+// mapped_symspell_index
+//============================================================================
+
+//----------------------------------------------------------------------------
+// Capacity
+//----------------------------------------------------------------------------
+
+inline bit::tools::mapped_symspell_index::size_type
+  bit::tools::mapped_symspell_index::size()
+  const noexcept
+{
+  return m_view.size();
+}
+
+inline bit::tools::mapped_symspell_index::size_type
+  bit::tools::mapped_symspell_index::file_size()
+  const noexcept
+{
+  return m_size;
+}
+
+//----------------------------------------------------------------------------
+// Search
+//----------------------------------------------------------------------------
+
+template<typename Visitor>
+inline bit::tools::mapped_symspell_index::size_type
+  bit::tools::mapped_symspell_index::search( stl::string_view query,
+                                             size_type max,
+                                             Visitor&& visitor )
+  const
+{
+  return m_view.search( query, max, std::forward<Visitor>(visitor) );
+}
+
+inline const bit::tools::symspell_view&
+  bit::tools::mapped_symspell_index::view()
+  const noexcept
+{
+  return m_view;
+}
+
+#endif /* BIT_TOOLS_ARGS_DETAIL_MAPPED_SYMSPELL_INDEX_INL */
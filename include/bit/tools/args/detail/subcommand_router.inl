@@ -0,0 +1,224 @@
+#ifndef BIT_TOOLS_ARGS_DETAIL_SUBCOMMAND_ROUTER_INL
+#define BIT_TOOLS_ARGS_DETAIL_SUBCOMMAND_ROUTER_INL
+
+//============================================================================
+// basic_subcommand_router
+//============================================================================
+
+//----------------------------------------------------------------------------
+// Constructor
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline bit::tools::basic_subcommand_router<CharT,Traits>
+  ::basic_subcommand_router()
+  noexcept
+  : m_entries(),
+    m_slots()
+{
+
+}
+
+//----------------------------------------------------------------------------
+// Modifiers
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline bool bit::tools::basic_subcommand_router<CharT,Traits>
+  ::add( string_type name, handler_type handler )
+{
+  const auto hash = detail::fnv1a_hash( name );
+
+  if( find_entry( name, hash ) ) return false;
+
+  // Keep the load factor at or below 1/2 so that probe chains stay short
+  if( (m_entries.size() + 1) * 2 > m_slots.size() ) {
+    rehash( m_slots.empty() ? 16 : m_slots.size() * 2 );
+  }
+
+  m_entries.push_back( entry{ hash, name, handler } );
+
+  const auto mask = m_slots.size() - 1;
+  auto i = static_cast<size_type>(hash) & mask;
+  while( m_slots[i] ) {
+    i = (i + 1) & mask;
+  }
+  m_slots[i] = static_cast<slot_type>(m_entries.size());
+
+  return true;
+}
+
+template<typename CharT, typename Traits>
+template<typename Command>
+inline bool bit::tools::basic_subcommand_router<CharT,Traits>
+  ::add( string_type name )
+{
+  return add( name, &invoke_command<Command> );
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline void bit::tools::basic_subcommand_router<CharT,Traits>
+  ::reserve( size_type n )
+{
+  m_entries.reserve( n );
+
+  auto slots = size_type{16};
+  while( slots < n * 2 ) {
+    slots *= 2;
+  }
+  if( slots > m_slots.size() ) {
+    rehash( slots );
+  }
+}
+
+//----------------------------------------------------------------------------
+// Observers
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline bool bit::tools::basic_subcommand_router<CharT,Traits>::empty()
+  const noexcept
+{
+  return m_entries.empty();
+}
+
+template<typename CharT, typename Traits>
+inline typename bit::tools::basic_subcommand_router<CharT,Traits>::size_type
+  bit::tools::basic_subcommand_router<CharT,Traits>::size()
+  const noexcept
+{
+  return m_entries.size();
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline typename bit::tools::basic_subcommand_router<CharT,Traits>::handler_type
+  bit::tools::basic_subcommand_router<CharT,Traits>::find( string_type name )
+  const noexcept
+{
+  const auto e = find_entry( name, detail::fnv1a_hash( name ) );
+
+  return e ? e->handler : nullptr;
+}
+
+//----------------------------------------------------------------------------
+// Dispatch
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline bool bit::tools::basic_subcommand_router<CharT,Traits>
+  ::dispatch( vector_type args, int* status )
+  const
+{
+  const auto dash = CharT('-');
+
+  auto i = size_type{0};
+  while( i < args.size() && args[i].size() > 1 && args[i][0] == dash ) {
+    ++i;
+  }
+  if( i == args.size() ) return false;
+
+  const auto handler = find( args[i] );
+
+  if( !handler ) return false;
+
+  invoke( handler, args.subvec(i + 1), status );
+  return true;
+}
+
+template<typename CharT, typename Traits>
+inline bool bit::tools::basic_subcommand_router<CharT,Traits>
+  ::dispatch( set_type* global, vector_type args, int* status )
+  const
+{
+  auto i = size_type{0};
+  auto handler = handler_type{nullptr};
+  for( ; i < args.size(); ++i ) {
+    if( (handler = find( args[i] )) ) break;
+  }
+
+  if( global ) {
+    parse_arguments( global, args.subvec(0, i) );
+  }
+
+  if( !handler ) return false;
+
+  invoke( handler, args.subvec(i + 1), status );
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Private Member Functions
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline void bit::tools::basic_subcommand_router<CharT,Traits>
+  ::rehash( size_type slots )
+{
+  m_slots.assign( slots, slot_type{0} );
+
+  const auto mask = slots - 1;
+  for( auto e = size_type{0}; e < m_entries.size(); ++e ) {
+    auto i = static_cast<size_type>(m_entries[e].hash) & mask;
+    while( m_slots[i] ) {
+      i = (i + 1) & mask;
+    }
+    m_slots[i] = static_cast<slot_type>(e + 1);
+  }
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline const typename bit::tools::basic_subcommand_router<CharT,Traits>::entry*
+  bit::tools::basic_subcommand_router<CharT,Traits>
+  ::find_entry( string_type name, std::uint64_t hash )
+  const noexcept
+{
+  if( m_slots.empty() ) return nullptr;
+
+  const auto mask = m_slots.size() - 1;
+  auto i = static_cast<size_type>(hash) & mask;
+
+  while( m_slots[i] ) {
+    const auto& e = m_entries[m_slots[i] - 1];
+
+    // Only compare the strings on a full hash match
+    if( e.hash == hash && e.name == name ) {
+      return &e;
+    }
+    i = (i + 1) & mask;
+  }
+  return nullptr;
+}
+
+//----------------------------------------------------------------------------
+
+template<typename CharT, typename Traits>
+inline void bit::tools::basic_subcommand_router<CharT,Traits>
+  ::invoke( handler_type handler, vector_type args, int* status )
+{
+  const auto result = handler( args );
+  if( status ) {
+    *status = result;
+  }
+}
+
+template<typename CharT, typename Traits>
+template<typename Command>
+inline int bit::tools::basic_subcommand_router<CharT,Traits>
+  ::invoke_command( vector_type args )
+{
+  // The command, and thus its argument set, only exists for the duration
+  // of the dispatch
+  Command command;
+
+  parse_arguments( &command.args(), args );
+
+  return command.run();
+}
+
+#endif /* BIT_TOOLS_ARGS_DETAIL_SUBCOMMAND_ROUTER_INL */
@@ -0,0 +1,308 @@
+#ifndef BIT_TOOLS_ARGS_DETAIL_SUGGESTION_CACHE_INL
+#define BIT_TOOLS_ARGS_DETAIL_SUGGESTION_CACHE_INL
+
+//============================================================================
+// suggestion_cache_statistics
+//============================================================================
+
+inline double bit::tools::suggestion_cache_statistics::hit_ratio()
+  const noexcept
+{
+  const auto total = hits + misses;
+
+  return total ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+}
+
+//============================================================================
+// suggestion_cache
+//============================================================================
+
+template<typename Suggestor>
+constexpr typename bit::tools::suggestion_cache<Suggestor>::size_type
+  bit::tools::suggestion_cache<Suggestor>::max_query_length;
+
+template<typename Suggestor>
+constexpr typename bit::tools::suggestion_cache<Suggestor>::size_type
+  bit::tools::suggestion_cache<Suggestor>::max_suggestions;
+
+template<typename Suggestor>
+constexpr typename bit::tools::suggestion_cache<Suggestor>::size_type
+  bit::tools::suggestion_cache<Suggestor>::default_shards;
+
+//----------------------------------------------------------------------------
+// Constructor
+//----------------------------------------------------------------------------
+
+template<typename Suggestor>
+inline bit::tools::suggestion_cache<Suggestor>
+  ::suggestion_cache( const suggestor_type& suggestor,
+                      size_type capacity,
+                      size_type shards )
+  : m_suggestor(&suggestor),
+    m_shards(),
+    m_shard_count(1),
+    m_capacity(0)
+{
+  while( m_shard_count < shards ) m_shard_count *= 2;
+
+  const auto per_shard = (capacity + m_shard_count - 1) / m_shard_count;
+
+  // The table is kept at most half full, so probes stay short
+  auto table_size = size_type{1};
+  while( table_size < 2 * per_shard ) table_size *= 2;
+
+  m_shards.reset( new shard[m_shard_count] );
+  for( auto i = size_type{0}; i < m_shard_count; ++i ) {
+    auto& s = m_shards[i];
+
+    s.entries.resize( per_shard );
+    s.table.assign( table_size, 0 );
+    s.used = 0;
+    s.hand = 0;
+    s.hits.store( 0 );
+    s.misses.store( 0 );
+    s.bypasses.store( 0 );
+    s.evictions.store( 0 );
+    s.hit_ns.store( 0 );
+    s.miss_ns.store( 0 );
+  }
+  m_capacity = per_shard * m_shard_count;
+}
+
+//----------------------------------------------------------------------------
+// Capacity
+//----------------------------------------------------------------------------
+
+template<typename Suggestor>
+inline typename bit::tools::suggestion_cache<Suggestor>::size_type
+  bit::tools::suggestion_cache<Suggestor>::capacity()
+  const noexcept
+{
+  return m_capacity;
+}
+
+//----------------------------------------------------------------------------
+// Observers
+//----------------------------------------------------------------------------
+
+template<typename Suggestor>
+inline const typename bit::tools::suggestion_cache<Suggestor>::suggestor_type&
+  bit::tools::suggestion_cache<Suggestor>::suggestor()
+  const noexcept
+{
+  return *m_suggestor;
+}
+
+template<typename Suggestor>
+inline bit::tools::suggestion_cache_statistics
+  bit::tools::suggestion_cache<Suggestor>::statistics()
+  const noexcept
+{
+  auto result = suggestion_cache_statistics{ 0, 0, 0, 0, {}, {} };
+  auto hit_ns  = std::uint64_t{0};
+  auto miss_ns = std::uint64_t{0};
+
+  for( auto i = size_type{0}; i < m_shard_count; ++i ) {
+    const auto& s = m_shards[i];
+
+    result.hits      += s.hits.load( std::memory_order_relaxed );
+    result.misses    += s.misses.load( std::memory_order_relaxed );
+    result.bypasses  += s.bypasses.load( std::memory_order_relaxed );
+    result.evictions += s.evictions.load( std::memory_order_relaxed );
+    hit_ns  += s.hit_ns.load( std::memory_order_relaxed );
+    miss_ns += s.miss_ns.load( std::memory_order_relaxed );
+  }
+  result.hit_time  = std::chrono::nanoseconds( hit_ns );
+  result.miss_time = std::chrono::nanoseconds( miss_ns );
+  return result;
+}
+
+//----------------------------------------------------------------------------
+// Suggestions
+//----------------------------------------------------------------------------
+
+template<typename Suggestor>
+inline typename bit::tools::suggestion_cache<Suggestor>::string_view_type
+  bit::tools::suggestion_cache<Suggestor>::suggest( string_view_type input )
+{
+  // Reused by every call on this thread, so that a miss does not allocate
+  // once it has grown to fit
+  thread_local auto result = std::vector<string_view_type>{};
+
+  lookup( &result, input, false );
+  return result.empty() ? string_view_type{} : result.front();
+}
+
+template<typename Suggestor>
+inline void
+  bit::tools::suggestion_cache<Suggestor>
+  ::suggestions( std::vector<string_view_type>* result, string_view_type input )
+{
+  lookup( result, input, true );
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Suggestor>
+inline void bit::tools::suggestion_cache<Suggestor>::clear()
+  noexcept
+{
+  for( auto i = size_type{0}; i < m_shard_count; ++i ) {
+    auto& s = m_shards[i];
+    std::lock_guard<std::mutex> lock( s.mutex );
+
+    std::fill( s.table.begin(), s.table.end(), 0u );
+    s.used = 0;
+    s.hand = 0;
+  }
+}
+
+//----------------------------------------------------------------------------
+// Private Member Functions
+//----------------------------------------------------------------------------
+
+template<typename Suggestor>
+inline void
+  bit::tools::suggestion_cache<Suggestor>
+  ::lookup( std::vector<string_view_type>* result,
+            string_view_type input,
+            bool complete )
+{
+  const auto start = clock::now();
+  const auto elapsed = [&]{
+    return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count()
+    );
+  };
+
+  const auto h = detail::fnv1a_hash( input );
+  auto& s = m_shards[static_cast<size_type>(h >> 32) & (m_shard_count - 1)];
+
+  if( input.size() > max_query_length || s.entries.empty() ) {
+    m_suggestor->suggestions( result, input );
+    s.bypasses.fetch_add( 1, std::memory_order_relaxed );
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock( s.mutex );
+    const auto e = find( s, h, input );
+
+    // An entry that lost some suggestions still knows the closest
+    if( e && (e->complete || !complete) ) {
+      e->referenced = true;
+      result->assign( e->suggestions, e->suggestions + e->count );
+
+      s.hits.fetch_add( 1, std::memory_order_relaxed );
+      s.hit_ns.fetch_add( elapsed(), std::memory_order_relaxed );
+      return;
+    }
+  }
+
+  m_suggestor->suggestions( result, input );
+  {
+    std::lock_guard<std::mutex> lock( s.mutex );
+
+    // Another thread may have inserted the same query in the meantime
+    if( !find( s, h, input ) ) {
+      insert( s, h, input, *result );
+    }
+  }
+  s.misses.fetch_add( 1, std::memory_order_relaxed );
+  s.miss_ns.fetch_add( elapsed(), std::memory_order_relaxed );
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Suggestor>
+inline typename bit::tools::suggestion_cache<Suggestor>::entry*
+  bit::tools::suggestion_cache<Suggestor>
+  ::find( shard& s, std::uint64_t hash, string_view_type input )
+  const noexcept
+{
+  const auto mask = s.table.size() - 1;
+
+  for( auto i = static_cast<size_type>(hash) & mask; s.table[i] != 0; i = (i + 1) & mask ) {
+    auto& e = s.entries[s.table[i] - 1];
+    if( e.hash == hash && string_view_type{ e.query, e.length } == input ) {
+      return &e;
+    }
+  }
+  return nullptr;
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Suggestor>
+inline void
+  bit::tools::suggestion_cache<Suggestor>
+  ::insert( shard& s,
+            std::uint64_t hash,
+            string_view_type input,
+            const std::vector<string_view_type>& suggestions )
+  noexcept
+{
+  auto index = std::uint32_t{0};
+
+  if( s.used < s.entries.size() ) {
+    index = static_cast<std::uint32_t>(s.used++);
+  } else {
+    // Entries hit since the hand last passed are spared once
+    while( s.entries[s.hand].referenced ) {
+      s.entries[s.hand].referenced = false;
+      s.hand = (s.hand + 1) % s.entries.size();
+    }
+    index  = static_cast<std::uint32_t>(s.hand);
+    s.hand = (s.hand + 1) % s.entries.size();
+
+    erase( s, index );
+    s.evictions.fetch_add( 1, std::memory_order_relaxed );
+  }
+
+  auto& e = s.entries[index];
+  e.hash       = hash;
+  e.length     = static_cast<std::uint32_t>(input.size());
+  e.count      = static_cast<std::uint32_t>(std::min( suggestions.size(), max_suggestions ));
+  e.complete   = suggestions.size() <= max_suggestions;
+  e.referenced = false;
+  std::copy( input.begin(), input.end(), e.query );
+  std::copy( suggestions.begin(), suggestions.begin() + e.count, e.suggestions );
+
+  const auto mask = s.table.size() - 1;
+  auto i = static_cast<size_type>(hash) & mask;
+  while( s.table[i] != 0 ) i = (i + 1) & mask;
+  s.table[i] = index + 1;
+}
+
+//----------------------------------------------------------------------------
+
+template<typename Suggestor>
+inline void
+  bit::tools::suggestion_cache<Suggestor>::erase( shard& s, std::uint32_t index )
+  noexcept
+{
+  const auto mask = s.table.size() - 1;
+
+  auto i = static_cast<size_type>(s.entries[index].hash) & mask;
+  while( s.table[i] != index + 1 ) i = (i + 1) & mask;
+
+  // Each later entry of the probe sequence moves into the hole, unless
+  // its home lies cyclically after the hole, where it would be unreachable
+  auto j = i;
+  while( true ) {
+    s.table[i] = 0;
+    while( true ) {
+      j = (j + 1) & mask;
+      if( s.table[j] == 0 ) return;
+
+      const auto home = static_cast<size_type>(s.entries[s.table[j] - 1].hash) & mask;
+      const auto stays = (i <= j) ? (i < home && home <= j)
+                                  : (i < home || home <= j);
+      if( !stays ) break;
+    }
+    s.table[i] = s.table[j];
+    i = j;
+  }
+}
+
+#endif /* BIT_TOOLS_ARGS_DETAIL_SUGGESTION_CACHE_INL */
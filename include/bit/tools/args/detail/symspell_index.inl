@@ -0,0 +1,165 @@
+#ifndef BIT_TOOLS_ARGS_DETAIL_SYMSPELL_INDEX_INL
+#define BIT_TOOLS_ARGS_DETAIL_SYMSPELL_INDEX_INL
+
+//============================================================================
+// symspell_view
+//============================================================================
+
+//----------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------
+
+inline bit::tools::symspell_view::symspell_view()
+  noexcept
+  : symspell_view( metric_type{}, nullptr, nullptr, 0, nullptr, 0, nullptr )
+{
+
+}
+
+inline bit::tools::symspell_view
+  ::symspell_view( metric_type fn,
+                   const char* arena,
+                   const std::uint32_t* offsets,
+                   size_type count,
+                   const slot* slots,
+                   size_type slot_count,
+                   const std::uint32_t* postings )
+  noexcept
+  : m_distance_fn(fn),
+    m_arena(arena),
+    m_offsets(offsets),
+    m_count(count),
+    m_slots(slots),
+    m_slot_count(slot_count),
+    m_postings(postings)
+{
+
+}
+
+//----------------------------------------------------------------------------
+// Capacity
+//----------------------------------------------------------------------------
+
+inline bit::tools::symspell_view::size_type
+  bit::tools::symspell_view::size()
+  const noexcept
+{
+  return m_count;
+}
+
+//----------------------------------------------------------------------------
+// Search
+//----------------------------------------------------------------------------
+
+template<typename Visitor>
+inline bit::tools::symspell_view::size_type
+  bit::tools::symspell_view::search( stl::string_view query,
+                                     size_type max,
+                                     Visitor&& visitor )
+  const
+{
+  const auto score = [&]( size_type index ) {
+    const auto candidate = arg( index );
+    const auto distance  = m_distance_fn( query, candidate, max );
+
+    if( distance <= max ) {
+      visitor( candidate, distance );
+    }
+  };
+
+  if( max > max_edits ) {
+    for( auto i = size_type{0}; i < size(); ++i ) {
+      score( i );
+    }
+    return size();
+  }
+
+  auto candidates = std::vector<std::uint32_t>{};
+  find_candidates( query, max, &candidates );
+
+  for( auto index : candidates ) {
+    score( index );
+  }
+  return candidates.size();
+}
+
+//----------------------------------------------------------------------------
+// Private Member Functions
+//----------------------------------------------------------------------------
+
+inline bit::stl::string_view
+  bit::tools::symspell_view::arg( size_type index )
+  const noexcept
+{
+  const auto first = m_offsets[index];
+  const auto last  = m_offsets[index + 1];
+
+  return stl::string_view{ m_arena + first, last - first };
+}
+
+//============================================================================
+// symspell_index
+//============================================================================
+
+//----------------------------------------------------------------------------
+// Constructor
+//----------------------------------------------------------------------------
+
+template<typename InputIt>
+inline bit::tools::symspell_index
+  ::symspell_index( InputIt first, InputIt last, metric_type fn )
+  : m_distance_fn(fn),
+    m_arena(),
+    m_offsets(),
+    m_slots(),
+    m_postings()
+{
+  auto args = std::vector<std::string>{};
+  for( ; first != last; ++first ) {
+    args.emplace_back( *first );
+  }
+  build( args );
+}
+
+//----------------------------------------------------------------------------
+// Capacity
+//----------------------------------------------------------------------------
+
+inline bit::tools::symspell_index::size_type
+  bit::tools::symspell_index::size()
+  const noexcept
+{
+  return m_offsets.empty() ? 0 : m_offsets.size() - 1;
+}
+
+//----------------------------------------------------------------------------
+// Search
+//----------------------------------------------------------------------------
+
+template<typename Visitor>
+inline bit::tools::symspell_index::size_type
+  bit::tools::symspell_index::search( stl::string_view query,
+                                      size_type max,
+                                      Visitor&& visitor )
+  const
+{
+  return view().search( query, max, std::forward<Visitor>(visitor) );
+}
+
+//----------------------------------------------------------------------------
+
+inline bit::tools::symspell_view bit::tools::symspell_index::view()
+  const noexcept
+{
+  return symspell_view{
+    m_distance_fn,
+    m_arena.data(),
+    m_offsets.data(),
+    size(),
+    m_slots.data(),
+    m_slots.size(),
+    m_postings.data()
+  };
+}
+
+#endif /* BIT_TOOLS_ARGS_DETAIL_SYMSPELL_INDEX_INL */
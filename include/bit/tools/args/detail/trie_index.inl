@@ -0,0 +1,147 @@
+#ifndef BIT_TOOLS_ARGS_DETAIL_TRIE_INDEX_INL
+#define BIT_TOOLS_ARGS_DETAIL_TRIE_INDEX_INL
+
+//============================================================================
+// trie_index
+//============================================================================
+
+//----------------------------------------------------------------------------
+// Constructor
+//----------------------------------------------------------------------------
+
+template<typename InputIt>
+inline bit::tools::trie_index
+  ::trie_index( InputIt first, InputIt last, metric_type fn )
+  : m_distance_fn(fn),
+    m_nodes(),
+    m_args()
+{
+  auto args = std::vector<std::string>{};
+  for( ; first != last; ++first ) {
+    args.emplace_back( *first );
+  }
+  build( std::move(args) );
+}
+
+//----------------------------------------------------------------------------
+// Capacity
+//----------------------------------------------------------------------------
+
+inline bit::tools::trie_index::size_type
+  bit::tools::trie_index::size()
+  const noexcept
+{
+  return m_args.size();
+}
+
+inline bit::tools::trie_index::size_type
+  bit::tools::trie_index::node_count()
+  const noexcept
+{
+  return m_nodes.size();
+}
+
+//----------------------------------------------------------------------------
+// Search
+//----------------------------------------------------------------------------
+
+template<typename Visitor>
+inline bit::tools::trie_index::size_type
+  bit::tools::trie_index::search( stl::string_view query,
+                                  size_type max,
+                                  Visitor&& visitor )
+  const
+{
+  auto state = automaton( max );
+  for( auto c : query ) {
+    state.push_back( c );
+  }
+  return state.search( std::forward<Visitor>(visitor) );
+}
+
+inline bit::tools::levenshtein_automaton
+  bit::tools::trie_index::automaton( size_type max )
+  const
+{
+  return levenshtein_automaton{ *this, max };
+}
+
+//============================================================================
+// levenshtein_automaton
+//============================================================================
+
+//----------------------------------------------------------------------------
+// Observers
+//----------------------------------------------------------------------------
+
+inline bit::stl::string_view bit::tools::levenshtein_automaton::query()
+  const noexcept
+{
+  return m_query;
+}
+
+inline bit::tools::levenshtein_automaton::size_type
+  bit::tools::levenshtein_automaton::max_distance()
+  const noexcept
+{
+  return m_max;
+}
+
+inline bit::tools::levenshtein_automaton::size_type
+  bit::tools::levenshtein_automaton::active_count()
+  const noexcept
+{
+  return m_states.size() - m_levels.back();
+}
+
+//----------------------------------------------------------------------------
+// Modifiers
+//----------------------------------------------------------------------------
+
+inline void bit::tools::levenshtein_automaton::pop_back()
+  noexcept
+{
+  m_states.resize( m_levels.back() );
+  m_levels.pop_back();
+  m_query.pop_back();
+}
+
+inline void bit::tools::levenshtein_automaton::clear()
+  noexcept
+{
+  if( m_levels.size() > 1 ) {
+    m_states.resize( m_levels[1] );
+    m_levels.resize( 1 );
+  }
+  m_query.clear();
+}
+
+//----------------------------------------------------------------------------
+// Search
+//----------------------------------------------------------------------------
+
+template<typename Visitor>
+inline bit::tools::levenshtein_automaton::size_type
+  bit::tools::levenshtein_automaton::search( Visitor&& visitor )
+  const
+{
+  const auto& nodes = m_trie->m_nodes;
+  const auto query  = stl::string_view{ m_query };
+
+  auto scored = size_type{0};
+  for( auto i = m_levels.back(); i < m_states.size(); ++i ) {
+    const auto index = nodes[m_states[i].node].arg;
+    if( index == trie_index::no_arg ) continue;
+
+    const auto candidate = stl::string_view{ m_trie->m_args[index] };
+    const auto distance  = m_trie->m_distance_fn( query, candidate, m_max );
+    ++scored;
+
+    if( distance <= m_max ) {
+      visitor( candidate, distance );
+    }
+  }
+  return scored;
+}
+
+#endif /* BIT_TOOLS_ARGS_DETAIL_TRIE_INDEX_INL */
@@ -0,0 +1,106 @@
+#ifndef BIT_TOOLS_ARGS_DETAIL_TRIGRAM_INDEX_INL
+#define BIT_TOOLS_ARGS_DETAIL_TRIGRAM_INDEX_INL
+
+//============================================================================
+// trigram_index
+//============================================================================
+
+//----------------------------------------------------------------------------
+// Constructor
+//----------------------------------------------------------------------------
+
+template<typename InputIt>
+inline bit::tools::trigram_index
+  ::trigram_index( InputIt first, InputIt last, metric_type fn )
+  : m_distance_fn(fn),
+    m_arena(),
+    m_offsets(),
+    m_length_starts(),
+    m_grams(),
+    m_lists(),
+    m_blocks(),
+    m_deltas()
+{
+  auto args = std::vector<std::string>{};
+  for( ; first != last; ++first ) {
+    args.emplace_back( *first );
+  }
+  build( args );
+}
+
+//----------------------------------------------------------------------------
+// Capacity
+//----------------------------------------------------------------------------
+
+inline bit::tools::trigram_index::size_type
+  bit::tools::trigram_index::size()
+  const noexcept
+{
+  return m_offsets.empty() ? 0 : m_offsets.size() - 1;
+}
+
+//----------------------------------------------------------------------------
+// Search
+//----------------------------------------------------------------------------
+
+template<typename Visitor>
+inline bit::tools::trigram_index::size_type
+  bit::tools::trigram_index::search( stl::string_view query,
+                                     size_type max,
+                                     Visitor&& visitor )
+  const
+{
+  auto scored = size_type{0};
+
+  const auto score = [&]( size_type index ) {
+    const auto candidate = arg( index );
+    const auto distance  = m_distance_fn( query, candidate, max );
+    ++scored;
+
+    if( distance <= max ) {
+      visitor( candidate, distance );
+    }
+  };
+
+  if( size() == 0 ) return 0;
+
+  // Arguments are sorted by length, so those within max of the query's
+  // length are a single range
+  const auto length   = query.size();
+  const auto longest  = m_length_starts.size() - 2;
+  const auto shortest = (length > max) ? (length - max) : size_type{0};
+  if( shortest > longest ) return 0;
+
+  const auto first = m_length_starts[shortest];
+  const auto last  = m_length_starts[std::min( length + max, longest ) + 1];
+
+  auto candidates = std::vector<std::uint32_t>{};
+  if( find_candidates( query, max, first, last, &candidates ) ) {
+    for( auto index : candidates ) {
+      score( index );
+    }
+    return scored;
+  }
+
+  // Too few trigrams to filter by
+  for( auto i = first; i < last; ++i ) {
+    score( i );
+  }
+  return scored;
+}
+
+//----------------------------------------------------------------------------
+// Private Member Functions
+//----------------------------------------------------------------------------
+
+inline bit::stl::string_view
+  bit::tools::trigram_index::arg( size_type index )
+  const noexcept
+{
+  const auto first = m_offsets[index];
+  const auto last  = m_offsets[index + 1];
+
+  return stl::string_view{ m_arena.data() + first, last - first };
+}
+
+#endif /* BIT_TOOLS_ARGS_DETAIL_TRIGRAM_INDEX_INL */
@@ -0,0 +1,133 @@
+#ifndef BIT_TOOLS_ARGS_DETAIL_WEIGHTED_DISTANCE_INL
+#define BIT_TOOLS_ARGS_DETAIL_WEIGHTED_DISTANCE_INL
+
+//============================================================================
+// edit_cost_table
+//============================================================================
+
+//----------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------
+
+inline constexpr bit::tools::edit_cost_table::edit_cost_table( cost_type edit,
+                                                               cost_type transposition )
+  noexcept
+  : m_substitution{},
+    m_edit(edit),
+    m_transposition(transposition)
+{
+  for( auto i = 0; i < 256; ++i ) {
+    for( auto j = 0; j < 256; ++j ) {
+      m_substitution[i][j] = (i == j) ? cost_type{0} : edit;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// Modifiers
+//----------------------------------------------------------------------------
+
+inline constexpr void bit::tools::edit_cost_table::set_substitution( char lhs,
+                                                                     char rhs,
+                                                                     cost_type cost )
+  noexcept
+{
+  if( lhs == rhs ) return;
+
+  const auto l = static_cast<unsigned char>(lhs);
+  const auto r = static_cast<unsigned char>(rhs);
+
+  m_substitution[l][r] = cost;
+  m_substitution[r][l] = cost;
+}
+
+//----------------------------------------------------------------------------
+// Observers
+//----------------------------------------------------------------------------
+
+inline constexpr bit::tools::edit_cost_table::cost_type
+  bit::tools::edit_cost_table::substitution( char lhs, char rhs )
+  const noexcept
+{
+  return m_substitution[static_cast<unsigned char>(lhs)][static_cast<unsigned char>(rhs)];
+}
+
+inline constexpr bit::tools::edit_cost_table::cost_type
+  bit::tools::edit_cost_table::edit()
+  const noexcept
+{
+  return m_edit;
+}
+
+inline constexpr bit::tools::edit_cost_table::cost_type
+  bit::tools::edit_cost_table::transposition()
+  const noexcept
+{
+  return m_transposition;
+}
+
+//============================================================================
+// Cost Tables
+//============================================================================
+
+inline constexpr bit::tools::edit_cost_table
+  bit::tools::make_qwerty_cost_table( edit_cost_table::cost_type edit,
+                                      edit_cost_table::cost_type adjacent,
+                                      edit_cost_table::cost_type shift,
+                                      edit_cost_table::cost_type transposition )
+  noexcept
+{
+  // Each row is offset by part of a key from the one above, so the key in
+  // column j is below the keys in columns j and j+1 of the row above
+  const char* const lower[] = { "1234567890-=", "qwertyuiop[]\\", "asdfghjkl;'", "zxcvbnm,./" };
+  const char* const upper[] = { "!@#$%^&*()_+", "QWERTYUIOP{}|", "ASDFGHJKL:\"", "ZXCVBNM<>?" };
+  const auto rows = sizeof(lower) / sizeof(lower[0]);
+
+  const auto both = static_cast<edit_cost_table::cost_type>(
+    (adjacent + shift < edit) ? (adjacent + shift) : edit
+  );
+
+  auto table = edit_cost_table{ edit, transposition };
+
+  for( auto r = std::size_t{0}; r < rows; ++r ) {
+    auto below = std::size_t{0};
+    while( r + 1 < rows && lower[r + 1][below] != '\0' ) ++below;
+
+    for( auto j = std::size_t{0}; lower[r][j] != '\0'; ++j ) {
+      table.set_substitution( lower[r][j], upper[r][j], shift );
+
+      // The key to the right, the key below and to the left, and the key
+      // directly below
+      const std::size_t rs[]   = { r, r + 1, r + 1 };
+      const std::size_t ks[]   = { j + 1, j - 1, j };
+      const bool        keys[] = { lower[r][j + 1] != '\0', j > 0 && j - 1 < below, j < below };
+
+      for( auto n = 0; n < 3; ++n ) {
+        if( !keys[n] ) continue;
+
+        const auto l = lower[rs[n]][ks[n]];
+        const auto u = upper[rs[n]][ks[n]];
+        table.set_substitution( lower[r][j], l, adjacent );
+        table.set_substitution( upper[r][j], u, adjacent );
+        table.set_substitution( lower[r][j], u, both );
+        table.set_substitution( upper[r][j], l, both );
+      }
+    }
+  }
+  return table;
+}
+
+//============================================================================
+// Weighted distances
+//============================================================================
+
+template<const bit::tools::edit_cost_table& Costs>
+inline std::size_t bit::tools::weighted_distance( stl::string_view lhs,
+                                                  stl::string_view rhs,
+                                                  std::size_t max )
+  noexcept
+{
+  return weighted_distance( lhs, rhs, Costs, max );
+}
+
+#endif /* BIT_TOOLS_ARGS_DETAIL_WEIGHTED_DISTANCE_INL */
@@ -0,0 +1,902 @@
+#ifndef BIT_TOOLS_DISTANCE_METRIC_HPP
+#define BIT_TOOLS_DISTANCE_METRIC_HPP
+
+#include "edit_distance.hpp"
+
+#include <bit/stl/string_view.hpp>
+
+#include <algorithm> // std::min, std::max, std::fill
+#include <cmath>     // std::ceil
+#include <cstddef>   // std::size_t
+#include <limits>    // std::numeric_limits
+#include <string>    // std::char_traits
+#include <utility>   // std::swap
+
+namespace bit {
+  namespace tools {
+
+    //------------------------------------------------------------------------
+    // Distances
+    //------------------------------------------------------------------------
+
+    /// \brief Computes the levenshtein distance between \p lhs and \p rhs
+    ///
+    /// This uses Myers' bit-parallel algorithm, which takes O(n) word
+    /// operations when the shorter string is at most 64 characters. Longer
+    /// strings are processed in 64-character blocks. When the shorter string
+    /// exceeds 256 characters, the blocks are kept in per-thread storage that
+    /// is reused across calls, so that no call allocates once the storage fits
+    ///
+    /// \param lhs the first string
+    /// \param rhs the second string
+    /// \return the number of insertions, deletions, and substitutions
+    ///         required to turn \p lhs into \p rhs
+    std::size_t levenshtein_distance( stl::string_view lhs, stl::string_view rhs ) noexcept;
+
+    /// \brief Computes the levenshtein distance between \p lhs and \p rhs,
+    ///        giving up as soon as it is known to exceed \p max
+    ///
+    /// Strings whose lengths differ by more than \p max are rejected
+    /// without being scanned. Otherwise, long strings are restricted to the
+    /// diagonal band of width <tt>2 * max + 1</tt> (Ukkonen), and the
+    /// computation stops at the first row in which every cell exceeds
+    /// \p max.
+    ///
+    /// \param lhs the first string
+    /// \param rhs the second string
+    /// \param max the largest distance of interest
+    /// \return the distance, or \p max + 1 if the distance exceeds \p max
+    std::size_t levenshtein_distance( stl::string_view lhs,
+                                      stl::string_view rhs,
+                                      std::size_t max ) noexcept;
+
+    /// \brief Computes the damerau-levenshtein distance between \p lhs and
+    ///        \p rhs, where a transposition of two adjacent characters
+    ///        counts as a single edit
+    ///
+    /// This is the restricted (optimal string alignment) distance, in which
+    /// no substring is edited more than once. This uses Hyyrö's bit-parallel
+    /// algorithm when the shorter string is at most 64 characters, and a
+    /// scalar dynamic-programming fallback otherwise.
+    ///
+    /// \param lhs the first string
+    /// \param rhs the second string
+    /// \return the number of insertions, deletions, substitutions, and
+    ///         transpositions required to turn \p lhs into \p rhs
+    std::size_t damerau_levenshtein_distance( stl::string_view lhs, stl::string_view rhs ) noexcept;
+
+    /// \brief Computes the damerau-levenshtein distance between \p lhs and
+    ///        \p rhs, giving up as soon as it is known to exceed \p max
+    ///
+    /// \param lhs the first string
+    /// \param rhs the second string
+    /// \param max the largest distance of interest
+    /// \return the distance, or \p max + 1 if the distance exceeds \p max
+    std::size_t damerau_levenshtein_distance( stl::string_view lhs,
+                                              stl::string_view rhs,
+                                              std::size_t max ) noexcept;
+
+    /// \brief Computes the levenshtein distance between the UTF-8 strings
+    ///        \p lhs and \p rhs, counting code points rather than bytes
+    ///
+    /// A typo in an accented letter is then a single edit, rather than two.
+    /// Strings that are both ASCII, as detected with SIMD, are passed
+    /// straight to the byte kernels; others are decoded into per-thread
+    /// storage and compared by code point. Invalid bytes are compared as
+    /// characters of their own.
+    ///
+    /// \note letter_set_index groups arguments by their length in bytes, so
+    ///       through a distance_function, which bounds a search by edits of
+    ///       a byte, it misses an argument that is an edit away but several
+    ///       bytes longer or shorter, such as one missing a CJK character.
+    ///       Search with utf8_levenshtein_metric instead, which bounds the
+    ///       search by the bytes that edits of a code point may change.
+    ///
+    /// \param lhs the first string
+    /// \param rhs the second string
+    /// \return the number of insertions, deletions, and substitutions of
+    ///         code points required to turn \p lhs into \p rhs
+    std::size_t utf8_levenshtein_distance( stl::string_view lhs, stl::string_view rhs ) noexcept;
+
+    /// \brief Computes the levenshtein distance between the UTF-8 strings
+    ///        \p lhs and \p rhs by code point, giving up as soon as it is
+    ///        known to exceed \p max
+    ///
+    /// \param lhs the first string
+    /// \param rhs the second string
+    /// \param max the largest distance of interest
+    /// \return the distance, or \p max + 1 if the distance exceeds \p max
+    std::size_t utf8_levenshtein_distance( stl::string_view lhs,
+                                           stl::string_view rhs,
+                                           std::size_t max ) noexcept;
+
+    /// \brief Computes the damerau-levenshtein distance between the UTF-8
+    ///        strings \p lhs and \p rhs, counting code points rather than
+    ///        bytes
+    ///
+    /// \param lhs the first string
+    /// \param rhs the second string
+    /// \return the number of insertions, deletions, substitutions, and
+    ///         transpositions of code points required to turn \p lhs into
+    ///         \p rhs
+    std::size_t utf8_damerau_levenshtein_distance( stl::string_view lhs, stl::string_view rhs ) noexcept;
+
+    /// \brief Computes the damerau-levenshtein distance between the UTF-8
+    ///        strings \p lhs and \p rhs by code point, giving up as soon as
+    ///        it is known to exceed \p max
+    ///
+    /// \param lhs the first string
+    /// \param rhs the second string
+    /// \param max the largest distance of interest
+    /// \return the distance, or \p max + 1 if the distance exceeds \p max
+    std::size_t utf8_damerau_levenshtein_distance( stl::string_view lhs,
+                                                   stl::string_view rhs,
+                                                   std::size_t max ) noexcept;
+
+    /// \brief Computes the levenshtein distance between \p lhs and \p rhs, of
+    ///        any character type
+    ///
+    /// The kernels are instantiated for each character type. Patterns of at
+    /// most 64 characters use Myers' algorithm, with match vectors looked
+    /// up in a table indexed by character when every character of the
+    /// pattern is below 256, and in a small hashed table otherwise, as is
+    /// needed for \c char32_t. Longer patterns use the diagonal band.
+    /// Strings of \c char use the non-template overloads instead.
+    ///
+    /// \param lhs the first string
+    /// \param rhs the second string
+    /// \return the number of insertions, deletions, and substitutions
+    ///         required to turn \p lhs into \p rhs
+    template<typename CharT, typename Traits>
+    std::size_t levenshtein_distance( stl::basic_string_view<CharT,Traits> lhs,
+                                      stl::basic_string_view<CharT,Traits> rhs ) noexcept;
+
+    /// \brief Computes the levenshtein distance between \p lhs and \p rhs,
+    ///        of any character type, giving up as soon as it is known to
+    ///        exceed \p max
+    ///
+    /// \param lhs the first string
+    /// \param rhs the second string
+    /// \param max the largest distance of interest
+    /// \return the distance, or \p max + 1 if the distance exceeds \p max
+    template<typename CharT, typename Traits>
+    std::size_t levenshtein_distance( stl::basic_string_view<CharT,Traits> lhs,
+                                      stl::basic_string_view<CharT,Traits> rhs,
+                                      std::size_t max ) noexcept;
+
+    /// \brief Computes the damerau-levenshtein distance between \p lhs and
+    ///        \p rhs, of any character type
+    ///
+    /// \param lhs the first string
+    /// \param rhs the second string
+    /// \return the number of insertions, deletions, substitutions, and
+    ///         transpositions required to turn \p lhs into \p rhs
+    template<typename CharT, typename Traits>
+    std::size_t damerau_levenshtein_distance( stl::basic_string_view<CharT,Traits> lhs,
+                                              stl::basic_string_view<CharT,Traits> rhs ) noexcept;
+
+    /// \brief Computes the damerau-levenshtein distance between \p lhs and
+    ///        \p rhs, of any character type, giving up as soon as it is
+    ///        known to exceed \p max
+    ///
+    /// \param lhs the first string
+    /// \param rhs the second string
+    /// \param max the largest distance of interest
+    /// \return the distance, or \p max + 1 if the distance exceeds \p max
+    template<typename CharT, typename Traits>
+    std::size_t damerau_levenshtein_distance( stl::basic_string_view<CharT,Traits> lhs,
+                                              stl::basic_string_view<CharT,Traits> rhs,
+                                              std::size_t max ) noexcept;
+
+    /// \brief Computes the levenshtein distance from \p query to each of the
+    ///        \p count \p candidates, storing them in \p distances
+    ///
+    /// Candidates are scored in batches of 8, with the bit-parallel
+    /// recurrence evaluated for every candidate of a batch at once. The
+    /// widest vector kernel supported by the host (AVX2, SSE2, or scalar)
+    /// is selected at runtime. Queries longer than 64 characters are scored
+    /// one candidate at a time.
+    ///
+    /// \param distances the output array of at least \p count distances
+    /// \param query the string to compare against
+    /// \param candidates the strings to compare to \p query
+    /// \param count the number of candidates
+    void levenshtein_distances( std::size_t* distances,
+                                stl::string_view query,
+                                const stl::string_view* candidates,
+                                std::size_t count ) noexcept;
+
+    /// \brief Computes the levenshtein distance from \p query to each of the
+    ///        \p count \p candidates, giving up on each as soon as it is
+    ///        known to exceed \p max
+    ///
+    /// Candidates more than \p max characters longer or shorter than
+    /// \p query are left out of their batch, and a batch stops as soon as
+    /// none of its candidates can still come within \p max.
+    ///
+    /// \param distances the output array of at least \p count distances,
+    ///        each \p max + 1 if the distance exceeds \p max
+    /// \param query the string to compare against
+    /// \param candidates the strings to compare to \p query
+    /// \param count the number of candidates
+    /// \param max the largest distance of interest
+    void levenshtein_distances( std::size_t* distances,
+                                stl::string_view query,
+                                const stl::string_view* candidates,
+                                std::size_t count,
+                                std::size_t max ) noexcept;
+
+    /// \deprecated Misspelled; use damerau_levenshtein_distance
+    [[deprecated("use damerau_levenshtein_distance")]]
+    std::size_t damerau_levenshtien_distance( stl::string_view lhs, stl::string_view rhs ) noexcept;
+
+
+    namespace detail {
+
+      /// \brief Removes the run of leading dashes that \p lhs and \p rhs
+      ///        share
+      ///
+      /// Every option is introduced by the same one or two dashes, which
+      /// would otherwise make any two short flags look alike to a metric
+      /// that rewards common characters or a common prefix.
+      ///
+      /// \param lhs the first string
+      /// \param rhs the second string
+      template<typename CharT, typename Traits>
+      void trim_dashes( stl::basic_string_view<CharT,Traits>& lhs,
+                        stl::basic_string_view<CharT,Traits>& rhs ) noexcept;
+
+      /// \brief Counts the characters that \p lhs and \p rhs share at the
+      ///        start, up to \p limit
+      ///
+      /// \param lhs the first string
+      /// \param rhs the second string
+      /// \param limit the largest count of interest
+      /// \return the length of the common prefix, or \p limit if it is longer
+      template<typename CharT, typename Traits>
+      std::size_t common_prefix( stl::basic_string_view<CharT,Traits> lhs,
+                                 stl::basic_string_view<CharT,Traits> rhs,
+                                 std::size_t limit ) noexcept;
+
+      /// \brief Counts the characters of \p text and \p pattern that match
+      ///        within the window of Jaro's similarity, and the transposed
+      ///        pairs among them, giving up once fewer than \p needed can
+      ///        still match
+      ///
+      /// Each character of \p text matches the first unmatched equal
+      /// character of \p pattern less than half the longer length away.
+      /// Patterns of at most 64 characters keep the matched positions in a
+      /// single word, and find each match with a mask of the match vector of
+      /// the character; longer patterns are scanned.
+      ///
+      /// \p pattern must be no longer than \p text.
+      ///
+      /// \param matches the number of matching characters
+      /// \param transpositions the number of matches out of order, halved
+      /// \param text the longer string
+      /// \param pattern the shorter string
+      /// \param needed the least number of matches of interest
+      /// \return \c true if at least \p needed characters match
+      template<typename CharT, typename Traits>
+      bool jaro_matches( std::size_t* matches,
+                         std::size_t* transpositions,
+                         stl::basic_string_view<CharT,Traits> text,
+                         stl::basic_string_view<CharT,Traits> pattern,
+                         std::size_t needed ) noexcept;
+
+    } // namespace detail
+
+    //------------------------------------------------------------------------
+    // Metrics
+    //------------------------------------------------------------------------
+
+    //////////////////////////////////////////////////////////////////////////
+    /// \brief The levenshtein distance, as a metric of an index
+    ///
+    /// A metric is a policy of an index, such as basic_letter_set_index,
+    /// that scores each candidate it finds. Unlike a distance function, it
+    /// is called directly, so its kernel is inlined into the search, and it
+    /// may hold parameters of its own. A metric provides:
+    ///
+    /// - <tt>operator()(lhs, rhs, max)</tt>, returning the distance, or
+    ///   \c max + 1 as soon as it is known to exceed \c max; and
+    /// - <tt>edit_bound(max, query)</tt>, returning the most insertions,
+    ///   deletions, substitutions and adjacent transpositions by which a
+    ///   string within \c max of \c query may differ from it, which is
+    ///   what an index prunes by; and
+    /// - <tt>edit_bound(max, query, length)</tt>, returning the same for
+    ///   only the strings of \c length characters; and
+    /// - a static \c default_max_distance, the largest distance worth
+    ///   suggesting on the scale of a default-constructed metric.
+    ///
+    /// \tparam CharT the character type
+    /// \tparam Traits the character traits
+    //////////////////////////////////////////////////////////////////////////
+    template<typename CharT, typename Traits = std::char_traits<CharT>>
+    class basic_levenshtein_metric
+    {
+      //----------------------------------------------------------------------
+      // Public Member Types
+      //----------------------------------------------------------------------
+    public:
+
+      using char_type        = CharT;
+      using traits_type      = Traits;
+      using size_type        = std::size_t;
+      using string_view_type = stl::basic_string_view<CharT,Traits>;
+
+      /// The largest distance worth suggesting; two typos
+      static constexpr size_type default_max_distance = 2;
+
+      //----------------------------------------------------------------------
+      // Distance
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Computes the levenshtein distance between \p lhs and
+      ///        \p rhs, giving up as soon as it is known to exceed \p max
+      ///
+      /// \param lhs the first string
+      /// \param rhs the second string
+      /// \param max the largest distance of interest
+      /// \return the distance, or \p max + 1 if the distance exceeds \p max
+      size_type operator()( string_view_type lhs,
+                            string_view_type rhs,
+                            size_type max ) const noexcept;
+
+      /// \brief Gets the most edits by which a string within \p max of
+      ///        \p query may differ from it
+      ///
+      /// \param max the largest distance of interest
+      /// \param query the query
+      /// \return \p max
+      size_type edit_bound( size_type max, string_view_type query ) const noexcept;
+
+      /// \brief Gets the most edits by which a string of \p length
+      ///        characters within \p max of \p query may differ from it
+      ///
+      /// \param max the largest distance of interest
+      /// \param query the query
+      /// \param length the length of the string
+      /// \return \p max
+      size_type edit_bound( size_type max,
+                            string_view_type query,
+                            size_type length ) const noexcept;
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// \brief The damerau-levenshtein distance, as a metric of an index
+    ///
+    /// \tparam CharT the character type
+    /// \tparam Traits the character traits
+    //////////////////////////////////////////////////////////////////////////
+    template<typename CharT, typename Traits = std::char_traits<CharT>>
+    class basic_damerau_levenshtein_metric
+    {
+      //----------------------------------------------------------------------
+      // Public Member Types
+      //----------------------------------------------------------------------
+    public:
+
+      using char_type        = CharT;
+      using traits_type      = Traits;
+      using size_type        = std::size_t;
+      using string_view_type = stl::basic_string_view<CharT,Traits>;
+
+      /// The largest distance worth suggesting; two typos
+      static constexpr size_type default_max_distance = 2;
+
+      //----------------------------------------------------------------------
+      // Distance
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Computes the damerau-levenshtein distance between \p lhs
+      ///        and \p rhs, giving up as soon as it is known to exceed \p max
+      ///
+      /// \param lhs the first string
+      /// \param rhs the second string
+      /// \param max the largest distance of interest
+      /// \return the distance, or \p max + 1 if the distance exceeds \p max
+      size_type operator()( string_view_type lhs,
+                            string_view_type rhs,
+                            size_type max ) const noexcept;
+
+      /// \brief Gets the most edits by which a string within \p max of
+      ///        \p query may differ from it
+      ///
+      /// \param max the largest distance of interest
+      /// \param query the query
+      /// \return \p max
+      size_type edit_bound( size_type max, string_view_type query ) const noexcept;
+
+      /// \brief Gets the most edits by which a string of \p length
+      ///        characters within \p max of \p query may differ from it
+      ///
+      /// \param max the largest distance of interest
+      /// \param query the query
+      /// \param length the length of the string
+      /// \return \p max
+      size_type edit_bound( size_type max,
+                            string_view_type query,
+                            size_type length ) const noexcept;
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// \brief The Jaro-Winkler similarity, as a metric of an index
+    ///
+    /// Jaro's similarity rewards the characters two strings share near the
+    /// same position, whatever lies between them, and Winkler's weights a
+    /// common prefix of up to 4 characters. A dropped or swapped letter in
+    /// a short flag then costs much less than in a short edit distance,
+    /// where it is a large part of the whole.
+    ///
+    /// The similarity \c s, from 0 to 1, is scored as the distance
+    /// <tt>(1 - s) * scale</tt>, rounded to the nearest integer; with the
+    /// default scale of 100, a max_distance of 15 suggests the arguments
+    /// that are at least 85% similar.
+    ///
+    /// This differs from the similarity as it is most often written in
+    /// three ways:
+    ///
+    /// - The leading dashes that both strings share are left out of the
+    ///   comparison, and of the common prefix, so that \c --verbose and
+    ///   \c --version are compared as \c verbose and \c version.
+    /// - Winkler's weight is only applied when Jaro's similarity exceeds
+    ///   0.7, as in Winkler's own definition, so that strings with little
+    ///   in common are not raised by a shared first letter.
+    /// - The number of transpositions is half the number of matched
+    ///   characters out of order, rounded down, as in Jaro's and
+    ///   Winkler's reference implementation, rather than exactly half.
+    ///
+    /// The bounded call works out the fewest matching characters that
+    /// could reach the similarity from the lengths and the common prefix,
+    /// rejects strings that are too different in length without reading
+    /// them, and stops matching as soon as too few characters are left.
+    ///
+    /// Jaro-Winkler is not a metric in the mathematical sense, so this must
+    /// not be used with bk_tree_index.
+    ///
+    /// \tparam CharT the character type
+    /// \tparam Traits the character traits
+    //////////////////////////////////////////////////////////////////////////
+    template<typename CharT, typename Traits = std::char_traits<CharT>>
+    class basic_jaro_winkler_metric
+    {
+      //----------------------------------------------------------------------
+      // Public Member Types
+      //----------------------------------------------------------------------
+    public:
+
+      using char_type        = CharT;
+      using traits_type      = Traits;
+      using size_type        = std::size_t;
+      using string_view_type = stl::basic_string_view<CharT,Traits>;
+
+      /// The longest common prefix that Winkler's weight rewards
+      static constexpr size_type prefix_limit = 4;
+
+      /// The largest distance worth suggesting at the default scale; a
+      /// similarity of at least 85%
+      static constexpr size_type default_max_distance = 15;
+
+      //----------------------------------------------------------------------
+      // Constructors
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs a Jaro-Winkler metric
+      ///
+      /// \param scale the distance of strings with nothing in common
+      /// \param prefix_scale the weight of each character of the common
+      ///        prefix; at most 0.25
+      explicit basic_jaro_winkler_metric( size_type scale = 100,
+                                          double prefix_scale = 0.1 ) noexcept;
+
+      //----------------------------------------------------------------------
+      // Distance
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Computes the Jaro-Winkler distance between \p lhs and
+      ///        \p rhs, giving up as soon as it is known to exceed \p max
+      ///
+      /// \param lhs the first string
+      /// \param rhs the second string
+      /// \param max the largest distance of interest
+      /// \return the distance, or \p max + 1 if the distance exceeds \p max
+      size_type operator()( string_view_type lhs,
+                            string_view_type rhs,
+                            size_type max ) const noexcept;
+
+      /// \brief Gets the most edits by which a string within \p max of
+      ///        \p query may differ from it
+      ///
+      /// The similarity bounds how much longer than the query a string may
+      /// be, and no string is more edits away than the longer of the two.
+      /// When the similarity is too low to bound the length, this is
+      /// unbounded.
+      ///
+      /// \param max the largest distance of interest
+      /// \param query the query
+      /// \return the number of edits
+      size_type edit_bound( size_type max, string_view_type query ) const noexcept;
+
+      /// \brief Gets the most edits by which a string of \p length
+      ///        characters within \p max of \p query may differ from it
+      ///
+      /// The similarity and the lengths bound the fewest characters that
+      /// match. A character that does not match may differ in the
+      /// signature of a letter_set_index, so this is the longer length
+      /// less the fewest matches, rather than a number of edits as such.
+      ///
+      /// \param max the largest distance of interest
+      /// \param query the query
+      /// \param length the length of the string
+      /// \return the number of edits, which is 0 if no string of \p length
+      ///         characters can be within \p max
+      size_type edit_bound( size_type max,
+                            string_view_type query,
+                            size_type length ) const noexcept;
+
+      //----------------------------------------------------------------------
+      // Observers
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Gets the similarity of \p lhs and \p rhs, from 0 to 1
+      ///
+      /// \param lhs the first string
+      /// \param rhs the second string
+      /// \return the similarity
+      double similarity( string_view_type lhs, string_view_type rhs ) const noexcept;
+
+      /// \brief Gets the distance of strings with nothing in common
+      ///
+      /// \return the scale
+      size_type scale() const noexcept;
+
+      //----------------------------------------------------------------------
+      // Private Members
+      //----------------------------------------------------------------------
+    private:
+
+      size_type m_scale;        ///< The distance of a similarity of 0
+      double    m_prefix_scale; ///< The weight of each prefix character
+
+      //----------------------------------------------------------------------
+      // Private Member Functions
+      //----------------------------------------------------------------------
+    private:
+
+      /// \brief Gets the least Jaro similarity, before Winkler's weight,
+      ///        of strings within \p max
+      ///
+      /// \param max the largest distance of interest
+      /// \return the least similarity
+      double least_jaro( size_type max ) const noexcept;
+
+      /// \brief Gets the similarity of \p lhs and \p rhs, if it is at least
+      ///        \p least
+      ///
+      /// \param lhs the first string
+      /// \param rhs the second string
+      /// \param least the least similarity of interest
+      /// \return the similarity, or a negative value if it is below \p least
+      double bounded_similarity( string_view_type lhs,
+                                 string_view_type rhs,
+                                 double least ) const noexcept;
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// \brief The levenshtein distance, with a common prefix breaking ties,
+    ///        as a metric of an index
+    ///
+    /// Each edit costs \c edit_cost, less one for each character of the
+    /// common prefix up to \c prefix_length, which is less than the cost of
+    /// an edit; so candidates are still ranked by their number of edits
+    /// first, and then by how much of their start was typed correctly.
+    /// Identical strings are at a distance of 0. The leading dashes that
+    /// both strings share are not counted in the prefix.
+    ///
+    /// With the defaults, a max_distance of <tt>4 * k</tt> suggests every
+    /// argument within \c k edits, those with the longest prefix first, and
+    /// a max_distance of <tt>4 * k + 1</tt> also those within
+    /// <tt>k + 1</tt> edits that have the first 3 characters right.
+    ///
+    /// \tparam CharT the character type
+    /// \tparam Traits the character traits
+    //////////////////////////////////////////////////////////////////////////
+    template<typename CharT, typename Traits = std::char_traits<CharT>>
+    class basic_prefix_weighted_metric
+    {
+      //----------------------------------------------------------------------
+      // Public Member Types
+      //----------------------------------------------------------------------
+    public:
+
+      using char_type        = CharT;
+      using traits_type      = Traits;
+      using size_type        = std::size_t;
+      using string_view_type = stl::basic_string_view<CharT,Traits>;
+
+      /// The largest distance worth suggesting with the default costs; two
+      /// edits, whatever the prefix
+      static constexpr size_type default_max_distance = 8;
+
+      //----------------------------------------------------------------------
+      // Constructors
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs a prefix-weighted metric
+      ///
+      /// \param edit_cost the cost of each edit
+      /// \param prefix_length the longest prefix rewarded; less than
+      ///        \p edit_cost
+      explicit basic_prefix_weighted_metric( size_type edit_cost = 4,
+                                             size_type prefix_length = 3 ) noexcept;
+
+      //----------------------------------------------------------------------
+      // Distance
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Computes the prefix-weighted distance between \p lhs and
+      ///        \p rhs, giving up as soon as it is known to exceed \p max
+      ///
+      /// The prefix is found first, which fixes how many edits \p max
+      /// affords, and the bounded levenshtein distance does the rest.
+      ///
+      /// \param lhs the first string
+      /// \param rhs the second string
+      /// \param max the largest distance of interest
+      /// \return the distance, or \p max + 1 if the distance exceeds \p max
+      size_type operator()( string_view_type lhs,
+                            string_view_type rhs,
+                            size_type max ) const noexcept;
+
+      /// \brief Gets the most edits by which a string within \p max of
+      ///        \p query may differ from it
+      ///
+      /// \param max the largest distance of interest
+      /// \param query the query
+      /// \return the number of edits
+      size_type edit_bound( size_type max, string_view_type query ) const noexcept;
+
+      /// \brief Gets the most edits by which a string of \p length
+      ///        characters within \p max of \p query may differ from it
+      ///
+      /// \param max the largest distance of interest
+      /// \param query the query
+      /// \param length the length of the string
+      /// \return the number of edits
+      size_type edit_bound( size_type max,
+                            string_view_type query,
+                            size_type length ) const noexcept;
+
+      //----------------------------------------------------------------------
+      // Private Members
+      //----------------------------------------------------------------------
+    private:
+
+      size_type m_edit_cost;     ///< The cost of each edit
+      size_type m_prefix_length; ///< The longest prefix rewarded
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// \brief A bounded distance function, as a metric of an index
+    ///
+    /// This calls the function through a pointer, as the indices that only
+    /// hold \c char do, and suits any function whose distance is never
+    /// smaller than the number of edits, such as keyboard_distance.
+    ///
+    /// \tparam CharT the character type
+    /// \tparam Traits the character traits
+    //////////////////////////////////////////////////////////////////////////
+    template<typename CharT, typename Traits = std::char_traits<CharT>>
+    class basic_distance_function
+    {
+      //----------------------------------------------------------------------
+      // Public Member Types
+      //----------------------------------------------------------------------
+    public:
+
+      using char_type        = CharT;
+      using traits_type      = Traits;
+      using size_type        = std::size_t;
+      using string_view_type = stl::basic_string_view<CharT,Traits>;
+      using distance_fn_type = std::size_t(*)(string_view_type,string_view_type,std::size_t);
+
+      /// The largest distance worth suggesting with levenshtein_distance;
+      /// two typos
+      static constexpr size_type default_max_distance = 2;
+
+      //----------------------------------------------------------------------
+      // Constructors
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs a metric that calls levenshtein_distance
+      basic_distance_function() noexcept;
+
+      /// \brief Constructs a metric that calls \p fn
+      ///
+      /// \param fn the bounded distance function
+      basic_distance_function( distance_fn_type fn ) noexcept;
+
+      //----------------------------------------------------------------------
+      // Distance
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Computes the distance between \p lhs and \p rhs, giving up
+      ///        as soon as it is known to exceed \p max
+      ///
+      /// \param lhs the first string
+      /// \param rhs the second string
+      /// \param max the largest distance of interest
+      /// \return the distance, or \p max + 1 if the distance exceeds \p max
+      size_type operator()( string_view_type lhs,
+                            string_view_type rhs,
+                            size_type max ) const;
+
+      /// \brief Gets the most edits by which a string within \p max of
+      ///        \p query may differ from it
+      ///
+      /// \param max the largest distance of interest
+      /// \param query the query
+      /// \return \p max
+      size_type edit_bound( size_type max, string_view_type query ) const noexcept;
+
+      /// \brief Gets the most edits by which a string of \p length
+      ///        characters within \p max of \p query may differ from it
+      ///
+      /// \param max the largest distance of interest
+      /// \param query the query
+      /// \param length the length of the string
+      /// \return \p max
+      size_type edit_bound( size_type max,
+                            string_view_type query,
+                            size_type length ) const noexcept;
+
+      //----------------------------------------------------------------------
+      // Private Members
+      //----------------------------------------------------------------------
+    private:
+
+      distance_fn_type m_fn; ///< The function used for computing distance
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// \brief The levenshtein distance between UTF-8 strings by code point,
+    ///        as a metric of an index
+    ///
+    /// An index such as basic_letter_set_index measures arguments in bytes,
+    /// and an edit of a code point changes up to 4 of them; so the edit
+    /// bounds of this metric count bytes, and a query missing a single CJK
+    /// character still reaches the argument that has it.
+    //////////////////////////////////////////////////////////////////////////
+    class utf8_levenshtein_metric
+    {
+      //----------------------------------------------------------------------
+      // Public Member Types
+      //----------------------------------------------------------------------
+    public:
+
+      using char_type        = char;
+      using traits_type      = std::char_traits<char>;
+      using size_type        = std::size_t;
+      using string_view_type = stl::string_view;
+
+      /// The largest distance worth suggesting; two typos
+      static constexpr size_type default_max_distance = 2;
+
+      //----------------------------------------------------------------------
+      // Distance
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Computes the levenshtein distance between \p lhs and \p rhs
+      ///        by code point, giving up as soon as it is known to exceed
+      ///        \p max
+      ///
+      /// \param lhs the first string
+      /// \param rhs the second string
+      /// \param max the largest distance of interest
+      /// \return the distance, or \p max + 1 if the distance exceeds \p max
+      size_type operator()( string_view_type lhs,
+                            string_view_type rhs,
+                            size_type max ) const noexcept;
+
+      /// \brief Gets the most byte edits by which a string within \p max
+      ///        code point edits of \p query may differ from it
+      ///
+      /// \param max the largest distance of interest
+      /// \param query the query
+      /// \return <tt>4 * max</tt>
+      size_type edit_bound( size_type max, string_view_type query ) const noexcept;
+
+      /// \brief Gets the most byte edits by which a string of \p length
+      ///        bytes within \p max code point edits of \p query may differ
+      ///        from it
+      ///
+      /// Of the edits, those that make up the difference in length change
+      /// no more than one letter each, and the rest no more than two, so
+      /// the bound affords both the difference and twice \p max letters.
+      ///
+      /// \param max the largest distance of interest
+      /// \param query the query
+      /// \param length the length of the string, in bytes
+      /// \return the number of edits, or 0 if \p length is more than
+      ///         \p max code points away
+      size_type edit_bound( size_type max,
+                            string_view_type query,
+                            size_type length ) const noexcept;
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// \brief The damerau-levenshtein distance between UTF-8 strings by
+    ///        code point, as a metric of an index
+    ///
+    /// The edit bounds are those of utf8_levenshtein_metric, since a
+    /// transposition changes neither the length nor the letters.
+    //////////////////////////////////////////////////////////////////////////
+    class utf8_damerau_levenshtein_metric
+    {
+      //----------------------------------------------------------------------
+      // Public Member Types
+      //----------------------------------------------------------------------
+    public:
+
+      using char_type        = char;
+      using traits_type      = std::char_traits<char>;
+      using size_type        = std::size_t;
+      using string_view_type = stl::string_view;
+
+      /// The largest distance worth suggesting; two typos
+      static constexpr size_type default_max_distance = 2;
+
+      //----------------------------------------------------------------------
+      // Distance
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Computes the damerau-levenshtein distance between \p lhs
+      ///        and \p rhs by code point, giving up as soon as it is known
+      ///        to exceed \p max
+      ///
+      /// \param lhs the first string
+      /// \param rhs the second string
+      /// \param max the largest distance of interest
+      /// \return the distance, or \p max + 1 if the distance exceeds \p max
+      size_type operator()( string_view_type lhs,
+                            string_view_type rhs,
+                            size_type max ) const noexcept;
+
+      /// \copydoc utf8_levenshtein_metric::edit_bound(size_type,string_view_type) const
+      size_type edit_bound( size_type max, string_view_type query ) const noexcept;
+
+      /// \copydoc utf8_levenshtein_metric::edit_bound(size_type,string_view_type,size_type) const
+      size_type edit_bound( size_type max,
+                            string_view_type query,
+                            size_type length ) const noexcept;
+    };
+
+    //------------------------------------------------------------------------
+    // Type Aliases
+    //------------------------------------------------------------------------
+
+    using levenshtein_metric         = basic_levenshtein_metric<char>;
+    using damerau_levenshtein_metric = basic_damerau_levenshtein_metric<char>;
+    using jaro_winkler_metric        = basic_jaro_winkler_metric<char>;
+    using prefix_weighted_metric     = basic_prefix_weighted_metric<char>;
+    using distance_function          = basic_distance_function<char>;
+
+
+  } // namespace tools
+} // namespace bit
+
+#include "detail/distance_metric.inl"
+
+#endif // BIT_TOOLS_DISTANCE_METRIC_HPP
@@ -0,0 +1,207 @@
+#ifndef BIT_TOOLS_EDIT_DISTANCE_HPP
+#define BIT_TOOLS_EDIT_DISTANCE_HPP
+
+#include <bit/stl/string_view.hpp>
+
+#include <algorithm>   // std::min, std::fill
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint32_t, std::uint64_t
+#include <type_traits> // std::make_unsigned
+#include <vector>      // std::vector
+
+namespace bit {
+  namespace tools {
+    namespace detail {
+
+      /// The word of the bit-parallel distance kernels
+      using distance_word = std::uint64_t;
+
+      /// The number of pattern characters in a distance_word
+      constexpr std::size_t distance_word_bits = 64;
+
+      /// The number of cells that the scalar kernels keep on the stack
+      /// before falling back to scratch_storage
+      constexpr std::size_t distance_stack_cells = 256;
+
+      ////////////////////////////////////////////////////////////////////////
+      /// \brief The match vectors of a pattern of at most 64 characters,
+      ///        each holding the positions at which a character occurs
+      ///
+      /// Single-byte characters index a table of 256 vectors directly; only
+      /// the entries for the characters of the text and pattern are
+      /// cleared, which is much cheaper than clearing the table for short
+      /// strings.
+      ///
+      /// \tparam CharT the character type
+      /// \tparam Traits the character traits
+      /// \tparam Bytes whether \p CharT is a single byte
+      ////////////////////////////////////////////////////////////////////////
+      template<typename CharT, typename Traits, bool Bytes = (sizeof(CharT) == 1)>
+      class match_table
+      {
+      public:
+
+        using string_view_type = stl::basic_string_view<CharT,Traits>;
+
+        /// \brief Builds the match vectors of \p pattern, for looking up
+        ///        the characters of \p text
+        ///
+        /// \param text the text
+        /// \param pattern the pattern; at most 64 characters
+        match_table( string_view_type text, string_view_type pattern ) noexcept;
+
+        /// \brief Gets the match vector of \p c
+        ///
+        /// \param c the character
+        /// \return the positions of \p c in the pattern
+        distance_word operator[]( CharT c ) const noexcept;
+
+      private:
+
+        distance_word m_vectors[256]; ///< The vector of each byte
+      };
+
+      ////////////////////////////////////////////////////////////////////////
+      /// \brief The match vectors of a pattern of wide characters
+      ///
+      /// A pattern whose characters are all below 256, as is usual for
+      /// command lines, uses a table indexed by character, with a range
+      /// check. Any other pattern hashes its at most 64 distinct characters
+      /// into an open-addressed table of up to 128 slots, sized to twice
+      /// the pattern so that short patterns clear only a few.
+      ////////////////////////////////////////////////////////////////////////
+      template<typename CharT, typename Traits>
+      class match_table<CharT,Traits,false>
+      {
+      public:
+
+        using string_view_type = stl::basic_string_view<CharT,Traits>;
+
+        match_table( string_view_type text, string_view_type pattern ) noexcept;
+
+        distance_word operator[]( CharT c ) const noexcept;
+
+      private:
+
+        using unsigned_type = typename std::make_unsigned<CharT>::type;
+
+        /// The largest number of slots of the hashed table
+        static constexpr std::size_t slots = 128;
+
+        /// \brief Gets the home slot of \p c in the hashed table
+        std::size_t home( unsigned_type c ) const noexcept;
+
+        bool          m_small;          ///< Whether the pattern is below 256
+        unsigned      m_shift;          ///< 32 less the log2 of the slots in use
+        distance_word m_vectors[256];   ///< The vector of each small character
+        unsigned_type m_keys[slots];    ///< The character in each slot
+        distance_word m_slots[slots];   ///< The vector in each slot; 0 if empty
+      };
+
+      //----------------------------------------------------------------------
+      // Kernels
+      //----------------------------------------------------------------------
+
+      /// \brief Gets storage for at least \p count values, owned by the
+      ///        calling thread and reused by its later calls
+      ///
+      /// The storage only ever grows, so each thread allocates at most once
+      /// for each longer string it sees; and it is never shared, so
+      /// concurrent calls do not contend for it.
+      ///
+      /// \param count the number of values
+      /// \return the storage
+      template<typename T>
+      T* scratch_storage( std::size_t count );
+
+      /// \brief Removes the common prefix and suffix of \p lhs and \p rhs,
+      ///        which never contribute to the distance
+      ///
+      /// \param lhs the first string
+      /// \param rhs the second string
+      template<typename CharT, typename Traits>
+      void trim_affixes( stl::basic_string_view<CharT,Traits>& lhs,
+                         stl::basic_string_view<CharT,Traits>& rhs ) noexcept;
+
+      /// \brief Removes the common prefix and suffix of \p lhs and \p rhs,
+      ///        comparing 16 bytes at a time where SSE2 is available
+      ///
+      /// \param lhs the first string
+      /// \param rhs the second string
+      void trim_affixes( stl::string_view& lhs, stl::string_view& rhs ) noexcept;
+
+      /// \brief Computes the levenshtein distance of \p text and \p pattern
+      ///        using Myers' bit-vector algorithm, with the formulation from
+      ///        Hyyrö (2001)
+      ///
+      /// \p pattern must be non-empty, and no longer than 64 characters
+      ///
+      /// \param text the text
+      /// \param pattern the pattern
+      /// \param max the maximum distance of interest
+      /// \return the distance, or \p max + 1 if it exceeds \p max
+      template<typename CharT, typename Traits>
+      std::size_t myers_distance( stl::basic_string_view<CharT,Traits> text,
+                                  stl::basic_string_view<CharT,Traits> pattern,
+                                  std::size_t max ) noexcept;
+
+      /// \brief Computes the optimal string alignment distance of \p text
+      ///        and \p pattern using Hyyrö's extension of Myers' algorithm
+      ///
+      /// \p pattern must be non-empty, and no longer than 64 characters
+      ///
+      /// \param text the text
+      /// \param pattern the pattern
+      /// \param max the maximum distance of interest
+      /// \return the distance, or \p max + 1 if it exceeds \p max
+      template<typename CharT, typename Traits>
+      std::size_t hyyro_distance( stl::basic_string_view<CharT,Traits> text,
+                                  stl::basic_string_view<CharT,Traits> pattern,
+                                  std::size_t max ) noexcept;
+
+      /// \brief Computes the levenshtein distance of \p lhs and \p rhs, if it
+      ///        does not exceed \p max, using Ukkonen's diagonal band
+      ///
+      /// Only the cells within \p max of the main diagonal can hold a
+      /// distance of at most \p max, so only those <tt>2 * max + 1</tt>
+      /// cells of each row are computed. Cells are indexed by their
+      /// diagonal, so the storage does not depend on the length of the
+      /// strings. \p rhs must be the shorter string, and must be no more than
+      /// \p max shorter than \p lhs.
+      ///
+      /// \param lhs the longer string
+      /// \param rhs the shorter string
+      /// \param max the maximum distance of interest
+      /// \param band storage for <tt>2 * max + 3</tt> cells
+      /// \return the distance, or \p max + 1 if it exceeds \p max
+      template<typename CharT, typename Traits>
+      std::size_t levenshtein_band( stl::basic_string_view<CharT,Traits> lhs,
+                                    stl::basic_string_view<CharT,Traits> rhs,
+                                    std::size_t max,
+                                    std::size_t* band ) noexcept;
+
+      /// \brief Computes the optimal string alignment distance of \p lhs and
+      ///        \p rhs, if it does not exceed \p max, using Ukkonen's
+      ///        diagonal band
+      ///
+      /// \p rhs must be the shorter string, and must be no more than \p max
+      /// shorter than \p lhs.
+      ///
+      /// \param lhs the longer string
+      /// \param rhs the shorter string
+      /// \param max the maximum distance of interest
+      /// \param band storage for <tt>3 * (2 * max + 3)</tt> cells
+      /// \return the distance, or \p max + 1 if it exceeds \p max
+      template<typename CharT, typename Traits>
+      std::size_t osa_band( stl::basic_string_view<CharT,Traits> lhs,
+                            stl::basic_string_view<CharT,Traits> rhs,
+                            std::size_t max,
+                            std::size_t* band ) noexcept;
+
+    } // namespace detail
+  } // namespace tools
+} // namespace bit
+
+#include "detail/edit_distance.inl"
+
+#endif // BIT_TOOLS_EDIT_DISTANCE_HPP
@@ -0,0 +1,44 @@
+#ifndef BIT_TOOLS_FNV1A_HASH_HPP
+#define BIT_TOOLS_FNV1A_HASH_HPP
+
+#include <bit/stl/string_view.hpp>
+
+#include <cstdint>     // std::uint64_t
+#include <type_traits> // std::make_unsigned
+
+namespace bit {
+  namespace tools {
+    namespace detail {
+
+      /// The initial value of a 64-bit FNV-1a hash
+      constexpr std::uint64_t fnv1a_offset_basis = 14695981039346656037ull;
+
+      /// The multiplier of a 64-bit FNV-1a hash
+      constexpr std::uint64_t fnv1a_prime = 1099511628211ull;
+
+      /// \brief Folds \p value into the 64-bit FNV-1a hash \p hash
+      ///
+      /// \param hash the hash so far
+      /// \param value the value to fold in
+      /// \return the new hash
+      constexpr std::uint64_t fnv1a_step( std::uint64_t hash, std::uint64_t value ) noexcept;
+
+      /// \brief Computes the 64-bit FNV-1a hash of the string \p str
+      ///
+      /// Each code unit is hashed in full, so that wide strings produce
+      /// distinct hashes for distinct code units
+      ///
+      /// \param str the string to hash
+      /// \param seed the initial hash
+      /// \return the hash of \p str
+      template<typename CharT, typename Traits>
+      std::uint64_t fnv1a_hash( stl::basic_string_view<CharT,Traits> str,
+                                std::uint64_t seed = fnv1a_offset_basis ) noexcept;
+
+    } // namespace detail
+  } // namespace tools
+} // namespace bit
+
+#include "detail/fnv1a_hash.inl"
+
+#endif // BIT_TOOLS_FNV1A_HASH_HPP
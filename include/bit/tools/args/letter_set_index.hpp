@@ -0,0 +1,298 @@
+#ifndef BIT_TOOLS_LETTER_SET_INDEX_HPP
+#define BIT_TOOLS_LETTER_SET_INDEX_HPP
+
+#include "distance_metric.hpp"
+
+#include <bit/stl/string_view.hpp>
+
+#include <algorithm> // std::min, std::max, std::sort
+#include <cstddef>   // std::size_t
+#include <cstdint>   // std::uint32_t, std::uint64_t
+#include <iterator>  // std::iterator_traits, std::forward_iterator_tag
+#include <string>    // std::char_traits
+#include <utility>   // std::move
+#include <vector>    // std::vector
+
+namespace bit {
+  namespace tools {
+    namespace detail {
+
+      /// \brief Reserves room in \p text and \p offsets for the arguments
+      ///        in <tt>[first, last)</tt>, by reading the range ahead of time
+      ///
+      /// \param text the text to reserve in
+      /// \param offsets the offsets to reserve in, one per argument plus one
+      /// \param first the start of the range of arguments
+      /// \param last the end of the range of arguments
+      template<typename CharT, typename Traits, typename ForwardIt>
+      void reserve_args( std::vector<CharT>* text,
+                         std::vector<std::uint32_t>* offsets,
+                         ForwardIt first, ForwardIt last,
+                         std::forward_iterator_tag );
+
+      /// \brief Does nothing, since a single-pass range cannot be read ahead
+      template<typename CharT, typename Traits, typename InputIt>
+      void reserve_args( std::vector<CharT>* text,
+                         std::vector<std::uint32_t>* offsets,
+                         InputIt first, InputIt last,
+                         std::input_iterator_tag );
+
+      /// \brief Finds the signatures that differ from \p query in at most
+      ///        \p threshold bits
+      ///
+      /// This does not depend on the character type, so every
+      /// basic_letter_set_index shares the kernels selected for the host.
+      ///
+      /// \param survivors storage for at least \p count indices
+      /// \param signatures the signatures to test
+      /// \param count the number of signatures
+      /// \param query the signature of the query
+      /// \param threshold the largest number of differing bits
+      /// \return the number of indices, relative to \p signatures, that
+      ///         were stored in \p survivors, in ascending order
+      std::size_t filter_signatures( std::uint32_t* survivors,
+                                     const std::uint64_t* signatures,
+                                     std::size_t count,
+                                     std::uint64_t query,
+                                     std::size_t threshold ) noexcept;
+
+      /// \brief Scores each of the \p count \p candidates against \p query
+      ///        at once, if \p metric has a batched kernel
+      ///
+      /// Metrics have none by default, so their candidates are scored one
+      /// at a time, each with the bound that the ones before it leave.
+      ///
+      /// \param distances the output array of at least \p count distances,
+      ///        each \p max + 1 if the distance exceeds \p max
+      /// \param metric the metric to score with
+      /// \param query the query
+      /// \param candidates the candidates to score
+      /// \param count the number of candidates
+      /// \param max the largest distance of interest
+      /// \return \c true if \p distances were stored
+      template<typename Metric, typename CharT, typename Traits>
+      bool score_candidates( std::size_t* distances,
+                             const Metric& metric,
+                             stl::basic_string_view<CharT,Traits> query,
+                             const stl::basic_string_view<CharT,Traits>* candidates,
+                             std::size_t count,
+                             std::size_t max ) noexcept;
+
+      /// The fewest survivors of a block that are worth scoring at once;
+      /// setting up a batch costs about as much as scoring a few dozen
+      /// candidates one at a time
+      constexpr std::size_t min_batch_candidates = 32;
+
+      /// \brief Scores each of the \p count \p candidates against \p query
+      ///        with the batched levenshtein_distances
+      ///
+      /// \param distances the output array of at least \p count distances,
+      ///        each \p max + 1 if the distance exceeds \p max
+      /// \param metric the metric to score with
+      /// \param query the query
+      /// \param candidates the candidates to score
+      /// \param count the number of candidates
+      /// \param max the largest distance of interest
+      /// \return \c true if \p distances were stored
+      bool score_candidates( std::size_t* distances,
+                             const basic_levenshtein_metric<char>& metric,
+                             stl::string_view query,
+                             const stl::string_view* candidates,
+                             std::size_t count,
+                             std::size_t max ) noexcept;
+
+    } // namespace detail
+
+    //////////////////////////////////////////////////////////////////////////
+    /// \brief A suggestion index that filters arguments by the set of
+    ///        characters they contain, and by their length
+    ///
+    /// Each argument has a 64-bit signature with one bit for each letter,
+    /// in either case, each digit, \c '-' and \c '_'. An insertion or
+    /// deletion changes at most one bit of a signature and the length by
+    /// one, and a substitution changes at most two bits; so an argument
+    /// within \c k edits of the query has
+    /// <tt>popcount(sig_q ^ sig_a) + |len_q - len_a| <= 2k</tt>.
+    ///
+    /// Arguments are sorted by length, so only the lengths within \c k of
+    /// the query are visited at all. Their signatures are stored densely,
+    /// apart from the text, and are tested several at a time with vector
+    /// instructions where available. Only the arguments that pass are read
+    /// and scored.
+    ///
+    /// The text of every argument is kept in one arena, beside an array of
+    /// offsets and the array of signatures, so each argument costs 12 bytes
+    /// besides its text. Constructing from a forward range makes a fixed
+    /// number of allocations, however many arguments it holds.
+    ///
+    /// Wide characters outside of ASCII have no bit, so they only loosen
+    /// the filter, and the text is compared in its own character type.
+    ///
+    /// The arguments that pass are scored by \p Metric, which is called
+    /// directly rather than through a pointer, and whose edit_bound()
+    /// stands in for \c k above. With levenshtein_metric, a block of
+    /// signatures that many arguments pass is scored all at once by the
+    /// batched levenshtein_distances.
+    ///
+    /// \tparam CharT the character type
+    /// \tparam Traits the character traits
+    /// \tparam Metric the metric that scores candidates
+    //////////////////////////////////////////////////////////////////////////
+    template<typename CharT,
+             typename Traits = std::char_traits<CharT>,
+             typename Metric = basic_levenshtein_metric<CharT,Traits>>
+    class basic_letter_set_index
+    {
+      //----------------------------------------------------------------------
+      // Public Member Types
+      //----------------------------------------------------------------------
+    public:
+
+      using char_type        = CharT;
+      using traits_type      = Traits;
+      using size_type        = std::size_t;
+      using string_view_type = stl::basic_string_view<CharT,Traits>;
+      using metric_type      = Metric;
+
+      //----------------------------------------------------------------------
+      // Constructors
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs an index of the arguments in <tt>[first, last)</tt>
+      ///
+      /// \param first the start of the range of arguments
+      /// \param last the end of the range of arguments
+      /// \param metric the metric used for searches
+      template<typename InputIt>
+      basic_letter_set_index( InputIt first, InputIt last,
+                              metric_type metric = metric_type{} );
+
+      //----------------------------------------------------------------------
+      // Capacity
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Returns the number of indexed arguments
+      ///
+      /// \return the number of arguments
+      size_type size() const noexcept;
+
+      /// \brief Returns the number of bytes used by this index, excluding
+      ///        the object itself
+      ///
+      /// \return the memory usage in bytes
+      size_type memory_usage() const noexcept;
+
+      //----------------------------------------------------------------------
+      // Observers
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Gets the metric used for searches
+      ///
+      /// \return reference to the metric
+      const metric_type& metric() const noexcept;
+
+      //----------------------------------------------------------------------
+      // Search
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Calls \p visitor with each argument, and its distance,
+      ///        that is within \p max of \p query
+      ///
+      /// \param query the string to search for
+      /// \param max the largest distance to report
+      /// \param visitor a function callable as
+      ///        <tt>visitor(string_view_type, size_type)</tt>
+      /// \return the number of arguments that were scored
+      template<typename Visitor>
+      size_type search( string_view_type query,
+                        size_type max,
+                        Visitor&& visitor ) const;
+
+      /// \brief Calls \p visitor with each argument of partition \p part,
+      ///        and its distance, that is within \p max of \p query
+      ///
+      /// The arguments are split into \p parts partitions of interleaved
+      /// blocks, so that each of \p parts threads may search one of them.
+      /// Lengths are visited from the query's outwards, and \p visitor
+      /// returns the largest distance still of interest, which replaces
+      /// \p max for the rest of the search.
+      ///
+      /// \param query the string to search for
+      /// \param max the largest distance to report
+      /// \param part the partition to search, less than \p parts
+      /// \param parts the number of partitions
+      /// \param visitor a function callable as
+      ///        <tt>visitor(string_view_type, size_type)</tt>, returning
+      ///        the new largest distance
+      /// \return the number of arguments that were scored
+      template<typename Visitor>
+      size_type search( string_view_type query,
+                        size_type max,
+                        size_type part,
+                        size_type parts,
+                        Visitor&& visitor ) const;
+
+      //----------------------------------------------------------------------
+      // Private Member Types
+      //----------------------------------------------------------------------
+    private:
+
+      /// The number of signatures filtered at a time
+      static constexpr size_type filter_block = 256;
+
+      //----------------------------------------------------------------------
+      // Private Members
+      //----------------------------------------------------------------------
+    private:
+
+      metric_type                m_metric;        ///< The metric used for computing distance
+      std::vector<std::uint64_t> m_signatures;    ///< The signature of each argument
+      std::vector<std::uint32_t> m_offsets;       ///< The start of each argument, and the end
+      std::vector<std::uint32_t> m_length_starts; ///< The first argument of each length, and the end
+      std::vector<CharT>         m_arena;         ///< The text of every argument
+
+      //----------------------------------------------------------------------
+      // Private Member Functions
+      //----------------------------------------------------------------------
+    private:
+
+      /// \brief Sorts the arguments by length, and stores their signatures
+      ///        and text
+      ///
+      /// \param text the text of every argument, in the order given
+      /// \param offsets the start of each argument in \p text, and the end
+      void build( const std::vector<CharT>& text,
+                  const std::vector<std::uint32_t>& offsets );
+
+      /// \brief Gets the argument at \p index
+      ///
+      /// \param index the index of the argument
+      /// \return the argument
+      string_view_type arg( size_type index ) const noexcept;
+
+      /// \brief Computes the signature of \p str
+      ///
+      /// \param str the string
+      /// \return the signature
+      static std::uint64_t signature( string_view_type str ) noexcept;
+    };
+
+    //------------------------------------------------------------------------
+    // Type Aliases
+    //------------------------------------------------------------------------
+
+    using letter_set_index    = basic_letter_set_index<char>;
+    using wletter_set_index   = basic_letter_set_index<wchar_t>;
+    using u16letter_set_index = basic_letter_set_index<char16_t>;
+    using u32letter_set_index = basic_letter_set_index<char32_t>;
+
+  } // namespace tools
+} // namespace bit
+
+#include "detail/letter_set_index.inl"
+
+#endif // BIT_TOOLS_LETTER_SET_INDEX_HPP
@@ -0,0 +1,170 @@
+#ifndef BIT_TOOLS_MAPPED_SYMSPELL_INDEX_HPP
+#define BIT_TOOLS_MAPPED_SYMSPELL_INDEX_HPP
+
+#include "symspell_index.hpp"
+
+#include <bit/stl/string_view.hpp>
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <string>  // std::string
+#include <utility> // std::forward
+#include <vector>  // std::vector
+
+namespace bit {
+  namespace tools {
+
+    //////////////////////////////////////////////////////////////////////////
+    /// \brief A symspell_index that is searched in place from a file written
+    ///        by symspell_index::save
+    ///
+    /// Opening the file maps it into memory and checks its header, which is
+    /// constant time; nothing is parsed or copied, and pages are only read
+    /// as searches touch them. This lets a short-lived process skip
+    /// building the index on every start.
+    ///
+    /// The file starts with a 64-byte header holding a magic string, the
+    /// format version, a byte-order mark, the index parameters, the size of
+    /// each table, and a checksum of the tables. The tables follow in a
+    /// fixed order, at offsets computed from their sizes. Files from another
+    /// version, byte order, or configuration are rejected on open. The
+    /// checksum is only checked by verify(), since doing so reads the whole
+    /// file.
+    ///
+    /// On platforms without \c mmap the file is read into memory instead.
+    //////////////////////////////////////////////////////////////////////////
+    class mapped_symspell_index
+    {
+      //----------------------------------------------------------------------
+      // Public Member Types
+      //----------------------------------------------------------------------
+    public:
+
+      using size_type        = symspell_view::size_type;
+      using distance_fn_type = symspell_view::distance_fn_type;
+      using metric_type      = symspell_view::metric_type;
+
+      /// The version of the file format written by symspell_index::save
+      static constexpr std::uint32_t file_version = 1;
+
+      //----------------------------------------------------------------------
+      // Constructors / Destructor / Assignment
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Opens the index file at \p path
+      ///
+      /// \param path the path to the file
+      /// \param fn the bounded distance function used for searches; this
+      ///        should be the function the index was built with
+      /// \throws std::system_error if the file cannot be opened or mapped
+      /// \throws std::runtime_error if the file is not an index of this
+      ///         version and configuration
+      mapped_symspell_index( const std::string& path, metric_type fn );
+
+      /// \brief Move-constructs an index from \p other
+      ///
+      /// \param other the index to move
+      mapped_symspell_index( mapped_symspell_index&& other ) noexcept;
+
+      // Deleted copy constructor
+      mapped_symspell_index( const mapped_symspell_index& other ) = delete;
+
+      //----------------------------------------------------------------------
+
+      /// \brief Unmaps the file
+      ~mapped_symspell_index();
+
+      //----------------------------------------------------------------------
+
+      /// \brief Move-assigns an index from \p other
+      ///
+      /// \param other the index to move
+      /// \return reference to \c (*this)
+      mapped_symspell_index& operator=( mapped_symspell_index&& other ) noexcept;
+
+      // Deleted copy assignment
+      mapped_symspell_index& operator=( const mapped_symspell_index& other ) = delete;
+
+      //----------------------------------------------------------------------
+      // Capacity
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Returns the number of indexed arguments
+      ///
+      /// \return the number of arguments
+      size_type size() const noexcept;
+
+      /// \brief Returns the size of the mapped file, in bytes
+      ///
+      /// \return the file size
+      size_type file_size() const noexcept;
+
+      //----------------------------------------------------------------------
+      // Search
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Calls \p visitor with each argument, and its distance,
+      ///        that is within \p max of \p query
+      ///
+      /// \param query the string to search for
+      /// \param max the largest distance to report
+      /// \param visitor a function callable as
+      ///        <tt>visitor(stl::string_view, size_type)</tt>
+      /// \return the number of arguments that were scored
+      template<typename Visitor>
+      size_type search( stl::string_view query,
+                        size_type max,
+                        Visitor&& visitor ) const;
+
+      /// \brief Returns a view of the mapped tables
+      ///
+      /// The view is invalidated by destroying, or assigning to, this index
+      ///
+      /// \return the view
+      const symspell_view& view() const noexcept;
+
+      //----------------------------------------------------------------------
+      // Validation
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Checks the tables against the checksum in the header
+      ///
+      /// This reads every page of the file
+      ///
+      /// \return \c true if the checksum matches
+      bool verify() const noexcept;
+
+      //----------------------------------------------------------------------
+      // Private Members
+      //----------------------------------------------------------------------
+    private:
+
+      const char*                m_data;   ///< The start of the file
+      size_type                  m_size;   ///< The size of the file
+      std::vector<std::uint64_t> m_buffer; ///< The file contents, if not mapped
+      symspell_view              m_view;   ///< The view of the tables
+
+      //----------------------------------------------------------------------
+      // Private Member Functions
+      //----------------------------------------------------------------------
+    private:
+
+      /// \brief Maps, or reads, the file at \p path into memory
+      ///
+      /// \param path the path to the file
+      void open( const std::string& path );
+
+      /// \brief Unmaps the file, if it was mapped
+      void close() noexcept;
+    };
+
+  } // namespace tools
+} // namespace bit
+
+#include "detail/mapped_symspell_index.inl"
+
+#endif // BIT_TOOLS_MAPPED_SYMSPELL_INDEX_HPP
@@ -0,0 +1,160 @@
+#ifndef BIT_TOOLS_PARSE_STATISTICS_HPP
+#define BIT_TOOLS_PARSE_STATISTICS_HPP
+
+#include <chrono>  // std::chrono::nanoseconds, std::chrono::steady_clock
+#include <cstddef> // std::size_t
+
+//----------------------------------------------------------------------------
+// Instrumentation
+//----------------------------------------------------------------------------
+
+// Parse instrumentation is opt-in. When BIT_TOOLS_ENABLE_PARSE_INSTRUMENTATION
+// is not defined, every probe expands to nothing, and parse_arguments
+// compiles to exactly the uninstrumented code.
+#ifdef BIT_TOOLS_ENABLE_PARSE_INSTRUMENTATION
+# define BIT_TOOLS_DETAIL_PARSE_PROBE(...) __VA_ARGS__
+#else
+# define BIT_TOOLS_DETAIL_PARSE_PROBE(...)
+#endif
+
+namespace bit {
+  namespace tools {
+
+    //////////////////////////////////////////////////////////////////////////
+    /// \brief Counters collected from a single call to parse_arguments
+    ///
+    /// These are only collected when the library is compiled with
+    /// \c BIT_TOOLS_ENABLE_PARSE_INSTRUMENTATION defined
+    //////////////////////////////////////////////////////////////////////////
+    struct parse_statistics
+    {
+      std::size_t flag_lookups;       ///< Number of times a flag was looked up
+      std::size_t string_comparisons; ///< Number of flag comparisons made
+      std::size_t alias_hops;         ///< Number of aliases followed
+      std::size_t unmatched;          ///< Number of unmatched arguments
+
+      std::chrono::nanoseconds lookup_time;         ///< Time spent looking up flags
+      std::chrono::nanoseconds outside_lookup_time; ///< Time spent outside of lookups, assigning values among the rest
+      std::chrono::nanoseconds total_time;          ///< Total time spent parsing
+    };
+
+    /// \brief The type of the callback invoked after each parse
+    using parse_statistics_callback = void(*)( const parse_statistics& stats,
+                                               void* context );
+
+    /// \brief Sets the \p callback to invoke with the statistics of each
+    ///        call to parse_arguments
+    ///
+    /// \note This is not synchronized, and is meant to be called once at
+    ///       startup prior to any parsing
+    ///
+    /// \param callback the callback to invoke, or \c nullptr to disable
+    /// \param context a user-supplied pointer passed to \p callback
+    void set_parse_statistics_callback( parse_statistics_callback callback,
+                                        void* context = nullptr ) noexcept;
+
+    namespace detail {
+
+      using parse_clock = std::chrono::steady_clock;
+
+      struct parse_statistics_hook
+      {
+        parse_statistics_callback callback;
+        void*                     context;
+      };
+
+      /// \brief Gets the globally installed statistics hook
+      ///
+      /// \return reference to the hook
+      parse_statistics_hook& get_parse_statistics_hook() noexcept;
+
+      ////////////////////////////////////////////////////////////////////////
+      /// \brief Accumulates the time spent in the current scope into a
+      ///        duration
+      ////////////////////////////////////////////////////////////////////////
+      class scoped_parse_timer
+      {
+      public:
+        explicit scoped_parse_timer( std::chrono::nanoseconds* duration ) noexcept;
+        ~scoped_parse_timer();
+
+        scoped_parse_timer( const scoped_parse_timer& ) = delete;
+        scoped_parse_timer& operator=( const scoped_parse_timer& ) = delete;
+
+      private:
+        std::chrono::nanoseconds* m_duration;
+        parse_clock::time_point   m_start;
+      };
+
+      /// \brief Finalizes the \p stats and reports them to the installed
+      ///        callback, if any
+      ///
+      /// \param stats the statistics to report
+      /// \param start the time at which parsing started
+      void report_parse_statistics( parse_statistics& stats,
+                                    parse_clock::time_point start ) noexcept;
+
+    } // namespace detail
+  } // namespace tools
+} // namespace bit
+
+//----------------------------------------------------------------------------
+// Inline Definitions
+//----------------------------------------------------------------------------
+
+inline void
+  bit::tools::set_parse_statistics_callback( parse_statistics_callback callback,
+                                             void* context )
+  noexcept
+{
+  auto& hook = detail::get_parse_statistics_hook();
+
+  hook.callback = callback;
+  hook.context  = context;
+}
+
+inline bit::tools::detail::parse_statistics_hook&
+  bit::tools::detail::get_parse_statistics_hook()
+  noexcept
+{
+  static parse_statistics_hook hook = { nullptr, nullptr };
+
+  return hook;
+}
+
+//----------------------------------------------------------------------------
+
+inline bit::tools::detail::scoped_parse_timer
+  ::scoped_parse_timer( std::chrono::nanoseconds* duration )
+  noexcept
+  : m_duration(duration),
+    m_start(parse_clock::now())
+{
+
+}
+
+inline bit::tools::detail::scoped_parse_timer::~scoped_parse_timer()
+{
+  (*m_duration) += std::chrono::duration_cast<std::chrono::nanoseconds>(parse_clock::now() - m_start);
+}
+
+//----------------------------------------------------------------------------
+
+inline void
+  bit::tools::detail::report_parse_statistics( parse_statistics& stats,
+                                               parse_clock::time_point start )
+  noexcept
+{
+  // Assigning a value is a store or two, which a timer of its own would
+  // cost more than, so the rest is derived rather than measured
+  stats.total_time          = std::chrono::duration_cast<std::chrono::nanoseconds>(parse_clock::now() - start);
+  stats.outside_lookup_time = stats.total_time - stats.lookup_time;
+
+  const auto& hook = get_parse_statistics_hook();
+
+  if( hook.callback ) {
+    hook.callback( stats, hook.context );
+  }
+}
+
+#endif // BIT_TOOLS_PARSE_STATISTICS_HPP
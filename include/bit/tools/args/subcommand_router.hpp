@@ -0,0 +1,216 @@
+#ifndef BIT_TOOLS_SUBCOMMAND_ROUTER_HPP
+#define BIT_TOOLS_SUBCOMMAND_ROUTER_HPP
+
+#include "arg_vector.hpp"
+#include "arg_parser.hpp"
+#include "fnv1a_hash.hpp"
+
+#include <bit/stl/string_view.hpp>
+
+#include <cstdint> // std::uint64_t
+#include <vector>  // std::vector
+
+namespace bit {
+  namespace tools {
+    //////////////////////////////////////////////////////////////////////////
+    /// \brief A router that dispatches a git-style command line to one of
+    ///        many subcommands
+    ///
+    /// Subcommands are registered by name along with a handler, and are
+    /// stored in an open-addressed hash table keyed on the subcommand name.
+    /// Dispatching looks up the first positional argument, and forwards the
+    /// arguments that follow it to the selected handler.
+    ///
+    /// Handlers are expected to construct their own basic_arg_set on entry,
+    /// so that only the argument set of the selected subcommand is ever
+    /// constructed and parsed.
+    ///
+    /// \tparam CharT the type of the char
+    /// \tparam Traits the type of the traits
+    //////////////////////////////////////////////////////////////////////////
+    template<typename CharT, typename Traits = std::char_traits<CharT>>
+    class basic_subcommand_router
+    {
+      static_assert( std::is_same<CharT,typename Traits::char_type>::value, "Traits::char_type must be the same as CharT");
+
+      //----------------------------------------------------------------------
+      // Public Member Types
+      //----------------------------------------------------------------------
+    public:
+
+      using string_type  = stl::basic_string_view<CharT,Traits>;
+      using vector_type  = basic_arg_vector<CharT,Traits>;
+      using set_type     = basic_arg_set<CharT,Traits>;
+      using size_type    = std::size_t;
+      using handler_type = int(*)( vector_type args );
+
+      //----------------------------------------------------------------------
+      // Constructor
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Default-constructs a basic_subcommand_router with no
+      ///        subcommands
+      explicit basic_subcommand_router() noexcept;
+
+      //----------------------------------------------------------------------
+      // Modifiers
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Registers the subcommand \p name to be handled by \p handler
+      ///
+      /// \note The characters referred to by \p name must outlive this router
+      ///
+      /// \param name the name of the subcommand
+      /// \param handler the handler to invoke when \p name is dispatched
+      /// \return \c true if the subcommand was registered, \c false if a
+      ///         subcommand of the same name already exists
+      bool add( string_type name, handler_type handler );
+
+      /// \brief Registers the subcommand \p name to be handled by a
+      ///        default-constructed \c Command
+      ///
+      /// The \c Command is only constructed when \p name is dispatched to.
+      /// The remaining arguments are parsed into the set returned by
+      /// \c Command::args() prior to invoking \c Command::run(), the result
+      /// of which is the status of the dispatch.
+      ///
+      /// \tparam Command the type of the command to construct
+      /// \param name the name of the subcommand
+      /// \return \c true if the subcommand was registered, \c false if a
+      ///         subcommand of the same name already exists
+      template<typename Command>
+      bool add( string_type name );
+
+      /// \brief Reserves storage for \p n subcommands
+      ///
+      /// \param n the number of subcommands to reserve
+      void reserve( size_type n );
+
+      //----------------------------------------------------------------------
+      // Observers
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Returns whether or not this router has any subcommands
+      ///
+      /// \return \c true if no subcommands have been registered
+      bool empty() const noexcept;
+
+      /// \brief Returns the number of registered subcommands
+      ///
+      /// \return the number of subcommands
+      size_type size() const noexcept;
+
+      /// \brief Finds the handler for the subcommand \p name
+      ///
+      /// \param name the name of the subcommand
+      /// \return the handler, or \c nullptr if no such subcommand exists
+      handler_type find( string_type name ) const noexcept;
+
+      //----------------------------------------------------------------------
+      // Dispatch
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Dispatches \p args to the subcommand named by its first
+      ///        positional argument
+      ///
+      /// The program name should already be stripped from \p args, e.g.
+      /// by passing \c args.subvec(1). Leading option tokens, i.e. any
+      /// argument other than \c "-" that starts with a \c '-', are skipped
+      /// and the first argument that follows them names the subcommand.
+      /// The subcommand handler receives every argument that follows the
+      /// subcommand name.
+      ///
+      /// \note Since the leading options are skipped without being parsed,
+      ///       a global option may not take a separate value; use the
+      ///       overload taking a basic_arg_set for that
+      ///
+      /// \param args the arguments to dispatch
+      /// \param status the status returned by the subcommand's handler
+      /// \return \c true if a subcommand was found and invoked
+      bool dispatch( vector_type args, int* status ) const;
+
+      /// \brief Parses the global options of \p args into \p global, and
+      ///        dispatches the rest to the subcommand named by the first
+      ///        registered name in \p args
+      ///
+      /// Every argument that precedes the subcommand name is parsed into
+      /// \p global, so that values of global options are consumed there and
+      /// any unexpected positional argument is left in \c global->unmatched().
+      /// The leading arguments are parsed even if no subcommand is found,
+      /// so that options such as \c --help may still be inspected.
+      ///
+      /// \note As with parse_arguments, a registered subcommand name is never
+      ///       taken as the value of a global option
+      ///
+      /// \param global the argument set to parse the global options into
+      /// \param args the arguments to dispatch
+      /// \param status the status returned by the subcommand's handler
+      /// \return \c true if a subcommand was found and invoked
+      bool dispatch( set_type* global, vector_type args, int* status ) const;
+
+      //----------------------------------------------------------------------
+      // Private Member Types
+      //----------------------------------------------------------------------
+    private:
+
+      struct entry
+      {
+        std::uint64_t hash;    ///< The hash of the name
+        string_type   name;    ///< The name of the subcommand
+        handler_type  handler; ///< The handler of the subcommand
+      };
+
+      // Slots hold an index into m_entries, offset by one so that 0 can be
+      // used as the empty marker
+      using slot_type = std::uint32_t;
+
+      //----------------------------------------------------------------------
+      // Private Members
+      //----------------------------------------------------------------------
+    private:
+
+      std::vector<entry>     m_entries; ///< The registered subcommands
+      std::vector<slot_type> m_slots;   ///< The open-addressed hash table
+
+      //----------------------------------------------------------------------
+      // Private Member Functions
+      //----------------------------------------------------------------------
+    private:
+
+      /// \brief Rebuilds the hash table with \p slots slots
+      ///
+      /// \param slots the number of slots; must be a power of two
+      void rehash( size_type slots );
+
+      /// \brief Finds the entry for the given \p name and \p hash
+      ///
+      /// \return pointer to the entry, or \c nullptr if not found
+      const entry* find_entry( string_type name, std::uint64_t hash ) const noexcept;
+
+      /// \brief Invokes \p handler with \p args, storing its result in
+      ///        \p status
+      static void invoke( handler_type handler, vector_type args, int* status );
+
+      template<typename Command>
+      static int invoke_command( vector_type args );
+    };
+
+    //------------------------------------------------------------------------
+    // Type Aliases
+    //------------------------------------------------------------------------
+
+    using subcommand_router    = basic_subcommand_router<char>;
+    using wsubcommand_router   = basic_subcommand_router<wchar_t>;
+    using u16subcommand_router = basic_subcommand_router<char16_t>;
+    using u32subcommand_router = basic_subcommand_router<char32_t>;
+
+  } // namespace tools
+} // namespace bit
+
+#include "detail/subcommand_router.inl"
+
+#endif // BIT_TOOLS_SUBCOMMAND_ROUTER_HPP
@@ -0,0 +1,251 @@
+#ifndef BIT_TOOLS_SUGGESTION_CACHE_HPP
+#define BIT_TOOLS_SUGGESTION_CACHE_HPP
+
+#include "fnv1a_hash.hpp"
+
+#include <bit/stl/string_view.hpp>
+
+#include <algorithm>   // std::copy, std::fill, std::min
+#include <atomic>      // std::atomic
+#include <chrono>      // std::chrono::nanoseconds, std::chrono::steady_clock
+#include <cstddef>     // std::size_t
+#include <cstdint>     // std::uint32_t, std::uint64_t
+#include <memory>      // std::unique_ptr
+#include <mutex>       // std::mutex, std::lock_guard
+#include <vector>      // std::vector
+
+namespace bit {
+  namespace tools {
+
+    //////////////////////////////////////////////////////////////////////////
+    /// \brief Counters collected by a suggestion_cache since it was
+    ///        constructed
+    //////////////////////////////////////////////////////////////////////////
+    struct suggestion_cache_statistics
+    {
+      std::size_t hits;      ///< Number of queries answered from the cache
+      std::size_t misses;    ///< Number of queries passed to the suggestor
+      std::size_t bypasses;  ///< Number of queries too long to be cached
+      std::size_t evictions; ///< Number of entries evicted to make room
+
+      std::chrono::nanoseconds hit_time;  ///< Total time spent on hits
+      std::chrono::nanoseconds miss_time; ///< Total time spent on misses
+
+      /// \brief Returns the fraction of cacheable queries that were hits
+      ///
+      /// \return the hit ratio, in <tt>[0, 1]</tt>
+      double hit_ratio() const noexcept;
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// \brief A fixed-capacity cache of recent queries, in front of an
+    ///        arg_suggestor
+    ///
+    /// Each entry holds a query and its closest suggestions, which view the
+    /// suggestor's own storage; so the suggestor must outlive the cache.
+    /// Entries are found through an open-addressed table keyed by the hash
+    /// of the query, and evicted with the CLOCK algorithm, which gives each
+    /// entry that was hit since the hand last passed a second chance.
+    ///
+    /// Every entry is allocated on construction, and nothing is allocated
+    /// afterwards. Queries longer than max_query_length bypass the cache.
+    ///
+    /// The cache is split into shards by hash, each with its own lock, so
+    /// that any number of threads may query it at once with little
+    /// contention. The suggestor itself is only called outside of a lock.
+    ///
+    /// \tparam Suggestor the suggestor type, such as arg_suggestor<char>
+    //////////////////////////////////////////////////////////////////////////
+    template<typename Suggestor>
+    class suggestion_cache
+    {
+      //----------------------------------------------------------------------
+      // Public Member Types
+      //----------------------------------------------------------------------
+    public:
+
+      using size_type        = std::size_t;
+      using suggestor_type   = Suggestor;
+      using char_type        = typename Suggestor::char_type;
+      using string_view_type = typename Suggestor::string_view_type;
+
+      /// The longest query that is cached
+      static constexpr size_type max_query_length = 64;
+
+      /// The most suggestions kept for each query
+      static constexpr size_type max_suggestions = 8;
+
+      /// The default number of shards
+      static constexpr size_type default_shards = 16;
+
+      //----------------------------------------------------------------------
+      // Constructors
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs a cache of at least \p capacity queries in front
+      ///        of \p suggestor
+      ///
+      /// \param suggestor the suggestor to cache the results of
+      /// \param capacity the number of queries to keep
+      /// \param shards the number of independently locked shards, which is
+      ///        rounded up to a power of two
+      suggestion_cache( const suggestor_type& suggestor,
+                        size_type capacity,
+                        size_type shards = default_shards );
+
+      suggestion_cache( const suggestion_cache& ) = delete;
+      suggestion_cache& operator=( const suggestion_cache& ) = delete;
+
+      //----------------------------------------------------------------------
+      // Capacity
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Returns the number of queries this cache can hold
+      ///
+      /// \return the capacity
+      size_type capacity() const noexcept;
+
+      //----------------------------------------------------------------------
+      // Observers
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Returns the suggestor whose results are cached
+      ///
+      /// \return reference to the suggestor
+      const suggestor_type& suggestor() const noexcept;
+
+      /// \brief Returns the counters collected so far
+      ///
+      /// The counters of each shard are read separately, so a snapshot
+      /// taken while queries are running may be slightly inconsistent.
+      ///
+      /// \return the statistics
+      suggestion_cache_statistics statistics() const noexcept;
+
+      //----------------------------------------------------------------------
+      // Suggestions
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Gets the known argument closest to \p input
+      ///
+      /// This may be called concurrently from any number of threads.
+      ///
+      /// \param input the unrecognized argument
+      /// \return the closest argument, or an empty view if none is within
+      ///         the suggestor's max_distance() edits
+      string_view_type suggest( string_view_type input );
+
+      /// \brief Stores every known argument within the suggestor's
+      ///        max_distance() edits of \p input in \p result
+      ///
+      /// Queries with more than max_suggestions suggestions are only cached
+      /// for suggest, and are passed to the suggestor here. This may be
+      /// called concurrently from any number of threads.
+      ///
+      /// \param result the vector to store the suggestions in, ordered
+      ///        from closest to furthest
+      /// \param input the unrecognized argument
+      void suggestions( std::vector<string_view_type>* result,
+                        string_view_type input );
+
+      /// \brief Drops every cached query, keeping the counters
+      void clear() noexcept;
+
+      //----------------------------------------------------------------------
+      // Private Member Types
+      //----------------------------------------------------------------------
+    private:
+
+      using clock = std::chrono::steady_clock;
+
+      struct entry
+      {
+        std::uint64_t    hash;                         ///< The hash of the query
+        std::uint32_t    length;                       ///< The length of the query
+        std::uint32_t    count;                        ///< The number of suggestions kept
+        bool             complete;                     ///< Whether every suggestion was kept
+        bool             referenced;                   ///< Whether it was hit since the hand passed
+        char_type        query[max_query_length];      ///< The text of the query
+        string_view_type suggestions[max_suggestions]; ///< The closest suggestions
+      };
+
+      struct shard
+      {
+        std::mutex                 mutex;   ///< Guards every other member
+        std::vector<entry>         entries; ///< The entries, allocated up front
+        std::vector<std::uint32_t> table;   ///< The index of each entry plus one, by hash
+        size_type                  used;    ///< The number of entries in use
+        size_type                  hand;    ///< The entry the CLOCK hand is on
+
+        std::atomic<std::size_t>   hits;      ///< Number of hits
+        std::atomic<std::size_t>   misses;    ///< Number of misses
+        std::atomic<std::size_t>   bypasses;  ///< Number of uncacheable queries
+        std::atomic<std::size_t>   evictions; ///< Number of evictions
+        std::atomic<std::uint64_t> hit_ns;    ///< Nanoseconds spent on hits
+        std::atomic<std::uint64_t> miss_ns;   ///< Nanoseconds spent on misses
+      };
+
+      //----------------------------------------------------------------------
+      // Private Members
+      //----------------------------------------------------------------------
+    private:
+
+      const suggestor_type*    m_suggestor;   ///< The suggestor to cache
+      std::unique_ptr<shard[]> m_shards;      ///< The shards
+      size_type                m_shard_count; ///< The number of shards; a power of two
+      size_type                m_capacity;    ///< The total number of entries
+
+      //----------------------------------------------------------------------
+      // Private Member Functions
+      //----------------------------------------------------------------------
+    private:
+
+      /// \brief Gets the suggestions of \p input from the cache, or from
+      ///        the suggestor on a miss
+      ///
+      /// \param result the vector to store the suggestions in
+      /// \param input the unrecognized argument
+      /// \param complete whether every suggestion is needed, rather than
+      ///        only the closest
+      void lookup( std::vector<string_view_type>* result,
+                   string_view_type input,
+                   bool complete );
+
+      /// \brief Finds the entry of \p input in \p s
+      ///
+      /// \param s the shard, which must be locked
+      /// \param hash the hash of \p input
+      /// \param input the query
+      /// \return the entry, or \c nullptr if there is none
+      entry* find( shard& s, std::uint64_t hash, string_view_type input ) const noexcept;
+
+      /// \brief Stores \p suggestions as the entry of \p input in \p s,
+      ///        evicting another entry if \p s is full
+      ///
+      /// \param s the shard, which must be locked
+      /// \param hash the hash of \p input
+      /// \param input the query
+      /// \param suggestions the suggestions of \p input
+      void insert( shard& s,
+                   std::uint64_t hash,
+                   string_view_type input,
+                   const std::vector<string_view_type>& suggestions ) noexcept;
+
+      /// \brief Removes entry \p index of \p s from its table, shifting back
+      ///        the entries probed after it
+      ///
+      /// \param s the shard, which must be locked
+      /// \param index the entry to remove
+      void erase( shard& s, std::uint32_t index ) noexcept;
+    };
+
+  } // namespace tools
+} // namespace bit
+
+#include "detail/suggestion_cache.inl"
+
+#endif // BIT_TOOLS_SUGGESTION_CACHE_HPP
@@ -0,0 +1,288 @@
+#ifndef BIT_TOOLS_SYMSPELL_INDEX_HPP
+#define BIT_TOOLS_SYMSPELL_INDEX_HPP
+
+#include "distance_metric.hpp"
+
+#include <bit/stl/string_view.hpp>
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <iosfwd>  // std::ostream
+#include <string>  // std::string
+#include <utility> // std::forward
+#include <vector>  // std::vector
+
+namespace bit {
+  namespace tools {
+
+    //////////////////////////////////////////////////////////////////////////
+    /// \brief A non-owning view of the tables of a symspell_index
+    ///
+    /// Every table is a flat array of trivially-copyable entries that refer
+    /// to each other only by index, so a view can be formed over the tables
+    /// of a built index, or directly over a file mapped into memory.
+    //////////////////////////////////////////////////////////////////////////
+    class symspell_view
+    {
+      //----------------------------------------------------------------------
+      // Public Member Types
+      //----------------------------------------------------------------------
+    public:
+
+      using size_type        = std::size_t;
+      using distance_fn_type = std::size_t(*)(stl::string_view,stl::string_view,std::size_t);
+      using metric_type      = distance_function;
+
+      /// The largest number of deletions precomputed for each argument
+      static constexpr size_type max_edits = 2;
+
+      /// The number of leading, and trailing, characters that deletions are
+      /// taken from
+      static constexpr size_type window_length = 7;
+
+      /// An entry of the open-addressed deletion table
+      struct slot
+      {
+        std::uint64_t hash;  ///< The hash of the deletion
+        std::uint32_t first; ///< The index of the first posting
+        std::uint32_t count; ///< The number of postings; 0 if unused
+      };
+
+      //----------------------------------------------------------------------
+      // Constructors
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs a view of an empty index
+      symspell_view() noexcept;
+
+      /// \brief Constructs a view of the given tables
+      ///
+      /// \param fn the bounded distance function used for searches
+      /// \param arena the text of every argument
+      /// \param offsets the \p count + 1 offsets of each argument in \p arena
+      /// \param count the number of arguments
+      /// \param slots the deletion table; a power of two in size
+      /// \param slot_count the number of slots
+      /// \param postings the arguments of each deletion
+      symspell_view( metric_type fn,
+                     const char* arena,
+                     const std::uint32_t* offsets,
+                     size_type count,
+                     const slot* slots,
+                     size_type slot_count,
+                     const std::uint32_t* postings ) noexcept;
+
+      //----------------------------------------------------------------------
+      // Capacity
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Returns the number of indexed arguments
+      ///
+      /// \return the number of arguments
+      size_type size() const noexcept;
+
+      //----------------------------------------------------------------------
+      // Search
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Calls \p visitor with each argument, and its distance,
+      ///        that is within \p max of \p query
+      ///
+      /// \param query the string to search for
+      /// \param max the largest distance to report
+      /// \param visitor a function callable as
+      ///        <tt>visitor(stl::string_view, size_type)</tt>
+      /// \return the number of arguments that were scored
+      template<typename Visitor>
+      size_type search( stl::string_view query,
+                        size_type max,
+                        Visitor&& visitor ) const;
+
+      //----------------------------------------------------------------------
+      // Private Members
+      //----------------------------------------------------------------------
+    private:
+
+      metric_type          m_distance_fn; ///< The function used for computing distance
+      const char*          m_arena;       ///< The text of every argument
+      const std::uint32_t* m_offsets;     ///< The start of each argument, and the end
+      size_type            m_count;       ///< The number of arguments
+      const slot*          m_slots;       ///< The open-addressed deletion table
+      size_type            m_slot_count;  ///< The number of slots
+      const std::uint32_t* m_postings;    ///< The arguments of each deletion
+
+      //----------------------------------------------------------------------
+      // Private Member Functions
+      //----------------------------------------------------------------------
+    private:
+
+      /// \brief Gets the argument at \p index
+      ///
+      /// \param index the index of the argument
+      /// \return the argument
+      stl::string_view arg( size_type index ) const noexcept;
+
+      /// \brief Collects the distinct indices of every argument that shares
+      ///        a deletion of at most \p max characters with both windows of
+      ///        \p query, in ascending order
+      ///
+      /// \param query the string to search for
+      /// \param max the number of deletions; at most max_edits
+      /// \param candidates the vector to store the indices in
+      void find_candidates( stl::string_view query,
+                            size_type max,
+                            std::vector<std::uint32_t>* candidates ) const;
+
+      /// \brief Finds the slot holding \p hash
+      ///
+      /// \return pointer to the slot, or \c nullptr if not found
+      const slot* find_slot( std::uint64_t hash ) const noexcept;
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// \brief A suggestion index that precomputes the deletions of every
+    ///        argument (the symmetric-delete, or SymSpell, scheme)
+    ///
+    /// Two strings within \c k edits of each other share a string that is
+    /// reachable by at most \c k deletions from each. Every deletion of up to
+    /// max_edits characters from each argument is hashed into a table, and a
+    /// search only verifies the arguments that share a deletion with the
+    /// query: a few dozen hash probes, rather than a scan.
+    ///
+    /// Deletions are only taken from the first and the last window_length
+    /// characters, which bounds the table to a few dozen keys per argument
+    /// without losing any matches: a match must share a deletion of both
+    /// windows, so the candidates are the intersection of the two. Arguments
+    /// are stored once, in a single string arena; the table stores only
+    /// 64-bit key hashes and ranges of argument indices. Hash collisions only
+    /// add candidates, which verification discards.
+    ///
+    /// Searches for a distance greater than max_edits are still correct,
+    /// but fall back to scoring every argument.
+    //////////////////////////////////////////////////////////////////////////
+    class symspell_index
+    {
+      //----------------------------------------------------------------------
+      // Public Member Types
+      //----------------------------------------------------------------------
+    public:
+
+      using size_type        = symspell_view::size_type;
+      using distance_fn_type = symspell_view::distance_fn_type;
+      using metric_type      = symspell_view::metric_type;
+
+      /// The largest number of deletions precomputed for each argument
+      static constexpr size_type max_edits = symspell_view::max_edits;
+
+      /// The number of leading, and trailing, characters that deletions are
+      /// taken from
+      static constexpr size_type window_length = symspell_view::window_length;
+
+      //----------------------------------------------------------------------
+      // Constructors
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs an index of the arguments in <tt>[first, last)</tt>
+      ///
+      /// \param first the start of the range of arguments
+      /// \param last the end of the range of arguments
+      /// \param fn the bounded distance function used for searches
+      template<typename InputIt>
+      symspell_index( InputIt first, InputIt last, metric_type fn );
+
+      //----------------------------------------------------------------------
+      // Capacity
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Returns the number of indexed arguments
+      ///
+      /// \return the number of arguments
+      size_type size() const noexcept;
+
+      /// \brief Returns the number of bytes used by this index, excluding
+      ///        the object itself
+      ///
+      /// \return the memory usage in bytes
+      size_type memory_usage() const noexcept;
+
+      //----------------------------------------------------------------------
+      // Search
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Calls \p visitor with each argument, and its distance,
+      ///        that is within \p max of \p query
+      ///
+      /// \param query the string to search for
+      /// \param max the largest distance to report
+      /// \param visitor a function callable as
+      ///        <tt>visitor(stl::string_view, size_type)</tt>
+      /// \return the number of arguments that were scored
+      template<typename Visitor>
+      size_type search( stl::string_view query,
+                        size_type max,
+                        Visitor&& visitor ) const;
+
+      /// \brief Returns a view of the tables of this index
+      ///
+      /// The view is invalidated by destroying, or assigning to, this index
+      ///
+      /// \return the view
+      symspell_view view() const noexcept;
+
+      //----------------------------------------------------------------------
+      // Persistence
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Writes the tables of this index to \p out, in the format
+      ///        read by mapped_symspell_index
+      ///
+      /// The file holds no pointers, so it can be searched in place from
+      /// wherever it is mapped. The distance function is not stored, and
+      /// must be supplied again when the file is opened. Errors are reported
+      /// through the state of \p out.
+      ///
+      /// \param out the stream to write to; opened in binary mode
+      void save( std::ostream& out ) const;
+
+      //----------------------------------------------------------------------
+      // Private Member Types
+      //----------------------------------------------------------------------
+    private:
+
+      using slot = symspell_view::slot;
+
+      //----------------------------------------------------------------------
+      // Private Members
+      //----------------------------------------------------------------------
+    private:
+
+      metric_type                m_distance_fn; ///< The function used for computing distance
+      std::vector<char>          m_arena;       ///< The text of every argument
+      std::vector<std::uint32_t> m_offsets;     ///< The start of each argument, and the end
+      std::vector<slot>          m_slots;       ///< The open-addressed deletion table
+      std::vector<std::uint32_t> m_postings;    ///< The arguments of each deletion
+
+      //----------------------------------------------------------------------
+      // Private Member Functions
+      //----------------------------------------------------------------------
+    private:
+
+      /// \brief Builds the arena and deletion table from \p args
+      ///
+      /// \param args the arguments to index
+      void build( const std::vector<std::string>& args );
+    };
+
+  } // namespace tools
+} // namespace bit
+
+#include "detail/symspell_index.inl"
+
+#endif // BIT_TOOLS_SYMSPELL_INDEX_HPP
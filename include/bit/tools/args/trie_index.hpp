@@ -0,0 +1,267 @@
+#ifndef BIT_TOOLS_TRIE_INDEX_HPP
+#define BIT_TOOLS_TRIE_INDEX_HPP
+
+#include "distance_metric.hpp"
+
+#include <bit/stl/string_view.hpp>
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+#include <string>  // std::string
+#include <utility> // std::forward, std::move
+#include <vector>  // std::vector
+
+namespace bit {
+  namespace tools {
+
+    class levenshtein_automaton;
+
+    //////////////////////////////////////////////////////////////////////////
+    /// \brief A suggestion index that walks a trie of the arguments with a
+    ///        Levenshtein automaton of the query
+    ///
+    /// Only the trie nodes whose prefix is within the maximum distance of
+    /// the query are ever visited, so a search never touches the arguments
+    /// it cannot match. The state of the walk can be kept in a
+    /// levenshtein_automaton, which is advanced by one character at a time
+    /// as a query is typed.
+    ///
+    /// The automaton measures Levenshtein distance. Each match is then
+    /// scored with the distance function, so a function that can be less
+    /// than Levenshtein distance, such as damerau_levenshtein_distance, may
+    /// miss arguments that are only within reach through transpositions.
+    //////////////////////////////////////////////////////////////////////////
+    class trie_index
+    {
+      //----------------------------------------------------------------------
+      // Public Member Types
+      //----------------------------------------------------------------------
+    public:
+
+      using size_type        = std::size_t;
+      using distance_fn_type = std::size_t(*)(stl::string_view,stl::string_view,std::size_t);
+      using metric_type      = distance_function;
+      using automaton_type   = levenshtein_automaton;
+
+      //----------------------------------------------------------------------
+      // Constructors
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs an index of the arguments in <tt>[first, last)</tt>
+      ///
+      /// \param first the start of the range of arguments
+      /// \param last the end of the range of arguments
+      /// \param fn the bounded distance function used for searches
+      template<typename InputIt>
+      trie_index( InputIt first, InputIt last, metric_type fn );
+
+      //----------------------------------------------------------------------
+      // Capacity
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Returns the number of indexed arguments
+      ///
+      /// \return the number of arguments
+      size_type size() const noexcept;
+
+      /// \brief Returns the number of nodes in the trie, including the root
+      ///
+      /// \return the number of nodes
+      size_type node_count() const noexcept;
+
+      //----------------------------------------------------------------------
+      // Search
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Calls \p visitor with each argument, and its distance,
+      ///        that is within \p max of \p query
+      ///
+      /// \param query the string to search for
+      /// \param max the largest distance to report
+      /// \param visitor a function callable as
+      ///        <tt>visitor(stl::string_view, size_type)</tt>
+      /// \return the number of arguments that were scored
+      template<typename Visitor>
+      size_type search( stl::string_view query,
+                        size_type max,
+                        Visitor&& visitor ) const;
+
+      /// \brief Creates an automaton of the empty query, which finds the
+      ///        arguments within \p max edits of it
+      ///
+      /// The automaton refers to this index, and must not outlive it
+      ///
+      /// \param max the largest distance to report
+      /// \return the automaton
+      levenshtein_automaton automaton( size_type max ) const;
+
+      //----------------------------------------------------------------------
+      // Private Member Types
+      //----------------------------------------------------------------------
+    private:
+
+      /// A trie node. Nodes are stored in preorder, so the subtree of a node
+      /// is the range [index, end), and its first child, if any, follows it
+      struct node
+      {
+        std::uint32_t end;   ///< One past the last node of the subtree
+        std::uint32_t arg;   ///< The argument ending here, or no_arg
+        std::uint32_t depth; ///< The length of the prefix
+        char          label; ///< The last character of the prefix
+      };
+
+      static constexpr std::uint32_t no_arg = ~std::uint32_t{0};
+
+      //----------------------------------------------------------------------
+      // Private Members
+      //----------------------------------------------------------------------
+    private:
+
+      metric_type              m_distance_fn; ///< The function used for computing distance
+      std::vector<node>        m_nodes;       ///< The trie, in preorder
+      std::vector<std::string> m_args;        ///< The arguments, in insertion order
+
+      //----------------------------------------------------------------------
+      // Private Member Functions
+      //----------------------------------------------------------------------
+    private:
+
+      /// \brief Builds the trie from \p args
+      ///
+      /// \param args the arguments to index
+      void build( std::vector<std::string> args );
+
+      friend class levenshtein_automaton;
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    /// \brief The state of a Levenshtein automaton of a query, intersected
+    ///        with a trie_index
+    ///
+    /// The state for a query is the set of trie nodes whose prefix is
+    /// within the maximum distance of the query, each with that distance.
+    /// Appending a character computes the next set from the current one,
+    /// rather than from the start, so the cost of a keystroke depends on
+    /// the number of nodes near the query, not on the size of the trie.
+    /// The state of every prefix of the query is kept, so removing the
+    /// last character is free.
+    ///
+    /// The arguments that match the query are the ones that end at a node
+    /// in the current set.
+    //////////////////////////////////////////////////////////////////////////
+    class levenshtein_automaton
+    {
+      //----------------------------------------------------------------------
+      // Public Member Types
+      //----------------------------------------------------------------------
+    public:
+
+      using size_type = std::size_t;
+
+      //----------------------------------------------------------------------
+      // Constructors
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs an automaton of the empty query over \p trie
+      ///
+      /// \param trie the trie to walk; must outlive this automaton
+      /// \param max the largest distance to report
+      levenshtein_automaton( const trie_index& trie, size_type max );
+
+      //----------------------------------------------------------------------
+      // Observers
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Returns the query read so far
+      ///
+      /// \return the query
+      stl::string_view query() const noexcept;
+
+      /// \brief Returns the largest distance reported by this automaton
+      ///
+      /// \return the maximum distance
+      size_type max_distance() const noexcept;
+
+      /// \brief Returns the number of trie nodes within max_distance() of
+      ///        the query
+      ///
+      /// \return the number of active nodes
+      size_type active_count() const noexcept;
+
+      //----------------------------------------------------------------------
+      // Modifiers
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Appends \p c to the query
+      ///
+      /// \param c the character to append
+      void push_back( char c );
+
+      /// \brief Removes the last character of the query
+      ///
+      /// \pre query() is not empty
+      void pop_back() noexcept;
+
+      /// \brief Resets the automaton to the empty query
+      void clear() noexcept;
+
+      //----------------------------------------------------------------------
+      // Search
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Calls \p visitor with each argument, and its distance,
+      ///        that is within max_distance() of the query
+      ///
+      /// \param visitor a function callable as
+      ///        <tt>visitor(stl::string_view, size_type)</tt>
+      /// \return the number of arguments that were scored
+      template<typename Visitor>
+      size_type search( Visitor&& visitor ) const;
+
+      //----------------------------------------------------------------------
+      // Private Member Types
+      //----------------------------------------------------------------------
+    private:
+
+      struct state
+      {
+        std::uint32_t node;     ///< The index of the trie node
+        std::uint32_t distance; ///< The distance of its prefix to the query
+      };
+
+      //----------------------------------------------------------------------
+      // Private Members
+      //----------------------------------------------------------------------
+    private:
+
+      const trie_index*          m_trie;     ///< The trie being walked
+      size_type                  m_max;      ///< The largest distance to report
+      std::string                m_query;    ///< The query read so far
+      std::vector<state>         m_states;   ///< The active set of every prefix of the query
+      std::vector<std::uint32_t> m_levels;   ///< The start of each prefix's active set
+      std::vector<state>         m_scratch;  ///< Storage for computing the next set
+
+      //----------------------------------------------------------------------
+      // Private Member Functions
+      //----------------------------------------------------------------------
+    private:
+
+      /// \brief Adds every descendant of the nodes in \p m_scratch that
+      ///        can be reached by inserting characters, then appends the
+      ///        closest state of each node to m_states as a new level
+      void close_level();
+    };
+
+  } // namespace tools
+} // namespace bit
+
+#include "detail/trie_index.inl"
+
+#endif // BIT_TOOLS_TRIE_INDEX_HPP
@@ -0,0 +1,194 @@
+#ifndef BIT_TOOLS_TRIGRAM_INDEX_HPP
+#define BIT_TOOLS_TRIGRAM_INDEX_HPP
+
+#include "distance_metric.hpp"
+
+#include <bit/stl/string_view.hpp>
+
+#include <algorithm> // std::min
+#include <cstddef>   // std::size_t
+#include <cstdint>   // std::uint8_t, std::uint32_t
+#include <string>    // std::string
+#include <vector>    // std::vector
+
+namespace bit {
+  namespace tools {
+
+    //////////////////////////////////////////////////////////////////////////
+    /// \brief A suggestion index of the trigrams in each argument, for long
+    ///        arguments such as configuration keys and paths
+    ///
+    /// Every edit, transpositions included, overlaps at most four trigram
+    /// positions of the query, so an argument within \c k edits shares all
+    /// but at most \c 4k of the query's distinct trigrams. A search finds
+    /// the arguments that share at least that many by counting their
+    /// occurrences in the posting lists of the query's trigrams, and only
+    /// scores those.
+    ///
+    /// Such an argument must appear in at least one of the \c 4k+1 shortest
+    /// lists, so candidates are gathered from those alone. The longer lists
+    /// are then intersected with the candidates, skipping every block of
+    /// postings that cannot hold one, and candidates are dropped as soon as
+    /// the lists left cannot lift them to the threshold.
+    ///
+    /// Arguments are numbered in order of length, so the arguments within
+    /// \c k of the query's length are a single range of indices, and only
+    /// the blocks of a list that overlap it are decoded. Posting lists are
+    /// delta and varint encoded in blocks of block_size argument indices,
+    /// each block starting from an uncompressed index.
+    ///
+    /// Queries with no more than \c 4k distinct trigrams cannot be filtered,
+    /// and fall back to scoring every argument of a suitable length.
+    //////////////////////////////////////////////////////////////////////////
+    class trigram_index
+    {
+      //----------------------------------------------------------------------
+      // Public Member Types
+      //----------------------------------------------------------------------
+    public:
+
+      using size_type        = std::size_t;
+      using distance_fn_type = std::size_t(*)(stl::string_view,stl::string_view,std::size_t);
+      using metric_type      = distance_function;
+
+      /// The number of argument indices in each block of a posting list
+      static constexpr size_type block_size = 128;
+
+      //----------------------------------------------------------------------
+      // Constructors
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs an index of the arguments in <tt>[first, last)</tt>
+      ///
+      /// \param first the start of the range of arguments
+      /// \param last the end of the range of arguments
+      /// \param fn the bounded distance function used for searches
+      template<typename InputIt>
+      trigram_index( InputIt first, InputIt last, metric_type fn );
+
+      //----------------------------------------------------------------------
+      // Capacity
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Returns the number of indexed arguments
+      ///
+      /// \return the number of arguments
+      size_type size() const noexcept;
+
+      /// \brief Returns the number of bytes used by this index, excluding
+      ///        the object itself
+      ///
+      /// \return the memory usage in bytes
+      size_type memory_usage() const noexcept;
+
+      //----------------------------------------------------------------------
+      // Search
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Calls \p visitor with each argument, and its distance,
+      ///        that is within \p max of \p query
+      ///
+      /// \param query the string to search for
+      /// \param max the largest distance to report
+      /// \param visitor a function callable as
+      ///        <tt>visitor(stl::string_view, size_type)</tt>
+      /// \return the number of arguments that were scored
+      template<typename Visitor>
+      size_type search( stl::string_view query,
+                        size_type max,
+                        Visitor&& visitor ) const;
+
+      //----------------------------------------------------------------------
+      // Private Member Types
+      //----------------------------------------------------------------------
+    private:
+
+      struct posting_list
+      {
+        std::uint32_t first_block; ///< The index of the list's first block
+        std::uint32_t count;       ///< The number of arguments in the list
+      };
+
+      struct block
+      {
+        std::uint32_t first;  ///< The first argument index of the block
+        std::uint32_t offset; ///< The offset of the rest of the block's deltas
+      };
+
+      //----------------------------------------------------------------------
+      // Private Members
+      //----------------------------------------------------------------------
+    private:
+
+      metric_type                m_distance_fn;   ///< The function used for computing distance
+      std::vector<char>          m_arena;         ///< The text of every argument
+      std::vector<std::uint32_t> m_offsets;       ///< The start of each argument, and the end
+      std::vector<std::uint32_t> m_length_starts; ///< The first argument of each length, and the end
+      std::vector<std::uint32_t> m_grams;         ///< Every trigram, in ascending order
+      std::vector<posting_list>  m_lists;         ///< The posting list of each trigram
+      std::vector<block>         m_blocks;        ///< The blocks of every posting list
+      std::vector<std::uint8_t>  m_deltas;        ///< The varint-encoded deltas of every block
+
+      //----------------------------------------------------------------------
+      // Private Member Functions
+      //----------------------------------------------------------------------
+    private:
+
+      /// \brief Sorts \p args by length, and builds the arena and posting
+      ///        lists from them
+      ///
+      /// \param args the arguments to index
+      void build( const std::vector<std::string>& args );
+
+      /// \brief Gets the argument at \p index
+      ///
+      /// \param index the index of the argument
+      /// \return the argument
+      stl::string_view arg( size_type index ) const noexcept;
+
+      /// \brief Collects the indices of the arguments in <tt>[first, last)</tt>
+      ///        that share enough trigrams with \p query to be within \p max
+      ///        of it, in ascending order
+      ///
+      /// \param query the string to search for
+      /// \param max the largest distance to report
+      /// \param first the first index of an argument of a suitable length
+      /// \param last one past the last such index
+      /// \param candidates the vector to store the indices in
+      /// \return \c false if \p query has too few trigrams to filter by
+      bool find_candidates( stl::string_view query,
+                            size_type max,
+                            std::uint32_t first,
+                            std::uint32_t last,
+                            std::vector<std::uint32_t>* candidates ) const;
+
+      /// \brief Finds the block of \p list that would hold \p index
+      ///
+      /// \param list the posting list
+      /// \param from the first block to consider
+      /// \param index the argument index
+      /// \return the index of the block within the list
+      size_type find_block( const posting_list& list,
+                            size_type from,
+                            std::uint32_t index ) const noexcept;
+
+      /// \brief Decodes block \p b of \p list
+      ///
+      /// \param indices storage for at least block_size indices
+      /// \param list the posting list
+      /// \param b the index of the block within the list
+      /// \return the number of indices decoded
+      size_type decode( std::uint32_t* indices,
+                        const posting_list& list,
+                        size_type b ) const noexcept;
+    };
+
+  } // namespace tools
+} // namespace bit
+
+#include "detail/trigram_index.inl"
+
+#endif // BIT_TOOLS_TRIGRAM_INDEX_HPP
@@ -0,0 +1,222 @@
+#ifndef BIT_TOOLS_WEIGHTED_DISTANCE_HPP
+#define BIT_TOOLS_WEIGHTED_DISTANCE_HPP
+
+#include <bit/stl/string_view.hpp>
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint8_t
+
+namespace bit {
+  namespace tools {
+
+    //////////////////////////////////////////////////////////////////////////
+    /// \brief The costs of the edits of a weighted distance, by byte
+    ///
+    /// Every insertion and deletion costs edit(), and every adjacent
+    /// transposition costs transposition(). A substitution costs whatever
+    /// the table holds for its pair of bytes, which starts out as edit() for
+    /// every pair of distinct bytes, and is lowered with
+    /// set_substitution().
+    ///
+    /// The table is a literal type, so tables are meant to be built once,
+    /// at compile time:
+    ///
+    /// \code
+    /// constexpr auto costs = bit::tools::make_qwerty_cost_table();
+    /// \endcode
+    ///
+    /// Every cost must be at least 1, and no substitution may cost more
+    /// than edit(). A distance is then never smaller than the number of
+    /// edits, so the indices of an arg_suggestor, which prune by the number
+    /// of edits, never reject a candidate within the bound.
+    //////////////////////////////////////////////////////////////////////////
+    class edit_cost_table
+    {
+      //----------------------------------------------------------------------
+      // Public Member Types
+      //----------------------------------------------------------------------
+    public:
+
+      using cost_type = std::uint8_t;
+
+      //----------------------------------------------------------------------
+      // Constructors
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Constructs a table in which every edit costs \p edit,
+      ///        except transpositions, which cost \p transposition
+      ///
+      /// \param edit the cost of an insertion, deletion, or substitution
+      /// \param transposition the cost of an adjacent transposition
+      constexpr edit_cost_table( cost_type edit, cost_type transposition ) noexcept;
+
+      //----------------------------------------------------------------------
+      // Modifiers
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Sets the cost of substituting \p lhs for \p rhs, and \p rhs
+      ///        for \p lhs, to \p cost
+      ///
+      /// \param lhs the first byte
+      /// \param rhs the second byte
+      /// \param cost the cost; at least 1 and at most edit()
+      constexpr void set_substitution( char lhs, char rhs, cost_type cost ) noexcept;
+
+      //----------------------------------------------------------------------
+      // Observers
+      //----------------------------------------------------------------------
+    public:
+
+      /// \brief Gets the cost of substituting \p lhs for \p rhs
+      ///
+      /// \param lhs the first byte
+      /// \param rhs the second byte
+      /// \return the cost, which is 0 if \p lhs and \p rhs are equal
+      constexpr cost_type substitution( char lhs, char rhs ) const noexcept;
+
+      /// \brief Gets the cost of an insertion or deletion
+      ///
+      /// \return the cost
+      constexpr cost_type edit() const noexcept;
+
+      /// \brief Gets the cost of an adjacent transposition
+      ///
+      /// \return the cost
+      constexpr cost_type transposition() const noexcept;
+
+      //----------------------------------------------------------------------
+      // Private Members
+      //----------------------------------------------------------------------
+    private:
+
+      cost_type m_substitution[256][256]; ///< The substitution costs
+      cost_type m_edit;                   ///< The insertion and deletion cost
+      cost_type m_transposition;          ///< The transposition cost
+    };
+
+    //------------------------------------------------------------------------
+    // Cost Tables
+    //------------------------------------------------------------------------
+
+    /// \brief Makes the costs of typing errors on a US QWERTY keyboard
+    ///
+    /// Substituting a key for one beside, above or below it costs
+    /// \p adjacent, and substituting a character for the other character
+    /// on the same key, such as \c a and \c A or \c - and \c _, costs
+    /// \p shift. A substitution that is both costs whichever is smaller of
+    /// their sum and \p edit.
+    ///
+    /// \param edit the cost of any other edit
+    /// \param adjacent the cost of substituting a neighbouring key
+    /// \param shift the cost of substituting the other character on a key
+    /// \param transposition the cost of an adjacent transposition
+    /// \return the cost table
+    constexpr edit_cost_table make_qwerty_cost_table( edit_cost_table::cost_type edit = 2,
+                                                      edit_cost_table::cost_type adjacent = 1,
+                                                      edit_cost_table::cost_type shift = 1,
+                                                      edit_cost_table::cost_type transposition = 1 ) noexcept;
+
+    //------------------------------------------------------------------------
+    // Weighted distances
+    //------------------------------------------------------------------------
+
+    /// \brief Computes the weighted distance between \p lhs and \p rhs
+    ///
+    /// This is the optimal string alignment distance, with each edit
+    /// weighted by \p costs.
+    ///
+    /// \param lhs the first string
+    /// \param rhs the second string
+    /// \param costs the costs of each edit
+    /// \return the total cost of the cheapest edits that turn \p lhs into
+    ///         \p rhs
+    std::size_t weighted_distance( stl::string_view lhs,
+                                   stl::string_view rhs,
+                                   const edit_cost_table& costs ) noexcept;
+
+    /// \brief Computes the weighted distance between \p lhs and \p rhs,
+    ///        giving up as soon as it is known to exceed \p max
+    ///
+    /// Only the diagonal band of <tt>max / costs.edit()</tt> insertions or
+    /// deletions is computed, and each row only as far from the diagonal of
+    /// the result as the cheapest cell above it can still afford. Once the
+    /// rest of a row follows from its cheapest cell, each run of matching
+    /// characters along that cell's diagonal is skipped in one step, and
+    /// the computation stops at the first two rows in which every cell
+    /// exceeds \p max.
+    ///
+    /// \param lhs the first string
+    /// \param rhs the second string
+    /// \param costs the costs of each edit
+    /// \param max the largest distance of interest
+    /// \return the distance, or \p max + 1 if the distance exceeds \p max
+    std::size_t weighted_distance( stl::string_view lhs,
+                                   stl::string_view rhs,
+                                   const edit_cost_table& costs,
+                                   std::size_t max ) noexcept;
+
+    /// \brief Computes the weighted distance between \p lhs and \p rhs
+    ///        with the costs \p Costs, giving up as soon as it is known to
+    ///        exceed \p max
+    ///
+    /// This has the signature of a distance_function, so an arg_suggestor
+    /// can be given any table with static storage duration:
+    ///
+    /// \code
+    /// constexpr auto costs = bit::tools::make_qwerty_cost_table( 3, 1, 1, 2 );
+    ///
+    /// auto suggestor = bit::tools::metric_suggestor<bit::tools::distance_function>{
+    ///   first, last, 6, &bit::tools::weighted_distance<costs>
+    /// };
+    /// \endcode
+    ///
+    /// \tparam Costs the costs of each edit
+    /// \param lhs the first string
+    /// \param rhs the second string
+    /// \param max the largest distance of interest
+    /// \return the distance, or \p max + 1 if the distance exceeds \p max
+    template<const edit_cost_table& Costs>
+    std::size_t weighted_distance( stl::string_view lhs,
+                                   stl::string_view rhs,
+                                   std::size_t max ) noexcept;
+
+    /// \brief Computes the weighted distance between \p lhs and \p rhs with
+    ///        the default make_qwerty_cost_table()
+    ///
+    /// A plain edit costs 2, so with an arg_suggestor, a max_distance of 4
+    /// suggests what a max_distance of 2 would with levenshtein_distance,
+    /// and also whatever takes 3 or 4 cheap edits:
+    ///
+    /// \code
+    /// auto suggestor = bit::tools::metric_suggestor<bit::tools::distance_function>{
+    ///   first, last, 4, &bit::tools::keyboard_distance
+    /// };
+    /// \endcode
+    ///
+    /// The table is built at compile time, once, in the library.
+    ///
+    /// \param lhs the first string
+    /// \param rhs the second string
+    /// \return the distance
+    std::size_t keyboard_distance( stl::string_view lhs, stl::string_view rhs ) noexcept;
+
+    /// \brief Computes the weighted distance between \p lhs and \p rhs with
+    ///        the default make_qwerty_cost_table(), giving up as soon as it
+    ///        is known to exceed \p max
+    ///
+    /// \param lhs the first string
+    /// \param rhs the second string
+    /// \param max the largest distance of interest
+    /// \return the distance, or \p max + 1 if the distance exceeds \p max
+    std::size_t keyboard_distance( stl::string_view lhs,
+                                   stl::string_view rhs,
+                                   std::size_t max ) noexcept;
+
+  } // namespace tools
+} // namespace bit
+
+#include "detail/weighted_distance.inl"
+
+#endif // BIT_TOOLS_WEIGHTED_DISTANCE_HPP
@@ -0,0 +1,21 @@
+#include <bit/tools/args/arg_parser.hpp>
+
+//----------------------------------------------------------------------------
+// Explicit Instantiations
+//----------------------------------------------------------------------------
+
+template class bit::tools::basic_arg_set<char>;
+template class bit::tools::basic_single_arg<char>;
+template class bit::tools::basic_multi_arg<char>;
+template class bit::tools::basic_option_arg<char>;
+template class bit::tools::basic_alias_arg<char>;
+template bool bit::tools::parse_arguments( basic_arg_set<char>*,
+                                           basic_arg_vector<char> );
+
+template class bit::tools::basic_arg_set<wchar_t>;
+template class bit::tools::basic_single_arg<wchar_t>;
+template class bit::tools::basic_multi_arg<wchar_t>;
+template class bit::tools::basic_option_arg<wchar_t>;
+template class bit::tools::basic_alias_arg<wchar_t>;
+template bool bit::tools::parse_arguments( basic_arg_set<wchar_t>*,
+                                           basic_arg_vector<wchar_t> );
@@ -1,7 +1,212 @@
 #include <bit/tools/args/arg_suggestor.hpp>
 
 #include <algorithm>
-#include <memory>
+#include <cstdint>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define BIT_TOOLS_ARGS_HAS_SSE2 1
+# include <emmintrin.h>
+#endif
+
+namespace {
+
+  using word_type = bit::tools::detail::distance_word;
+
+  constexpr std::size_t word_bits = bit::tools::detail::distance_word_bits;
+
+  /// The number of 64-bit blocks whose match vectors are kept on the stack
+  /// before falling back to per-thread scratch storage
+  constexpr std::size_t stack_blocks = 4;
+
+  /// The number of cells per row that are kept on the stack by the scalar
+  /// dynamic-programming kernels before falling back to per-thread scratch
+  /// storage
+  constexpr std::size_t stack_cells = bit::tools::detail::distance_stack_cells;
+
+  inline std::size_t to_index( char c ) noexcept
+  {
+    return static_cast<unsigned char>(c);
+  }
+
+  //--------------------------------------------------------------------------
+  // Myers' bit-parallel levenshtein distance
+  //--------------------------------------------------------------------------
+
+  /// \brief Computes the levenshtein distance of \p text and \p pattern
+  ///        using the blocked variant of Myers' algorithm, for patterns
+  ///        longer than a single word
+  ///
+  /// \param text the text
+  /// \param pattern the pattern
+  /// \param peq storage for <tt>blocks * 256</tt> match vectors
+  /// \param vectors storage for <tt>blocks * 2</tt> vertical deltas
+  /// \return the distance
+  std::size_t myers_block_distance( bit::stl::string_view text,
+                                    bit::stl::string_view pattern,
+                                    word_type* peq,
+                                    word_type* vectors )
+    noexcept
+  {
+    const auto blocks = (pattern.size() + word_bits - 1) / word_bits;
+
+    std::fill( peq, peq + blocks * 256, word_type{0} );
+    for( auto i = std::size_t{0}; i < pattern.size(); ++i ) {
+      peq[(i / word_bits) * 256 + to_index(pattern[i])] |= word_type{1} << (i % word_bits);
+    }
+
+    auto* const pvs = vectors;
+    auto* const mvs = vectors + blocks;
+    std::fill( pvs, pvs + blocks, ~word_type{0} );
+    std::fill( mvs, mvs + blocks, word_type{0} );
+
+    const auto last  = word_type{1} << ((pattern.size() - 1) % word_bits);
+    const auto high  = word_type{1} << (word_bits - 1);
+    auto       score = pattern.size();
+
+    for( auto c : text ) {
+      // The horizontal delta carried into each block; the first row always
+      // increases by one
+      auto carry = 1;
+
+      for( auto b = std::size_t{0}; b < blocks; ++b ) {
+        const auto out_bit = (b + 1 == blocks) ? last : high;
+
+        auto       eq = peq[b * 256 + to_index(c)];
+        const auto pv = pvs[b];
+        const auto mv = mvs[b];
+        const auto xv = eq | mv;
+
+        if( carry < 0 ) eq |= 1;
+
+        const auto xh = (((eq & pv) + pv) ^ pv) | eq;
+        auto ph = mv | ~(xh | pv);
+        auto mh = pv & xh;
+
+        const auto out = (ph & out_bit) ? 1 : ((mh & out_bit) ? -1 : 0);
+
+        ph <<= 1;
+        mh <<= 1;
+        if( carry < 0 ) {
+          mh |= 1;
+        } else if( carry > 0 ) {
+          ph |= 1;
+        }
+
+        pvs[b] = mh | ~(xv | ph);
+        mvs[b] = ph & xv;
+        carry  = out;
+      }
+      score += carry;
+    }
+    return score;
+  }
+
+  //--------------------------------------------------------------------------
+  // Optimal string alignment distance
+  //--------------------------------------------------------------------------
+
+  /// \brief Computes the optimal string alignment distance of \p lhs and
+  ///        \p rhs, keeping the last three rows of \p Cell entries
+  ///
+  /// \p rhs must be the shorter of the two strings, and \p rows must have
+  /// room for <tt>3 * (rhs.size() + 1)</tt> entries. \p Cell must be able
+  /// to represent <tt>lhs.size()</tt>
+  ///
+  /// \param lhs the longer string
+  /// \param rhs the shorter string
+  /// \param rows the row storage
+  /// \return the distance
+  template<typename Cell>
+  std::size_t osa_rows( bit::stl::string_view lhs,
+                        bit::stl::string_view rhs,
+                        Cell* rows )
+    noexcept
+  {
+    const auto n     = lhs.size();
+    const auto m     = rhs.size();
+    const auto cells = m + 1;
+
+    auto* before   = rows;             // d[i-2]
+    auto* previous = rows + cells;     // d[i-1]
+    auto* current  = rows + cells * 2; // d[i]
+
+    for( std::size_t j = 0; j <= m; ++j ) {
+      previous[j] = static_cast<Cell>(j);
+    }
+
+    for( std::size_t i = 1; i <= n; ++i ) {
+      current[0] = static_cast<Cell>(i);
+
+      for( std::size_t j = 1; j <= m; ++j ) {
+        const auto cost = std::size_t{lhs[i - 1] == rhs[j - 1] ? 0u : 1u};
+
+        auto best = std::min( std::min<std::size_t>( previous[j], current[j - 1] ) + 1, // deletion, insertion
+                              previous[j - 1] + cost );                                 // substitution
+
+        if( i > 1 && j > 1 && lhs[i - 1] == rhs[j - 2] && lhs[i - 2] == rhs[j - 1] ) {
+          best = std::min<std::size_t>( best, before[j - 2] + 1 );                    // transposition
+        }
+        current[j] = static_cast<Cell>(best);
+      }
+
+      const auto oldest = before;
+      before   = previous;
+      previous = current;
+      current  = oldest;
+    }
+    return previous[m];
+  }
+
+} // anonymous namespace
+
+//----------------------------------------------------------------------------
+// detail
+//----------------------------------------------------------------------------
+
+void bit::tools::detail::trim_affixes( stl::string_view& lhs,
+                                       stl::string_view& rhs )
+  noexcept
+{
+  auto prefix = std::size_t{0};
+  const auto length = std::min( lhs.size(), rhs.size() );
+
+#ifdef BIT_TOOLS_ARGS_HAS_SSE2
+  // Whole blocks of 16 equal bytes are skipped at once; the block holding
+  // the first difference is left to the scalar loop
+  const auto block_equal = []( const char* a, const char* b ) {
+    const auto x = _mm_loadu_si128( reinterpret_cast<const __m128i*>(a) );
+    const auto y = _mm_loadu_si128( reinterpret_cast<const __m128i*>(b) );
+    return _mm_movemask_epi8( _mm_cmpeq_epi8( x, y ) ) == 0xffff;
+  };
+
+  while( prefix + 16 <= length && block_equal( lhs.data() + prefix, rhs.data() + prefix ) ) {
+    prefix += 16;
+  }
+#endif
+  while( prefix < length && lhs[prefix] == rhs[prefix] ) {
+    ++prefix;
+  }
+  lhs.remove_prefix( prefix );
+  rhs.remove_prefix( prefix );
+
+  auto suffix = std::size_t{0};
+  const auto remaining = std::min( lhs.size(), rhs.size() );
+
+#ifdef BIT_TOOLS_ARGS_HAS_SSE2
+  while( suffix + 16 <= remaining &&
+         block_equal( lhs.data() + lhs.size() - suffix - 16,
+                      rhs.data() + rhs.size() - suffix - 16 ) ) {
+    suffix += 16;
+  }
+#endif
+  while( suffix < remaining &&
+         lhs[lhs.size() - suffix - 1] == rhs[rhs.size() - suffix - 1] ) {
+    ++suffix;
+  }
+  lhs.remove_suffix( suffix );
+  rhs.remove_suffix( suffix );
+}
 
 //----------------------------------------------------------------------------
 // levenshtein distances
@@ -11,66 +216,112 @@ std::size_t bit::tools::levenshtein_distance( stl::string_view lhs,
                                               stl::string_view rhs )
   noexcept
 {
-  // algorithm from https://en.wikipedia.org/wiki/Damerau%E2%80%93Levenshtein_distance
+  // The distance never exceeds the length of the longer string
+  return levenshtein_distance( lhs, rhs, std::max( lhs.size(), rhs.size() ) );
+}
+
+std::size_t bit::tools::levenshtein_distance( stl::string_view lhs,
+                                              stl::string_view rhs,
+                                              std::size_t max )
+  noexcept
+{
+  // Bit-parallel algorithm from Myers (1999), "A fast bit-vector algorithm
+  // for approximate string matching based on dynamic programming". This runs
+  // in O(n) word operations when the shorter string fits in a single word,
+  // and in O(n*m/64) otherwise. Long strings with a small bound are instead
+  // restricted to Ukkonen's diagonal band, in O(n*max).
+
+  detail::trim_affixes( lhs, rhs );
+
+  // Use the shorter string as the pattern
+  if( lhs.size() < rhs.size() ) std::swap( lhs, rhs );
 
-  const auto n = lhs.size();
-  const auto m = rhs.size();
-  const auto size = (n * m);
+  // Each character of difference in length requires at least one edit
+  if( lhs.size() - rhs.size() > max ) return max + 1;
 
-  const auto d = std::make_unique<std::size_t[]>(size);
+  if( rhs.empty() ) return lhs.size();
 
-  for(auto i = 0u; i < size; ++i) {
-    d[i] = 0;
+  max = std::min( max, lhs.size() );
+
+  if( rhs.size() <= word_bits ) {
+    return detail::myers_distance( lhs, rhs, max );
   }
 
-  for( std::size_t i = 1, im = 0; i < m; ++i, ++im ) {
-     for( std::size_t j = 1, jn = 0; j < n; ++j, ++jn ) {
-        if (lhs[jn] == rhs[im]) {
-           d[(i * n) + j] = d[((i - 1) * n) + (j - 1)];
-        } else {
-           d[(i * n) + j] = std::min(d[(i - 1) * n + j] + 1, // deletion
-                                std::min(d[i * n + (j - 1)] + 1, // insertion
-                                    d[(i - 1) * n + (j - 1)] + 1)); // substitution
-        }
-     }
+  const auto band_cells = 2 * max + 3;
+
+  if( 2 * max + 1 < rhs.size() ) {
+    if( band_cells <= stack_cells ) {
+      std::size_t band[stack_cells];
+      return detail::levenshtein_band( lhs, rhs, max, band );
+    }
+    return detail::levenshtein_band( lhs, rhs, max, detail::scratch_storage<std::size_t>( band_cells ) );
   }
 
-  return d[n * m - 1];
+  const auto blocks = (rhs.size() + word_bits - 1) / word_bits;
+  auto distance = std::size_t{};
+
+  if( blocks <= stack_blocks ) {
+    word_type peq[stack_blocks * 256];
+    word_type vectors[stack_blocks * 2];
+    distance = myers_block_distance( lhs, rhs, peq, vectors );
+  } else {
+    const auto storage = detail::scratch_storage<word_type>( blocks * (256 + 2) );
+    distance = myers_block_distance( lhs, rhs, storage, storage + blocks * 256 );
+  }
+  return std::min( distance, max + 1 );
 }
 
 //----------------------------------------------------------------------------
 
-std::size_t bit::tools::damerau_levenshtien_distance( stl::string_view lhs,
+std::size_t bit::tools::damerau_levenshtein_distance( stl::string_view lhs,
                                                       stl::string_view rhs )
   noexcept
 {
-  // algorithm from https://en.wikipedia.org/wiki/Levenshtein_distance
+  return damerau_levenshtein_distance( lhs, rhs, std::max( lhs.size(), rhs.size() ) );
+}
+
+std::size_t bit::tools::damerau_levenshtein_distance( stl::string_view lhs,
+                                                      stl::string_view rhs,
+                                                      std::size_t max )
+  noexcept
+{
+  // Computes the optimal string alignment distance, where adjacent
+  // transpositions count as a single edit. Bit-parallel algorithm from
+  // Hyyrö (2003), "A bit-vector algorithm for computing Levenshtein and
+  // Damerau edit distances"
 
-  const auto n = lhs.size();
-  const auto m = rhs.size();
-  const auto size = (n * m);
+  detail::trim_affixes( lhs, rhs );
 
-  const auto d = std::make_unique<std::size_t[]>(size);
+  if( lhs.size() < rhs.size() ) std::swap( lhs, rhs );
 
-  for(auto i = 0u; i < size; ++i) {
-    d[i] = 0;
+  if( lhs.size() - rhs.size() > max ) return max + 1;
+
+  if( rhs.empty() ) return lhs.size();
+
+  max = std::min( max, lhs.size() );
+
+  if( rhs.size() <= word_bits ) {
+    return detail::hyyro_distance( lhs, rhs, max );
   }
 
-  for( std::size_t i = 1, im = 0; i < m; ++i, ++im ) {
-     for( std::size_t j = 1, jn = 0; j < n; ++j, ++jn ) {
-        if (lhs[jn] == rhs[im]) {
-           d[(i * n) + j] = d[((i - 1) * n) + (j - 1)];
-        } else {
-           d[(i * n) + j] = std::min(d[(i - 1) * n + j] + 1, // deletion
-                                std::min(d[i * n + (j - 1)] + 1, // insertion
-                                    d[(i - 1) * n + (j - 1)] + 1)); // substitution
-        }
-        if( i > 1 && j > 1 && lhs[i] == rhs[j-1] && lhs[i-1] == rhs[j] ) {
-          d[(i * n) + j] = std::min(d[ (i * n) + j ], d[ (i - 2) * n + j - 2] + 1);
-        }
-     }
+  const auto band_cells = 3 * (2 * max + 3);
+
+  if( 2 * max + 1 < rhs.size() ) {
+    if( band_cells <= stack_cells * 3 ) {
+      std::size_t band[stack_cells * 3];
+      return detail::osa_band( lhs, rhs, max, band );
+    }
+    return detail::osa_band( lhs, rhs, max, detail::scratch_storage<std::size_t>( band_cells ) );
   }
 
-  return d[n * m - 1];
-}
+  const auto cells = rhs.size() + 1;
+  auto distance = std::size_t{};
 
+  if( cells <= stack_cells && lhs.size() <= 0xffff ) {
+    std::uint16_t rows[stack_cells * 3];
+    distance = osa_rows( lhs, rhs, rows );
+  } else {
+    distance = osa_rows( lhs, rhs, detail::scratch_storage<std::size_t>( cells * 3 ) );
+  }
+  return std::min( distance, max + 1 );
+}
@@ -0,0 +1,329 @@
+#include <bit/tools/args/arg_transcoder.hpp>
+
+#include <cstdint>     // std::uint32_t
+#include <cstring>     // std::memcpy
+#include <type_traits> // std::make_unsigned
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define BIT_TOOLS_ARGS_HAS_SSE2 1
+# include <emmintrin.h>
+#endif
+
+namespace {
+
+  //--------------------------------------------------------------------------
+  // ASCII Fast Path
+  //--------------------------------------------------------------------------
+
+  template<typename CharT>
+  std::uint32_t code_unit( CharT c ) noexcept
+  {
+    return static_cast<std::uint32_t>(static_cast<typename std::make_unsigned<CharT>::type>(c));
+  }
+
+  /// \brief Counts the leading ASCII code units of \p src, copying them
+  ///        into \p dst as they are scanned when \p Store is \c true
+  ///
+  /// Full blocks of 16 bytes are checked (and narrowed) with SSE2 where
+  /// available, with the remainder handled one unit at a time.
+  ///
+  /// \param src the source code units
+  /// \param n the number of source code units
+  /// \param dst the destination for the narrowed units
+  /// \return the number of leading ASCII code units
+  template<bool Store, typename CharT>
+  std::size_t ascii_run( const CharT* src, std::size_t n, char* dst ) noexcept
+  {
+    auto i = std::size_t{0};
+
+#ifdef BIT_TOOLS_ARGS_HAS_SSE2
+    if( sizeof(CharT) == 2 ) {
+      const auto mask = _mm_set1_epi16( static_cast<short>(0xff80) );
+      const auto zero = _mm_setzero_si128();
+
+      for( ; i + 8 <= n; i += 8 ) {
+        const auto v = _mm_loadu_si128( reinterpret_cast<const __m128i*>(src + i) );
+        const auto ascii = _mm_cmpeq_epi16( _mm_and_si128( v, mask ), zero );
+        if( _mm_movemask_epi8( ascii ) != 0xffff ) break;
+
+        if( Store ) {
+          // Every lane is below 0x80, so the saturating pack is exact
+          _mm_storel_epi64( reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16( v, v ) );
+        }
+      }
+    } else if( sizeof(CharT) == 4 ) {
+      const auto mask = _mm_set1_epi32( static_cast<int>(0xffffff80) );
+      const auto zero = _mm_setzero_si128();
+
+      for( ; i + 4 <= n; i += 4 ) {
+        const auto v = _mm_loadu_si128( reinterpret_cast<const __m128i*>(src + i) );
+        const auto ascii = _mm_cmpeq_epi32( _mm_and_si128( v, mask ), zero );
+        if( _mm_movemask_epi8( ascii ) != 0xffff ) break;
+
+        if( Store ) {
+          const auto words = _mm_packs_epi32( v, v );
+          const auto bytes = _mm_cvtsi128_si32( _mm_packus_epi16( words, words ) );
+          std::memcpy( dst + i, &bytes, 4 );
+        }
+      }
+    }
+#endif
+
+    for( ; i < n; ++i ) {
+      const auto c = code_unit( src[i] );
+      if( c >= 0x80 ) break;
+      if( Store ) dst[i] = static_cast<char>(c);
+    }
+    return i;
+  }
+
+  //--------------------------------------------------------------------------
+  // Decoding
+  //--------------------------------------------------------------------------
+
+  /// \brief Decodes the code point at \p src[*i], advancing \p i past it
+  ///
+  /// UTF-16 is assumed for 16-bit code units, UTF-32 otherwise
+  ///
+  /// \param src the source code units
+  /// \param n the number of source code units
+  /// \param i the index of the code point to decode
+  /// \param cp the decoded code point
+  /// \return \c false if the input is not a valid code point
+  template<typename CharT>
+  bool decode( const CharT* src, std::size_t n, std::size_t* i, std::uint32_t* cp ) noexcept
+  {
+    const auto c = code_unit( src[*i] );
+
+    if( sizeof(CharT) == 2 ) {
+      if( (c & 0xfc00) == 0xd800 ) {
+        // A high surrogate must be immediately followed by a low surrogate
+        if( *i + 1 >= n ) return false;
+
+        const auto low = code_unit( src[*i + 1] );
+        if( (low & 0xfc00) != 0xdc00 ) return false;
+
+        *cp = 0x10000 + ((c - 0xd800) << 10) + (low - 0xdc00);
+        *i += 2;
+        return true;
+      }
+      if( (c & 0xfc00) == 0xdc00 ) return false;
+    } else {
+      if( c > 0x10ffff || (c >= 0xd800 && c <= 0xdfff) ) return false;
+    }
+
+    *cp = c;
+    *i += 1;
+    return true;
+  }
+
+  std::size_t utf8_size( std::uint32_t cp ) noexcept
+  {
+    if( cp < 0x80 )    return 1;
+    if( cp < 0x800 )   return 2;
+    if( cp < 0x10000 ) return 3;
+    return 4;
+  }
+
+  char* encode( std::uint32_t cp, char* dst ) noexcept
+  {
+    if( cp < 0x80 ) {
+      *dst++ = static_cast<char>(cp);
+    } else if( cp < 0x800 ) {
+      *dst++ = static_cast<char>(0xc0 | (cp >> 6));
+      *dst++ = static_cast<char>(0x80 | (cp & 0x3f));
+    } else if( cp < 0x10000 ) {
+      *dst++ = static_cast<char>(0xe0 | (cp >> 12));
+      *dst++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3f));
+      *dst++ = static_cast<char>(0x80 | (cp & 0x3f));
+    } else {
+      *dst++ = static_cast<char>(0xf0 | (cp >> 18));
+      *dst++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3f));
+      *dst++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3f));
+      *dst++ = static_cast<char>(0x80 | (cp & 0x3f));
+    }
+    return dst;
+  }
+
+  //--------------------------------------------------------------------------
+
+  /// \brief Computes the number of UTF-8 bytes required to encode \p src,
+  ///        validating it in the process
+  ///
+  /// \param src the source code units
+  /// \param n the number of source code units
+  /// \param size the computed size
+  /// \return \c true if \p src is valid
+  template<typename CharT>
+  bool measure( const CharT* src, std::size_t n, std::size_t* size ) noexcept
+  {
+    auto i     = std::size_t{0};
+    auto bytes = std::size_t{0};
+
+    while( i < n ) {
+      const auto ascii = ascii_run<false>( src + i, n - i, nullptr );
+      i     += ascii;
+      bytes += ascii;
+
+      if( i == n ) break;
+
+      auto cp = std::uint32_t{};
+      if( !decode( src, n, &i, &cp ) ) return false;
+      bytes += utf8_size( cp );
+    }
+    *size = bytes;
+    return true;
+  }
+
+  /// \brief Transcodes the previously validated \p src into \p dst
+  ///
+  /// \param src the source code units
+  /// \param n the number of source code units
+  /// \param dst the destination buffer
+  /// \return pointer past the last written byte
+  template<typename CharT>
+  char* transcode( const CharT* src, std::size_t n, char* dst ) noexcept
+  {
+    auto i = std::size_t{0};
+
+    while( i < n ) {
+      const auto ascii = ascii_run<true>( src + i, n - i, dst );
+      i   += ascii;
+      dst += ascii;
+
+      if( i == n ) break;
+
+      auto cp = std::uint32_t{};
+      decode( src, n, &i, &cp );
+      dst = encode( cp, dst );
+    }
+    return dst;
+  }
+
+} // anonymous namespace
+
+//============================================================================
+// detail::arg_transcoder
+//============================================================================
+
+namespace bit {
+  namespace tools {
+    namespace detail {
+
+      struct arg_transcoder
+      {
+        template<typename CharT, typename Traits>
+        static bool transcode_all( transcoded_arg_vector* result,
+                                   basic_arg_vector<CharT,Traits> args );
+      };
+
+    } // namespace detail
+  } // namespace tools
+} // namespace bit
+
+template<typename CharT, typename Traits>
+bool bit::tools::detail::arg_transcoder
+  ::transcode_all( transcoded_arg_vector* result,
+                   basic_arg_vector<CharT,Traits> args )
+{
+  if( !result ) return false;
+
+  const auto argc = args.size();
+
+  // Validate every argument and size the buffer before allocating anything
+  auto text_size = std::size_t{0};
+  for( auto arg : args ) {
+    auto size = std::size_t{};
+    if( !measure( arg.data(), arg.size(), &size ) ) return false;
+    text_size += size + 1;
+  }
+
+  // The table ends in a null pointer, as argv does
+  const auto table_size = (argc + 1) * sizeof(const char*);
+  auto buffer = std::unique_ptr<char[]>( new char[table_size + text_size] );
+
+  auto table = reinterpret_cast<const char**>(buffer.get());
+  auto text  = buffer.get() + table_size;
+
+  for( auto i = std::size_t{0}; i < argc; ++i ) {
+    const auto arg = args[static_cast<std::ptrdiff_t>(i)];
+
+    table[i] = text;
+    text     = ::transcode( arg.data(), arg.size(), text );
+    *text++  = '\0';
+  }
+  table[argc] = nullptr;
+
+  result->m_buffer = std::move(buffer);
+  result->m_argc   = static_cast<int>(argc);
+  return true;
+}
+
+//============================================================================
+// transcoded_arg_vector
+//============================================================================
+
+//----------------------------------------------------------------------------
+// Constructor
+//----------------------------------------------------------------------------
+
+bit::tools::transcoded_arg_vector::transcoded_arg_vector()
+  noexcept
+  : m_buffer(),
+    m_argc(0)
+{
+
+}
+
+//----------------------------------------------------------------------------
+// Capacity
+//----------------------------------------------------------------------------
+
+bool bit::tools::transcoded_arg_vector::empty()
+  const noexcept
+{
+  return m_argc == 0;
+}
+
+bit::tools::transcoded_arg_vector::size_type
+  bit::tools::transcoded_arg_vector::size()
+  const noexcept
+{
+  return static_cast<size_type>(m_argc);
+}
+
+//----------------------------------------------------------------------------
+// Element Access
+//----------------------------------------------------------------------------
+
+bit::tools::arg_vector bit::tools::transcoded_arg_vector::args()
+  const noexcept
+{
+  // An empty vector still has the null pointer that ends argv
+  static const char* const empty[] = { nullptr };
+
+  if( !m_buffer ) return arg_vector( 0, empty );
+  return arg_vector( m_argc, reinterpret_cast<const char* const*>(m_buffer.get()) );
+}
+
+//============================================================================
+// Transcoding
+//============================================================================
+
+bool bit::tools::transcode_arguments( transcoded_arg_vector* result,
+                                      u16arg_vector args )
+{
+  return detail::arg_transcoder::transcode_all( result, args );
+}
+
+bool bit::tools::transcode_arguments( transcoded_arg_vector* result,
+                                      u32arg_vector args )
+{
+  return detail::arg_transcoder::transcode_all( result, args );
+}
+
+bool bit::tools::transcode_arguments( transcoded_arg_vector* result,
+                                      warg_vector args )
+{
+  return detail::arg_transcoder::transcode_all( result, args );
+}
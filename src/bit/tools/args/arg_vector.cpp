@@ -0,0 +1,11 @@
+#include <bit/tools/args/arg_vector.hpp>
+
+//----------------------------------------------------------------------------
+// Explicit Instantiations
+//----------------------------------------------------------------------------
+
+template class bit::tools::arg_vector_iterator<char>;
+template class bit::tools::basic_arg_vector<char>;
+
+template class bit::tools::arg_vector_iterator<wchar_t>;
+template class bit::tools::basic_arg_vector<wchar_t>;
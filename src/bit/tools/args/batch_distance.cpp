@@ -0,0 +1,453 @@
+#include <bit/tools/args/distance_metric.hpp>
+
+#include <algorithm> // std::min, std::max
+#include <cstdint>   // std::uint64_t
+#include <limits>    // std::numeric_limits
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define BIT_TOOLS_ARGS_HAS_SSE2 1
+# include <emmintrin.h>
+#endif
+
+// AVX2 is compiled with a target attribute, and selected at runtime, so that
+// the library itself does not require AVX2
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+# define BIT_TOOLS_ARGS_HAS_AVX2_DISPATCH 1
+# include <immintrin.h>
+#endif
+
+namespace {
+
+  using word_type = std::uint64_t;
+
+  constexpr std::size_t word_bits = 64;
+
+  /// The number of candidates scored together by each kernel
+  constexpr std::size_t batch_lanes = 8;
+
+  /// The largest batch that is scored with the scalar kernel regardless of
+  /// the vector units available
+  constexpr std::size_t scalar_lanes = 2;
+
+  /// The number of columns after which the vector kernels check whether
+  /// any lane can still come within the bound
+  constexpr std::size_t retire_columns = 8;
+
+  /// The bound of an unbounded batch, which leaves room to add a length
+  constexpr std::size_t unbounded = std::numeric_limits<std::size_t>::max() / 2;
+
+  inline std::size_t to_index( char c ) noexcept
+  {
+    return static_cast<unsigned char>(c);
+  }
+
+  //--------------------------------------------------------------------------
+  // Lane Layout
+  //--------------------------------------------------------------------------
+
+  /// The number of columns that are transposed into a batch_block at once
+  constexpr std::size_t block_columns = 32;
+
+  /// \brief A block of consecutive columns of a batch, laid out so that
+  ///        each column holds one entry per lane
+  ///
+  /// Each entry holds the match vector for the lane's candidate character,
+  /// and whether the lane is still active. Candidates shorter than the
+  /// longest in the batch are padded with inactive columns, whose updates
+  /// are discarded.
+  struct alignas(32) batch_block
+  {
+    word_type eq[block_columns][batch_lanes];
+    word_type active[block_columns][batch_lanes];
+  };
+
+  /// \brief Transposes the columns <tt>[offset, offset + columns)</tt> of
+  ///        the batch \p candidates into \p block
+  ///
+  /// \param peq the match vectors of the query
+  /// \param candidates the candidates in the batch
+  /// \param lanes the number of candidates in the batch
+  /// \param offset the index of the first column
+  /// \param columns the number of columns to load
+  /// \param block the block to load
+  void load_block( const word_type* peq,
+                   const bit::stl::string_view* candidates,
+                   std::size_t lanes,
+                   std::size_t offset,
+                   std::size_t columns,
+                   batch_block* block )
+    noexcept
+  {
+    for( auto lane = std::size_t{0}; lane < batch_lanes; ++lane ) {
+      auto live = std::size_t{0};
+
+      if( lane < lanes && offset < candidates[lane].size() ) {
+        const auto candidate = candidates[lane].substr( offset, columns );
+
+        live = candidate.size();
+        for( auto t = std::size_t{0}; t < live; ++t ) {
+          block->eq[t][lane]     = peq[to_index(candidate[t])];
+          block->active[t][lane] = ~word_type{0};
+        }
+      }
+      for( auto t = live; t < columns; ++t ) {
+        block->eq[t][lane]     = 0;
+        block->active[t][lane] = 0;
+      }
+    }
+  }
+
+  /// \brief Returns the length of the longest of \p candidates
+  std::size_t longest( const bit::stl::string_view* candidates,
+                       std::size_t lanes )
+    noexcept
+  {
+    auto length = std::size_t{0};
+    for( auto lane = std::size_t{0}; lane < lanes; ++lane ) {
+      length = std::max( length, candidates[lane].size() );
+    }
+    return length;
+  }
+
+  /// \brief Returns whether every lane has either run out of columns after
+  ///        the first \p columns, or can no longer come within \p max
+  ///
+  /// The score of a lane can decrease by at most one per remaining column,
+  /// so a lane whose score exceeds \p max by more than that is retired.
+  ///
+  /// \param candidates the candidates in the batch
+  /// \param lanes the number of candidates in the batch
+  /// \param columns the number of columns scored so far
+  /// \param max the largest distance of interest
+  /// \param scores the score of each lane after \p columns columns
+  bool retired( const bit::stl::string_view* candidates,
+                std::size_t lanes,
+                std::size_t columns,
+                std::size_t max,
+                const word_type* scores )
+    noexcept
+  {
+    for( auto lane = std::size_t{0}; lane < lanes; ++lane ) {
+      const auto size = candidates[lane].size();
+      if( size > columns && scores[lane] <= max + (size - columns) ) return false;
+    }
+    return true;
+  }
+
+  //--------------------------------------------------------------------------
+  // Kernels
+  //--------------------------------------------------------------------------
+
+  /// The signature of each batch kernel. Each kernel computes the
+  /// distances from a query of \p m characters, with match vectors \p peq,
+  /// to up to batch_lanes \p candidates, or \p max + 1 for those that
+  /// exceed \p max
+  using kernel_type = void(*)( const word_type* peq,
+                               std::size_t m,
+                               const bit::stl::string_view* candidates,
+                               std::size_t lanes,
+                               std::size_t max,
+                               std::size_t* distances );
+
+  /// \brief Scores each candidate in turn with Myers' algorithm, for hosts
+  ///        without a vector unit
+  void scalar_kernel( const word_type* peq,
+                      std::size_t m,
+                      const bit::stl::string_view* candidates,
+                      std::size_t lanes,
+                      std::size_t max,
+                      std::size_t* distances )
+    noexcept
+  {
+    const auto last = word_type{1} << (m - 1);
+
+    for( auto lane = std::size_t{0}; lane < lanes; ++lane ) {
+      auto pv        = ~word_type{0};
+      auto mv        = word_type{0};
+      auto score     = m;
+      auto remaining = candidates[lane].size();
+
+      for( auto c : candidates[lane] ) {
+        const auto eq = peq[to_index(c)];
+        const auto xv = eq | mv;
+        const auto xh = (((eq & pv) + pv) ^ pv) | eq;
+
+        auto ph = mv | ~(xh | pv);
+        auto mh = pv & xh;
+
+        if( ph & last ) {
+          ++score;
+        } else if( mh & last ) {
+          --score;
+        }
+
+        // The score can decrease by at most one per remaining column
+        if( score > max + --remaining ) break;
+
+        ph = (ph << 1) | 1;
+        mh = (mh << 1);
+
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+      }
+      distances[lane] = std::min( score, max + 1 );
+    }
+  }
+
+#ifdef BIT_TOOLS_ARGS_HAS_SSE2
+
+  /// \brief Scores batch_lanes candidates at once, two 64-bit lanes per
+  ///        SSE2 register
+  void sse2_kernel( const word_type* peq,
+                    std::size_t m,
+                    const bit::stl::string_view* candidates,
+                    std::size_t lanes,
+                    std::size_t max,
+                    std::size_t* distances )
+    noexcept
+  {
+    constexpr auto registers = batch_lanes / 2;
+
+    const auto ones  = _mm_set1_epi64x( -1 );
+    const auto one   = _mm_set1_epi64x( 1 );
+    const auto shift = _mm_cvtsi32_si128( static_cast<int>(m - 1) );
+
+    __m128i pv[registers], mv[registers], score[registers];
+    for( auto r = 0u; r < registers; ++r ) {
+      pv[r]    = ones;
+      mv[r]    = _mm_setzero_si128();
+      score[r] = _mm_set1_epi64x( static_cast<long long>(m) );
+    }
+
+    const auto length = longest( candidates, lanes );
+    batch_block block;
+    alignas(16) word_type result[batch_lanes];
+
+    for( auto t = std::size_t{0}; t < length; ++t ) {
+      const auto column = t % block_columns;
+      if( column == 0 ) {
+        load_block( peq, candidates, lanes, t, std::min( block_columns, length - t ), &block );
+      }
+
+      for( auto r = 0u; r < registers; ++r ) {
+        const auto eq     = _mm_load_si128( reinterpret_cast<const __m128i*>(block.eq[column]) + r );
+        const auto active = _mm_load_si128( reinterpret_cast<const __m128i*>(block.active[column]) + r );
+
+        const auto xv = _mm_or_si128( eq, mv[r] );
+        const auto sum = _mm_add_epi64( _mm_and_si128( eq, pv[r] ), pv[r] );
+        const auto xh = _mm_or_si128( _mm_xor_si128( sum, pv[r] ), eq );
+
+        auto ph = _mm_or_si128( mv[r], _mm_andnot_si128( _mm_or_si128( xh, pv[r] ), ones ) );
+        auto mh = _mm_and_si128( pv[r], xh );
+
+        // The bits in the last row are exclusive, so their difference is
+        // the change in score
+        const auto up   = _mm_and_si128( _mm_srl_epi64( ph, shift ), one );
+        const auto down = _mm_and_si128( _mm_srl_epi64( mh, shift ), one );
+        score[r] = _mm_add_epi64( score[r], _mm_and_si128( _mm_sub_epi64( up, down ), active ) );
+
+        ph = _mm_or_si128( _mm_slli_epi64( ph, 1 ), one );
+        mh = _mm_slli_epi64( mh, 1 );
+
+        const auto next_pv = _mm_or_si128( mh, _mm_andnot_si128( _mm_or_si128( xv, ph ), ones ) );
+        const auto next_mv = _mm_and_si128( ph, xv );
+
+        pv[r] = _mm_or_si128( _mm_and_si128( active, next_pv ), _mm_andnot_si128( active, pv[r] ) );
+        mv[r] = _mm_or_si128( _mm_and_si128( active, next_mv ), _mm_andnot_si128( active, mv[r] ) );
+      }
+
+      if( (t + 1) % retire_columns == 0 && t + 1 < length ) {
+        for( auto r = 0u; r < registers; ++r ) {
+          _mm_store_si128( reinterpret_cast<__m128i*>(result) + r, score[r] );
+        }
+        if( retired( candidates, lanes, t + 1, max, result ) ) break;
+      }
+    }
+
+    for( auto r = 0u; r < registers; ++r ) {
+      _mm_store_si128( reinterpret_cast<__m128i*>(result) + r, score[r] );
+    }
+    for( auto lane = std::size_t{0}; lane < lanes; ++lane ) {
+      distances[lane] = std::min( static_cast<std::size_t>(result[lane]), max + 1 );
+    }
+  }
+
+#endif
+
+#ifdef BIT_TOOLS_ARGS_HAS_AVX2_DISPATCH
+
+  /// \brief Scores batch_lanes candidates at once, four 64-bit lanes per
+  ///        AVX2 register
+  __attribute__((target("avx2")))
+  void avx2_kernel( const word_type* peq,
+                    std::size_t m,
+                    const bit::stl::string_view* candidates,
+                    std::size_t lanes,
+                    std::size_t max,
+                    std::size_t* distances )
+    noexcept
+  {
+    constexpr auto registers = batch_lanes / 4;
+
+    const auto ones  = _mm256_set1_epi64x( -1 );
+    const auto one   = _mm256_set1_epi64x( 1 );
+    const auto shift = _mm_cvtsi32_si128( static_cast<int>(m - 1) );
+
+    __m256i pv[registers], mv[registers], score[registers];
+    for( auto r = 0u; r < registers; ++r ) {
+      pv[r]    = ones;
+      mv[r]    = _mm256_setzero_si256();
+      score[r] = _mm256_set1_epi64x( static_cast<long long>(m) );
+    }
+
+    const auto length = longest( candidates, lanes );
+    batch_block block;
+    alignas(32) word_type result[batch_lanes];
+
+    for( auto t = std::size_t{0}; t < length; ++t ) {
+      const auto column = t % block_columns;
+      if( column == 0 ) {
+        load_block( peq, candidates, lanes, t, std::min( block_columns, length - t ), &block );
+      }
+
+      for( auto r = 0u; r < registers; ++r ) {
+        const auto eq     = _mm256_load_si256( reinterpret_cast<const __m256i*>(block.eq[column]) + r );
+        const auto active = _mm256_load_si256( reinterpret_cast<const __m256i*>(block.active[column]) + r );
+
+        const auto xv = _mm256_or_si256( eq, mv[r] );
+        const auto sum = _mm256_add_epi64( _mm256_and_si256( eq, pv[r] ), pv[r] );
+        const auto xh = _mm256_or_si256( _mm256_xor_si256( sum, pv[r] ), eq );
+
+        auto ph = _mm256_or_si256( mv[r], _mm256_andnot_si256( _mm256_or_si256( xh, pv[r] ), ones ) );
+        auto mh = _mm256_and_si256( pv[r], xh );
+
+        const auto up   = _mm256_and_si256( _mm256_srl_epi64( ph, shift ), one );
+        const auto down = _mm256_and_si256( _mm256_srl_epi64( mh, shift ), one );
+        score[r] = _mm256_add_epi64( score[r], _mm256_and_si256( _mm256_sub_epi64( up, down ), active ) );
+
+        ph = _mm256_or_si256( _mm256_slli_epi64( ph, 1 ), one );
+        mh = _mm256_slli_epi64( mh, 1 );
+
+        const auto next_pv = _mm256_or_si256( mh, _mm256_andnot_si256( _mm256_or_si256( xv, ph ), ones ) );
+        const auto next_mv = _mm256_and_si256( ph, xv );
+
+        pv[r] = _mm256_blendv_epi8( pv[r], next_pv, active );
+        mv[r] = _mm256_blendv_epi8( mv[r], next_mv, active );
+      }
+
+      if( (t + 1) % retire_columns == 0 && t + 1 < length ) {
+        for( auto r = 0u; r < registers; ++r ) {
+          _mm256_store_si256( reinterpret_cast<__m256i*>(result) + r, score[r] );
+        }
+        if( retired( candidates, lanes, t + 1, max, result ) ) break;
+      }
+    }
+
+    for( auto r = 0u; r < registers; ++r ) {
+      _mm256_store_si256( reinterpret_cast<__m256i*>(result) + r, score[r] );
+    }
+    for( auto lane = std::size_t{0}; lane < lanes; ++lane ) {
+      distances[lane] = std::min( static_cast<std::size_t>(result[lane]), max + 1 );
+    }
+  }
+
+#endif
+
+  //--------------------------------------------------------------------------
+  // Dispatch
+  //--------------------------------------------------------------------------
+
+  /// \brief Selects the widest kernel supported by the host
+  kernel_type select_kernel() noexcept
+  {
+#ifdef BIT_TOOLS_ARGS_HAS_AVX2_DISPATCH
+    __builtin_cpu_init();
+    if( __builtin_cpu_supports("avx2") ) return &avx2_kernel;
+#endif
+#ifdef BIT_TOOLS_ARGS_HAS_SSE2
+    return &sse2_kernel;
+#else
+    return &scalar_kernel;
+#endif
+  }
+
+} // anonymous namespace
+
+//----------------------------------------------------------------------------
+// Batched levenshtein distance
+//----------------------------------------------------------------------------
+
+void bit::tools::levenshtein_distances( std::size_t* distances,
+                                        stl::string_view query,
+                                        const stl::string_view* candidates,
+                                        std::size_t count )
+  noexcept
+{
+  levenshtein_distances( distances, query, candidates, count, unbounded );
+}
+
+void bit::tools::levenshtein_distances( std::size_t* distances,
+                                        stl::string_view query,
+                                        const stl::string_view* candidates,
+                                        std::size_t count,
+                                        std::size_t max )
+  noexcept
+{
+  if( query.empty() ) {
+    for( auto i = std::size_t{0}; i < count; ++i ) {
+      distances[i] = std::min( candidates[i].size(), max + 1 );
+    }
+    return;
+  }
+
+  // The query is the pattern of every lane, so it must fit in a word
+  if( query.size() > word_bits ) {
+    for( auto i = std::size_t{0}; i < count; ++i ) {
+      distances[i] = levenshtein_distance( query, candidates[i], max );
+    }
+    return;
+  }
+
+  static const auto kernel = select_kernel();
+
+  // The match vectors are kept zeroed between calls, and only the entries
+  // of the query are set and cleared again, since clearing all of them
+  // costs more than scoring a few candidates
+  thread_local word_type peq[256] = {};
+  for( auto i = std::size_t{0}; i < query.size(); ++i ) {
+    peq[to_index(query[i])] |= word_type{1} << i;
+  }
+
+  for( auto i = std::size_t{0}; i < count; i += batch_lanes ) {
+    const auto lanes = std::min( batch_lanes, count - i );
+
+    // Each character of difference in length requires at least one edit,
+    // so such candidates are left out of the batch, as empty lanes
+    stl::string_view batch[batch_lanes];
+    bool rejected[batch_lanes];
+    auto live = std::size_t{0};
+    for( auto lane = std::size_t{0}; lane < lanes; ++lane ) {
+      const auto size = candidates[i + lane].size();
+      rejected[lane]  = ((size < query.size()) ? (query.size() - size) : (size - query.size())) > max;
+      if( !rejected[lane] ) {
+        batch[lane] = candidates[i + lane];
+        ++live;
+      }
+    }
+
+    // A nearly-empty batch is cheaper to score without padding it out
+    if( live <= scalar_lanes ) {
+      scalar_kernel( peq, query.size(), batch, lanes, max, distances + i );
+    } else {
+      kernel( peq, query.size(), batch, lanes, max, distances + i );
+    }
+
+    for( auto lane = std::size_t{0}; lane < lanes; ++lane ) {
+      if( rejected[lane] ) distances[i + lane] = max + 1;
+    }
+  }
+
+  for( auto c : query ) {
+    peq[to_index(c)] = 0;
+  }
+}
@@ -0,0 +1,75 @@
+#include <bit/tools/args/bk_tree_index.hpp>
+
+#include <algorithm> // std::sort, std::max
+
+//----------------------------------------------------------------------------
+// Private Member Functions
+//----------------------------------------------------------------------------
+
+void bit::tools::bk_tree_index::build( std::vector<std::string> args )
+{
+  if( args.empty() ) return;
+
+  // The tree is first built with a child list per node, and is then laid
+  // out breadth-first into the flat node array
+  struct child
+  {
+    std::uint32_t key;
+    std::uint32_t node;
+  };
+
+  auto children = std::vector<std::vector<child>>( args.size() );
+
+  for( auto i = std::uint32_t{1}; i < args.size(); ++i ) {
+    const auto arg = stl::string_view{ args[i] };
+    auto current   = std::uint32_t{0};
+
+    while( true ) {
+      const auto other = stl::string_view{ args[current] };
+
+      // The longer length is a bound that never truncates the distance
+      const auto key = static_cast<std::uint32_t>(
+        m_distance_fn( arg, other, std::max( arg.size(), other.size() ) )
+      );
+
+      auto& siblings = children[current];
+      const auto it  = std::find_if( siblings.begin(), siblings.end(), [&]( const child& c ) {
+        return c.key == key;
+      });
+
+      if( it == siblings.end() ) {
+        siblings.push_back( child{ key, i } );
+        break;
+      }
+      current = it->node;
+    }
+  }
+
+  // Breadth-first layout. order[n] is the original index of the n'th node
+  auto order = std::vector<std::uint32_t>{};
+  order.reserve( args.size() );
+  order.push_back( 0 );
+
+  m_nodes.reserve( args.size() );
+  m_nodes.push_back( node{ 0, 0, 0 } );
+
+  for( auto n = std::size_t{0}; n < order.size(); ++n ) {
+    auto& siblings = children[order[n]];
+    std::sort( siblings.begin(), siblings.end(), []( const child& lhs, const child& rhs ) {
+      return lhs.key < rhs.key;
+    });
+
+    m_nodes[n].first_child = static_cast<std::uint32_t>(order.size());
+    m_nodes[n].child_count = static_cast<std::uint32_t>(siblings.size());
+
+    for( const auto& c : siblings ) {
+      order.push_back( c.node );
+      m_nodes.push_back( node{ c.key, 0, 0 } );
+    }
+  }
+
+  m_args.reserve( args.size() );
+  for( auto index : order ) {
+    m_args.push_back( std::move(args[index]) );
+  }
+}
@@ -0,0 +1,115 @@
+#include <bit/tools/args/letter_set_index.hpp>
+
+#include <bitset>    // std::bitset
+
+// AVX2 is compiled with a target attribute, and selected at runtime, so that
+// the library itself does not require AVX2
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+# define BIT_TOOLS_ARGS_HAS_AVX2_DISPATCH 1
+# include <immintrin.h>
+#endif
+
+namespace {
+
+  using filter_type = std::size_t(*)( std::uint32_t*,
+                                      const std::uint64_t*,
+                                      std::size_t,
+                                      std::uint64_t,
+                                      std::size_t );
+
+  //--------------------------------------------------------------------------
+  // Filters
+  //--------------------------------------------------------------------------
+
+  /// \brief Tests one signature at a time
+  std::size_t scalar_filter( std::uint32_t* survivors,
+                             const std::uint64_t* signatures,
+                             std::size_t count,
+                             std::uint64_t query,
+                             std::size_t threshold )
+    noexcept
+  {
+    auto kept = std::size_t{0};
+    for( auto i = std::size_t{0}; i < count; ++i ) {
+      survivors[kept] = static_cast<std::uint32_t>(i);
+      kept += std::bitset<64>( signatures[i] ^ query ).count() <= threshold;
+    }
+    return kept;
+  }
+
+#ifdef BIT_TOOLS_ARGS_HAS_AVX2_DISPATCH
+
+  /// \brief Tests four signatures at a time, counting bits with a nibble
+  ///        lookup table
+  __attribute__((target("avx2")))
+  std::size_t avx2_filter( std::uint32_t* survivors,
+                           const std::uint64_t* signatures,
+                           std::size_t count,
+                           std::uint64_t query,
+                           std::size_t threshold )
+    noexcept
+  {
+    const auto lookup = _mm256_setr_epi8( 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                          0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 );
+    const auto nibble = _mm256_set1_epi8( 0x0f );
+    const auto zero   = _mm256_setzero_si256();
+    const auto bits   = _mm256_set1_epi64x( static_cast<long long>(query) );
+    const auto limit  = _mm256_set1_epi64x( static_cast<long long>(threshold) );
+
+    auto kept = std::size_t{0};
+    auto i    = std::size_t{0};
+    for( ; i + 4 <= count; i += 4 ) {
+      const auto diff = _mm256_xor_si256(
+        _mm256_loadu_si256( reinterpret_cast<const __m256i*>(signatures + i) ), bits
+      );
+      const auto low  = _mm256_shuffle_epi8( lookup, _mm256_and_si256( diff, nibble ) );
+      const auto high = _mm256_shuffle_epi8( lookup, _mm256_and_si256( _mm256_srli_epi16( diff, 4 ), nibble ) );
+
+      // Summing the bytes of each lane gives the popcount of each signature
+      const auto counts = _mm256_sad_epu8( _mm256_add_epi8( low, high ), zero );
+      const auto reject = _mm256_cmpgt_epi64( counts, limit );
+
+      auto mask = ~static_cast<unsigned>(_mm256_movemask_pd( _mm256_castsi256_pd( reject ) )) & 0xfu;
+      while( mask ) {
+        survivors[kept++] = static_cast<std::uint32_t>(i + static_cast<std::size_t>(__builtin_ctz( mask )));
+        mask &= mask - 1;
+      }
+    }
+    for( ; i < count; ++i ) {
+      survivors[kept] = static_cast<std::uint32_t>(i);
+      kept += std::bitset<64>( signatures[i] ^ query ).count() <= threshold;
+    }
+    return kept;
+  }
+
+#endif
+
+  //--------------------------------------------------------------------------
+
+  /// \brief Selects the widest filter supported by the host
+  filter_type select_filter() noexcept
+  {
+#ifdef BIT_TOOLS_ARGS_HAS_AVX2_DISPATCH
+    __builtin_cpu_init();
+    if( __builtin_cpu_supports("avx2") ) return &avx2_filter;
+#endif
+    return &scalar_filter;
+  }
+
+} // anonymous namespace
+
+//----------------------------------------------------------------------------
+// Filters
+//----------------------------------------------------------------------------
+
+std::size_t bit::tools::detail::filter_signatures( std::uint32_t* survivors,
+                                                   const std::uint64_t* signatures,
+                                                   std::size_t count,
+                                                   std::uint64_t query,
+                                                   std::size_t threshold )
+  noexcept
+{
+  static const auto kernel = select_filter();
+
+  return kernel( survivors, signatures, count, query, threshold );
+}
@@ -0,0 +1,377 @@
+#include <bit/tools/args/mapped_symspell_index.hpp>
+
+#include <bit/tools/args/fnv1a_hash.hpp>
+
+#include <cerrno>       // errno
+#include <cstring>      // std::memcpy, std::memcmp
+#include <fstream>      // std::ifstream
+#include <ostream>      // std::ostream
+#include <stdexcept>    // std::runtime_error
+#include <system_error> // std::system_error, std::generic_category
+
+#if defined(__unix__) || defined(__APPLE__)
+# define BIT_TOOLS_ARGS_HAS_MMAP 1
+# include <fcntl.h>    // ::open
+# include <sys/mman.h> // ::mmap, ::munmap
+# include <sys/stat.h> // ::fstat
+# include <unistd.h>   // ::close
+#endif
+
+namespace {
+
+  using slot = bit::tools::symspell_view::slot;
+
+  //--------------------------------------------------------------------------
+  // File Format
+  //--------------------------------------------------------------------------
+
+  constexpr char          file_magic[8]   = { 'B','I','T','S','Y','M','S','P' };
+  constexpr std::uint32_t byte_order_mark = 0x01020304u;
+
+  /// The header at the start of an index file. The tables follow it in the
+  /// order: slots, offsets, postings, arena
+  struct file_header
+  {
+    char          magic[8];      ///< Always file_magic
+    std::uint32_t version;       ///< The format version
+    std::uint32_t byte_order;    ///< byte_order_mark, as written
+    std::uint32_t max_edits;     ///< The number of deletions per argument
+    std::uint32_t window_length; ///< The length of each deletion window
+    std::uint64_t arg_count;     ///< The number of arguments
+    std::uint64_t arena_size;    ///< The size of the arena, in bytes
+    std::uint64_t slot_count;    ///< The number of slots
+    std::uint64_t posting_count; ///< The number of postings
+    std::uint64_t checksum;      ///< The checksum of the tables
+  };
+
+  static_assert( sizeof(file_header) == 64, "file_header must not be padded" );
+  static_assert( sizeof(slot) == 16, "slot must not be padded" );
+
+  /// The offset of each table from the start of the file
+  struct file_layout
+  {
+    std::uint64_t slots;
+    std::uint64_t offsets;
+    std::uint64_t postings;
+    std::uint64_t arena;
+    std::uint64_t end;
+  };
+
+  /// \brief Computes where each table of \p header lies
+  ///
+  /// \param header the file header
+  /// \param limit the largest valid end of the file
+  /// \param layout the layout to store the offsets in
+  /// \return \c true if every table lies within \p limit
+  bool compute_layout( const file_header& header,
+                       std::uint64_t limit,
+                       file_layout* layout )
+    noexcept
+  {
+    // Each count is checked before it is scaled, so that a corrupt header
+    // cannot overflow the offsets
+    auto offset = std::uint64_t{sizeof(file_header)};
+
+    const auto advance = [&]( std::uint64_t count, std::uint64_t size ) {
+      if( count > (limit - offset) / size ) return false;
+      offset += count * size;
+      return true;
+    };
+
+    layout->slots = offset;
+    if( offset > limit || !advance( header.slot_count, sizeof(slot) ) ) return false;
+    layout->offsets = offset;
+    if( !advance( header.arg_count, sizeof(std::uint32_t) ) ) return false;
+    if( !advance( 1, sizeof(std::uint32_t) ) ) return false;
+    layout->postings = offset;
+    if( !advance( header.posting_count, sizeof(std::uint32_t) ) ) return false;
+    layout->arena = offset;
+    if( !advance( header.arena_size, sizeof(char) ) ) return false;
+    layout->end = offset;
+    return true;
+  }
+
+  /// \brief Folds \p size bytes at \p data into \p hash
+  ///
+  /// This consumes a word at a time, so that verifying a large file is
+  /// bound by reading it rather than by hashing
+  ///
+  /// \param data the bytes to hash
+  /// \param size the number of bytes
+  /// \param hash the hash so far
+  /// \return the new hash
+  std::uint64_t checksum( const void* data,
+                          std::size_t size,
+                          std::uint64_t hash )
+    noexcept
+  {
+    auto p = static_cast<const unsigned char*>(data);
+    for( ; size >= sizeof(std::uint64_t); size -= sizeof(std::uint64_t) ) {
+      auto word = std::uint64_t{};
+      std::memcpy( &word, p, sizeof(word) );
+      p += sizeof(word);
+
+      hash  = bit::tools::detail::fnv1a_step( hash, word );
+      hash ^= hash >> 32;
+    }
+    for( ; size; --size ) {
+      hash = bit::tools::detail::fnv1a_step( hash, *p++ );
+    }
+    return hash;
+  }
+
+  constexpr auto checksum_seed = bit::tools::detail::fnv1a_offset_basis;
+
+  template<typename T>
+  void write( std::ostream& out, const T* data, std::size_t count )
+  {
+    out.write( reinterpret_cast<const char*>(data),
+               static_cast<std::streamsize>(count * sizeof(T)) );
+  }
+
+} // anonymous namespace
+
+//============================================================================
+// symspell_index
+//============================================================================
+
+//----------------------------------------------------------------------------
+// Persistence
+//----------------------------------------------------------------------------
+
+void bit::tools::symspell_index::save( std::ostream& out )
+  const
+{
+  auto header = file_header{};
+  std::memcpy( header.magic, file_magic, sizeof(file_magic) );
+  header.version       = mapped_symspell_index::file_version;
+  header.byte_order    = byte_order_mark;
+  header.max_edits     = static_cast<std::uint32_t>(max_edits);
+  header.window_length = static_cast<std::uint32_t>(window_length);
+  header.arg_count     = size();
+  header.arena_size    = m_arena.size();
+  header.slot_count    = m_slots.size();
+  header.posting_count = m_postings.size();
+
+  // An index of nothing still has its one end offset
+  const auto end_offset = std::uint32_t{0};
+  const auto offsets    = m_offsets.empty() ? &end_offset : m_offsets.data();
+
+  auto hash = checksum_seed;
+  hash = checksum( m_slots.data(), m_slots.size() * sizeof(slot), hash );
+  hash = checksum( offsets, (size() + 1) * sizeof(std::uint32_t), hash );
+  hash = checksum( m_postings.data(), m_postings.size() * sizeof(std::uint32_t), hash );
+  hash = checksum( m_arena.data(), m_arena.size(), hash );
+  header.checksum = hash;
+
+  write( out, &header, 1 );
+  write( out, m_slots.data(), m_slots.size() );
+  write( out, offsets, size() + 1 );
+  write( out, m_postings.data(), m_postings.size() );
+  write( out, m_arena.data(), m_arena.size() );
+}
+
+//============================================================================
+// mapped_symspell_index
+//============================================================================
+
+constexpr std::uint32_t bit::tools::mapped_symspell_index::file_version;
+
+//----------------------------------------------------------------------------
+// Constructors / Destructor / Assignment
+//----------------------------------------------------------------------------
+
+bit::tools::mapped_symspell_index
+  ::mapped_symspell_index( const std::string& path, metric_type fn )
+  : m_data(nullptr),
+    m_size(0),
+    m_buffer(),
+    m_view()
+{
+  open( path );
+
+  // Only constant-time checks are done here; the file is otherwise trusted
+  const auto fail = [&]( const char* reason ) {
+    close();
+    throw std::runtime_error("mapped_symspell_index: '" + path + "' " + reason);
+  };
+
+  auto header = file_header{};
+  if( m_size < sizeof(header) ) fail( "is too small to be an index file" );
+  std::memcpy( &header, m_data, sizeof(header) );
+
+  if( std::memcmp( header.magic, file_magic, sizeof(file_magic) ) != 0 ) {
+    fail( "is not an index file" );
+  }
+  if( header.version != file_version ) {
+    fail( "has an unsupported version" );
+  }
+  if( header.byte_order != byte_order_mark ) {
+    fail( "was written with a different byte order" );
+  }
+  if( header.max_edits != symspell_view::max_edits ||
+      header.window_length != symspell_view::window_length ) {
+    fail( "was written with a different configuration" );
+  }
+
+  auto layout = file_layout{};
+  if( !compute_layout( header, m_size, &layout ) || layout.end != m_size ) {
+    fail( "is truncated or corrupt" );
+  }
+  // The table is probed with a mask, so it must be a nonzero power of two
+  if( header.slot_count == 0 || (header.slot_count & (header.slot_count - 1)) ) {
+    fail( "is corrupt" );
+  }
+
+  m_view = symspell_view{
+    fn,
+    m_data + layout.arena,
+    reinterpret_cast<const std::uint32_t*>(m_data + layout.offsets),
+    static_cast<size_type>(header.arg_count),
+    reinterpret_cast<const slot*>(m_data + layout.slots),
+    static_cast<size_type>(header.slot_count),
+    reinterpret_cast<const std::uint32_t*>(m_data + layout.postings)
+  };
+}
+
+bit::tools::mapped_symspell_index
+  ::mapped_symspell_index( mapped_symspell_index&& other )
+  noexcept
+  : m_data(other.m_data),
+    m_size(other.m_size),
+    m_buffer(std::move(other.m_buffer)),
+    m_view(other.m_view)
+{
+  other.m_data = nullptr;
+  other.m_size = 0;
+  other.m_view = symspell_view{};
+}
+
+//----------------------------------------------------------------------------
+
+bit::tools::mapped_symspell_index::~mapped_symspell_index()
+{
+  close();
+}
+
+//----------------------------------------------------------------------------
+
+bit::tools::mapped_symspell_index&
+  bit::tools::mapped_symspell_index::operator=( mapped_symspell_index&& other )
+  noexcept
+{
+  if( this != &other ) {
+    close();
+
+    m_data   = other.m_data;
+    m_size   = other.m_size;
+    m_buffer = std::move(other.m_buffer);
+    m_view   = other.m_view;
+
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_view = symspell_view{};
+  }
+  return (*this);
+}
+
+//----------------------------------------------------------------------------
+// Validation
+//----------------------------------------------------------------------------
+
+bool bit::tools::mapped_symspell_index::verify()
+  const noexcept
+{
+  if( m_size < sizeof(file_header) ) return false;
+
+  auto header = file_header{};
+  std::memcpy( &header, m_data, sizeof(header) );
+
+  auto layout = file_layout{};
+  if( !compute_layout( header, m_size, &layout ) ) return false;
+
+  // The tables are contiguous, and hashed in the order they are written.
+  // Hashing them in one call would give a different result whenever a
+  // table does not end on a word boundary
+  auto hash = checksum_seed;
+  hash = checksum( m_data + layout.slots, layout.offsets - layout.slots, hash );
+  hash = checksum( m_data + layout.offsets, layout.postings - layout.offsets, hash );
+  hash = checksum( m_data + layout.postings, layout.arena - layout.postings, hash );
+  hash = checksum( m_data + layout.arena, layout.end - layout.arena, hash );
+  return hash == header.checksum;
+}
+
+//----------------------------------------------------------------------------
+// Private Member Functions
+//----------------------------------------------------------------------------
+
+void bit::tools::mapped_symspell_index::open( const std::string& path )
+{
+  const auto fail = [&]( int error ) {
+    throw std::system_error(
+      error, std::generic_category(),
+      "mapped_symspell_index: unable to open '" + path + "'"
+    );
+  };
+
+#ifdef BIT_TOOLS_ARGS_HAS_MMAP
+  const auto fd = ::open( path.c_str(), O_RDONLY );
+  if( fd < 0 ) fail( errno );
+
+  struct ::stat info;
+  if( ::fstat( fd, &info ) != 0 ) {
+    const auto error = errno;
+    ::close( fd );
+    fail( error );
+  }
+  m_size = static_cast<size_type>(info.st_size);
+
+  // An empty file cannot be mapped, and is rejected by the header check
+  if( m_size == 0 ) {
+    ::close( fd );
+    return;
+  }
+
+  const auto data = ::mmap( nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+  const auto error = errno;
+  ::close( fd );
+
+  if( data == MAP_FAILED ) {
+    m_size = 0;
+    fail( error );
+  }
+  m_data = static_cast<const char*>(data);
+#else
+  std::ifstream in( path, std::ios::binary | std::ios::ate );
+  if( !in ) fail( ENOENT );
+
+  m_size = static_cast<size_type>(in.tellg());
+  in.seekg( 0 );
+
+  // Words, rather than chars, so that the slots are aligned
+  m_buffer.resize( (m_size + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t) );
+  in.read( reinterpret_cast<char*>(m_buffer.data()),
+           static_cast<std::streamsize>(m_size) );
+  if( !in ) fail( EIO );
+
+  m_data = reinterpret_cast<const char*>(m_buffer.data());
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+void bit::tools::mapped_symspell_index::close()
+  noexcept
+{
+#ifdef BIT_TOOLS_ARGS_HAS_MMAP
+  if( m_data ) {
+    ::munmap( const_cast<char*>(m_data), m_size );
+  }
+#else
+  m_buffer.clear();
+  m_buffer.shrink_to_fit();
+#endif
+  m_data = nullptr;
+  m_size = 0;
+  m_view = symspell_view{};
+}
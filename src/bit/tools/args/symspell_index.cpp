@@ -0,0 +1,257 @@
+#include <bit/tools/args/symspell_index.hpp>
+
+#include <bit/tools/args/fnv1a_hash.hpp>
+
+#include <algorithm> // std::sort, std::unique, std::set_intersection
+#include <bitset>    // std::bitset
+#include <iterator>  // std::back_inserter
+
+namespace {
+
+  /// The largest number of distinct deletions of a single prefix
+  constexpr std::size_t max_deletions = 1u << bit::tools::symspell_index::window_length;
+
+  /// The window that deletions are taken from
+  enum class window { prefix, suffix };
+
+  inline std::size_t popcount( std::uint32_t mask ) noexcept
+  {
+    return std::bitset<32>( mask ).count();
+  }
+
+  //--------------------------------------------------------------------------
+  // Deletions
+  //--------------------------------------------------------------------------
+
+  /// \brief Hashes \p str with the characters selected by \p removed left
+  ///        out, using 64-bit FNV-1a
+  ///
+  /// \param str the string
+  /// \param removed the mask of positions to leave out
+  /// \param seed the initial hash, which separates prefix and suffix keys
+  /// \return the hash of the deletion
+  std::uint64_t deletion_hash( bit::stl::string_view str,
+                               std::uint32_t removed,
+                               std::uint64_t seed )
+    noexcept
+  {
+    auto hash = seed;
+
+    for( auto i = std::size_t{0}; i < str.size(); ++i ) {
+      if( removed & (std::uint32_t{1} << i) ) continue;
+
+      hash = bit::tools::detail::fnv1a_step( hash, static_cast<unsigned char>(str[i]) );
+    }
+    // Mix in the length, so that the empty deletion is not the seed
+    return bit::tools::detail::fnv1a_step( hash, str.size() - popcount( removed ) );
+  }
+
+  /// \brief Computes the distinct hashes of every deletion of at most
+  ///        \p edits characters from the given window of \p str
+  ///
+  /// \param str the string
+  /// \param w the window to take deletions from
+  /// \param edits the largest number of deletions
+  /// \param hashes storage for at least max_deletions hashes
+  /// \return the number of distinct hashes
+  std::size_t deletion_hashes( bit::stl::string_view str,
+                               window w,
+                               std::size_t edits,
+                               std::uint64_t* hashes )
+    noexcept
+  {
+    constexpr auto length = bit::tools::symspell_index::window_length;
+
+    const auto part = (w == window::prefix || str.size() <= length)
+                    ? str.substr( 0, length )
+                    : str.substr( str.size() - length );
+    const auto seed = (w == window::prefix)
+                    ? bit::tools::detail::fnv1a_offset_basis
+                    : std::uint64_t{0x9e3779b97f4a7c15ull};
+    const auto masks = std::uint32_t{1} << part.size();
+
+    auto count = std::size_t{0};
+    for( auto removed = std::uint32_t{0}; removed < masks; ++removed ) {
+      if( popcount( removed ) > edits ) continue;
+
+      hashes[count++] = deletion_hash( part, removed, seed );
+    }
+
+    // Repeated characters produce the same deletion more than once
+    std::sort( hashes, hashes + count );
+    return static_cast<std::size_t>(std::unique( hashes, hashes + count ) - hashes);
+  }
+
+} // anonymous namespace
+
+//============================================================================
+// symspell_index
+//============================================================================
+
+//----------------------------------------------------------------------------
+// Capacity
+//----------------------------------------------------------------------------
+
+bit::tools::symspell_index::size_type
+  bit::tools::symspell_index::memory_usage()
+  const noexcept
+{
+  return m_arena.capacity() * sizeof(char) +
+         m_offsets.capacity() * sizeof(std::uint32_t) +
+         m_slots.capacity() * sizeof(slot) +
+         m_postings.capacity() * sizeof(std::uint32_t);
+}
+
+//----------------------------------------------------------------------------
+// Private Member Functions
+//----------------------------------------------------------------------------
+
+void bit::tools::symspell_index::build( const std::vector<std::string>& args )
+{
+  // Arena
+  auto text_size = std::size_t{0};
+  for( const auto& arg : args ) {
+    text_size += arg.size();
+  }
+  m_arena.reserve( text_size );
+  m_offsets.reserve( args.size() + 1 );
+
+  for( const auto& arg : args ) {
+    m_offsets.push_back( static_cast<std::uint32_t>(m_arena.size()) );
+    m_arena.insert( m_arena.end(), arg.begin(), arg.end() );
+  }
+  m_offsets.push_back( static_cast<std::uint32_t>(m_arena.size()) );
+
+  // The table is sized for a typical number of distinct deletions per
+  // argument, and doubled whenever it becomes half full
+  auto slots = std::size_t{16};
+  while( slots < args.size() * 8 ) slots *= 2;
+  m_slots.assign( slots, slot{ 0, 0, 0 } );
+
+  auto used = std::size_t{0};
+
+  const auto insert = [&]( std::vector<slot>& table, std::uint64_t hash ) -> slot& {
+    const auto mask = table.size() - 1;
+    auto i = static_cast<std::size_t>(hash) & mask;
+    while( table[i].count != 0 && table[i].hash != hash ) {
+      i = (i + 1) & mask;
+    }
+    return table[i];
+  };
+
+  // First pass: count the postings of each deletion
+  std::uint64_t hashes[max_deletions * 2];
+
+  const auto window_hashes = [&]( stl::string_view arg ) {
+    const auto prefix = deletion_hashes( arg, window::prefix, max_edits, hashes );
+    const auto suffix = deletion_hashes( arg, window::suffix, max_edits, hashes + prefix );
+    return prefix + suffix;
+  };
+
+  for( const auto& arg : args ) {
+    const auto count = window_hashes( arg );
+
+    // Grow before inserting, so that the table never fills
+    while( (used + count) * 2 > m_slots.size() ) {
+      auto table = std::vector<slot>( m_slots.size() * 2, slot{ 0, 0, 0 } );
+      for( const auto& s : m_slots ) {
+        if( s.count ) insert( table, s.hash ) = s;
+      }
+      m_slots = std::move(table);
+    }
+
+    for( auto h = std::size_t{0}; h < count; ++h ) {
+      auto& s = insert( m_slots, hashes[h] );
+      if( s.count == 0 ) {
+        s.hash = hashes[h];
+        ++used;
+      }
+      ++s.count;
+    }
+  }
+
+  // Assign each deletion its range of postings
+  auto total = std::uint32_t{0};
+  for( auto& s : m_slots ) {
+    s.first = total;
+    total  += s.count;
+  }
+
+  // Second pass: fill in the postings, in ascending order of argument
+  m_postings.resize( total );
+  auto filled = std::vector<std::uint32_t>( m_slots.size(), 0 );
+
+  for( auto i = std::size_t{0}; i < args.size(); ++i ) {
+    const auto count = window_hashes( args[i] );
+
+    for( auto h = std::size_t{0}; h < count; ++h ) {
+      auto& s = insert( m_slots, hashes[h] );
+      const auto index = static_cast<std::size_t>(&s - m_slots.data());
+      m_postings[s.first + filled[index]++] = static_cast<std::uint32_t>(i);
+    }
+  }
+}
+
+//============================================================================
+// symspell_view
+//============================================================================
+
+//----------------------------------------------------------------------------
+// Private Member Functions
+//----------------------------------------------------------------------------
+
+void bit::tools::symspell_view
+  ::find_candidates( stl::string_view query,
+                     size_type max,
+                     std::vector<std::uint32_t>* candidates )
+  const
+{
+  if( m_slot_count == 0 ) return;
+
+  std::uint64_t hashes[max_deletions];
+
+  // Collects the distinct arguments that share a deletion of the window
+  const auto collect = [&]( window w, std::vector<std::uint32_t>* result ) {
+    const auto count = deletion_hashes( query, w, max, hashes );
+
+    for( auto h = std::size_t{0}; h < count; ++h ) {
+      const auto s = find_slot( hashes[h] );
+      if( !s ) continue;
+
+      result->insert( result->end(),
+                      m_postings + s->first,
+                      m_postings + s->first + s->count );
+    }
+    std::sort( result->begin(), result->end() );
+    result->erase( std::unique( result->begin(), result->end() ), result->end() );
+  };
+
+  // The distance is the same between the reversed strings, so a match must
+  // share a deletion of both the prefix and the suffix. Either one alone
+  // is weak when many arguments share a common prefix (such as "--no-")
+  auto prefix = std::vector<std::uint32_t>{};
+  auto suffix = std::vector<std::uint32_t>{};
+  collect( window::prefix, &prefix );
+  if( prefix.empty() ) return;
+  collect( window::suffix, &suffix );
+
+  std::set_intersection( prefix.begin(), prefix.end(),
+                         suffix.begin(), suffix.end(),
+                         std::back_inserter( *candidates ) );
+}
+
+//----------------------------------------------------------------------------
+
+const bit::tools::symspell_view::slot*
+  bit::tools::symspell_view::find_slot( std::uint64_t hash )
+  const noexcept
+{
+  const auto mask = m_slot_count - 1;
+  auto i = static_cast<std::size_t>(hash) & mask;
+
+  while( m_slots[i].count != 0 ) {
+    if( m_slots[i].hash == hash ) return &m_slots[i];
+    i = (i + 1) & mask;
+  }
+  return nullptr;
+}
@@ -0,0 +1,166 @@
+#include <bit/tools/args/trie_index.hpp>
+
+#include <algorithm> // std::sort, std::unique, std::mismatch
+#include <numeric>   // std::iota
+
+//============================================================================
+// trie_index
+//============================================================================
+
+constexpr std::uint32_t bit::tools::trie_index::no_arg;
+
+//----------------------------------------------------------------------------
+// Private Member Functions
+//----------------------------------------------------------------------------
+
+void bit::tools::trie_index::build( std::vector<std::string> args )
+{
+  m_args = std::move(args);
+
+  // Inserting the arguments in sorted order lays the trie out in preorder:
+  // an argument only extends the path of the one before it, and every node
+  // off that path is complete. Equal arguments share a node, which keeps
+  // the first of them
+  auto order = std::vector<std::uint32_t>( m_args.size() );
+  std::iota( order.begin(), order.end(), std::uint32_t{0} );
+  std::sort( order.begin(), order.end(), [&]( std::uint32_t lhs, std::uint32_t rhs ) {
+    return m_args[lhs] < m_args[rhs] || (m_args[lhs] == m_args[rhs] && lhs < rhs);
+  });
+
+  m_nodes.push_back( node{ 0, no_arg, 0, '\0' } );
+
+  auto path     = std::vector<std::uint32_t>{ 0 };
+  auto previous = stl::string_view{};
+
+  for( auto index : order ) {
+    const auto arg = stl::string_view{ m_args[index] };
+    const auto length = std::min( arg.size(), previous.size() );
+    const auto common = static_cast<std::size_t>(
+      std::mismatch( arg.begin(), arg.begin() + length, previous.begin() ).first - arg.begin()
+    );
+
+    // Close the nodes of the previous argument that this one diverges from
+    while( path.size() - 1 > common ) {
+      m_nodes[path.back()].end = static_cast<std::uint32_t>(m_nodes.size());
+      path.pop_back();
+    }
+    for( auto i = common; i < arg.size(); ++i ) {
+      path.push_back( static_cast<std::uint32_t>(m_nodes.size()) );
+      m_nodes.push_back( node{ 0, no_arg, static_cast<std::uint32_t>(i + 1), arg[i] } );
+    }
+
+    auto& last = m_nodes[path.back()];
+    if( last.arg == no_arg ) last.arg = index;
+    previous = arg;
+  }
+
+  while( !path.empty() ) {
+    m_nodes[path.back()].end = static_cast<std::uint32_t>(m_nodes.size());
+    path.pop_back();
+  }
+}
+
+//============================================================================
+// levenshtein_automaton
+//============================================================================
+
+//----------------------------------------------------------------------------
+// Constructors
+//----------------------------------------------------------------------------
+
+bit::tools::levenshtein_automaton
+  ::levenshtein_automaton( const trie_index& trie, size_type max )
+  : m_trie(&trie),
+    m_max(max),
+    m_query(),
+    m_states(),
+    m_levels{ 0 },
+    m_scratch{ state{ 0, 0 } }
+{
+  // The empty query is within max of every prefix of at most max characters
+  close_level();
+}
+
+//----------------------------------------------------------------------------
+// Modifiers
+//----------------------------------------------------------------------------
+
+void bit::tools::levenshtein_automaton::push_back( char c )
+{
+  const auto& nodes = m_trie->m_nodes;
+  const auto first  = m_levels.back();
+  const auto last   = static_cast<std::uint32_t>(m_states.size());
+
+  // Each state steps to its children by matching or substituting c, or
+  // stays put by deleting c from the query. Insertions into the query are
+  // added by close_level
+  m_scratch.clear();
+  for( auto i = first; i < last; ++i ) {
+    const auto s = m_states[i];
+
+    if( s.distance < m_max ) {
+      m_scratch.push_back( state{ s.node, s.distance + 1 } );
+    }
+
+    const auto end = nodes[s.node].end;
+    for( auto child = s.node + 1; child < end; child = nodes[child].end ) {
+      const auto distance = s.distance + (nodes[child].label == c ? 0u : 1u);
+      if( distance <= m_max ) {
+        m_scratch.push_back( state{ child, distance } );
+      }
+    }
+  }
+
+  m_query.push_back( c );
+  m_levels.push_back( last );
+  close_level();
+}
+
+//----------------------------------------------------------------------------
+// Private Member Functions
+//----------------------------------------------------------------------------
+
+void bit::tools::levenshtein_automaton::close_level()
+{
+  const auto& nodes = m_trie->m_nodes;
+
+  // Sorting by node, then distance, leaves the closest state of each node
+  // first, where unique keeps it
+  const auto less = []( const state& lhs, const state& rhs ) {
+    return lhs.node < rhs.node || (lhs.node == rhs.node && lhs.distance < rhs.distance);
+  };
+  const auto same_node = []( const state& lhs, const state& rhs ) {
+    return lhs.node == rhs.node;
+  };
+  const auto compact = [&] {
+    std::sort( m_scratch.begin(), m_scratch.end(), less );
+    m_scratch.erase( std::unique( m_scratch.begin(), m_scratch.end(), same_node ), m_scratch.end() );
+  };
+
+  compact();
+
+  // Inserting characters into the query reaches every descendant within
+  // the remaining budget, at one edit per level
+  const auto base = m_scratch.size();
+  for( auto i = std::size_t{0}; i < base; ++i ) {
+    const auto s = m_scratch[i];
+    if( s.distance == m_max ) continue;
+
+    const auto depth = nodes[s.node].depth;
+    const auto limit = depth + static_cast<std::uint32_t>(m_max - s.distance);
+    const auto end   = nodes[s.node].end;
+
+    for( auto n = s.node + 1; n < end; ) {
+      if( nodes[n].depth > limit ) {
+        n = nodes[n].end;
+        continue;
+      }
+      m_scratch.push_back( state{ n, s.distance + (nodes[n].depth - depth) } );
+      ++n;
+    }
+  }
+
+  if( m_scratch.size() != base ) compact();
+
+  m_states.insert( m_states.end(), m_scratch.begin(), m_scratch.end() );
+}
@@ -0,0 +1,422 @@
+#include <bit/tools/args/trigram_index.hpp>
+
+#include <algorithm> // std::sort, std::stable_sort, std::upper_bound, std::min, std::max
+#include <cstddef>   // std::ptrdiff_t
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define BIT_TOOLS_ARGS_HAS_SSE2 1
+# include <emmintrin.h>
+#endif
+
+namespace {
+
+  constexpr std::size_t gram_length = 3;
+
+  /// The most distinct trigrams of the query that one edit can remove
+  constexpr std::size_t grams_per_edit = gram_length + 1;
+
+  //--------------------------------------------------------------------------
+  // Trigrams
+  //--------------------------------------------------------------------------
+
+  /// \brief Stores the distinct trigrams of \p str in \p grams, in
+  ///        ascending order
+  ///
+  /// \param str the string
+  /// \param grams the vector to store the trigrams in
+  void distinct_grams( bit::stl::string_view str, std::vector<std::uint32_t>* grams )
+  {
+    grams->clear();
+    if( str.size() < gram_length ) return;
+
+    const auto byte = [&]( std::size_t i ) {
+      return static_cast<std::uint32_t>(static_cast<unsigned char>(str[i]));
+    };
+
+    for( auto i = std::size_t{0}; i + gram_length <= str.size(); ++i ) {
+      grams->push_back( (byte( i ) << 16) | (byte( i + 1 ) << 8) | byte( i + 2 ) );
+    }
+    std::sort( grams->begin(), grams->end() );
+    grams->erase( std::unique( grams->begin(), grams->end() ), grams->end() );
+  }
+
+  //--------------------------------------------------------------------------
+  // Varints
+  //--------------------------------------------------------------------------
+
+  void write_varint( std::vector<std::uint8_t>* out, std::uint32_t value )
+  {
+    while( value >= 0x80u ) {
+      out->push_back( static_cast<std::uint8_t>(value | 0x80u) );
+      value >>= 7;
+    }
+    out->push_back( static_cast<std::uint8_t>(value) );
+  }
+
+  inline std::uint32_t read_varint( const std::uint8_t*& in ) noexcept
+  {
+    auto value = std::uint32_t{0};
+    auto shift = 0u;
+    while( *in & 0x80u ) {
+      value |= static_cast<std::uint32_t>(*in++ & 0x7fu) << shift;
+      shift += 7;
+    }
+    return value | (static_cast<std::uint32_t>(*in++) << shift);
+  }
+
+  //--------------------------------------------------------------------------
+  // Intersection
+  //--------------------------------------------------------------------------
+
+  /// \brief Increments \p counts[i] for each \p candidates[i] that is also
+  ///        in \p postings
+  ///
+  /// Both ranges must be sorted and free of duplicates
+  void count_common( const std::uint32_t* candidates,
+                     std::size_t candidate_count,
+                     const std::uint32_t* postings,
+                     std::size_t posting_count,
+                     std::uint32_t* counts )
+    noexcept
+  {
+    auto i = std::size_t{0};
+    auto j = std::size_t{0};
+
+#ifdef BIT_TOOLS_ARGS_HAS_SSE2
+    // Compares four candidates with four postings at a time, in all four
+    // rotations, then advances whichever side has the smaller maximum
+    while( i + 4 <= candidate_count && j + 4 <= posting_count ) {
+      const auto a = _mm_loadu_si128( reinterpret_cast<const __m128i*>(candidates + i) );
+      const auto b = _mm_loadu_si128( reinterpret_cast<const __m128i*>(postings + j) );
+
+      auto equal = _mm_cmpeq_epi32( a, b );
+      equal = _mm_or_si128( equal, _mm_cmpeq_epi32( a, _mm_shuffle_epi32( b, _MM_SHUFFLE(0,3,2,1) ) ) );
+      equal = _mm_or_si128( equal, _mm_cmpeq_epi32( a, _mm_shuffle_epi32( b, _MM_SHUFFLE(1,0,3,2) ) ) );
+      equal = _mm_or_si128( equal, _mm_cmpeq_epi32( a, _mm_shuffle_epi32( b, _MM_SHUFFLE(2,1,0,3) ) ) );
+
+      // Each matching lane is all ones, so subtracting it adds one
+      auto current = _mm_loadu_si128( reinterpret_cast<const __m128i*>(counts + i) );
+      current = _mm_sub_epi32( current, equal );
+      _mm_storeu_si128( reinterpret_cast<__m128i*>(counts + i), current );
+
+      const auto a_max = candidates[i + 3];
+      const auto b_max = postings[j + 3];
+      if( a_max <= b_max ) i += 4;
+      if( b_max <= a_max ) j += 4;
+    }
+#endif
+
+    while( i < candidate_count && j < posting_count ) {
+      if( candidates[i] < postings[j] ) {
+        ++i;
+      } else if( postings[j] < candidates[i] ) {
+        ++j;
+      } else {
+        ++counts[i];
+        ++i;
+        ++j;
+      }
+    }
+  }
+
+} // anonymous namespace
+
+constexpr bit::tools::trigram_index::size_type
+  bit::tools::trigram_index::block_size;
+
+//----------------------------------------------------------------------------
+// Capacity
+//----------------------------------------------------------------------------
+
+bit::tools::trigram_index::size_type
+  bit::tools::trigram_index::memory_usage()
+  const noexcept
+{
+  return m_arena.capacity() * sizeof(char) +
+         m_offsets.capacity() * sizeof(std::uint32_t) +
+         m_length_starts.capacity() * sizeof(std::uint32_t) +
+         m_grams.capacity() * sizeof(std::uint32_t) +
+         m_lists.capacity() * sizeof(posting_list) +
+         m_blocks.capacity() * sizeof(block) +
+         m_deltas.capacity() * sizeof(std::uint8_t);
+}
+
+//----------------------------------------------------------------------------
+// Private Member Functions
+//----------------------------------------------------------------------------
+
+void bit::tools::trigram_index::build( const std::vector<std::string>& args )
+{
+  // Numbering the arguments by length makes those of any range of lengths
+  // a single range of indices
+  auto order = std::vector<std::uint32_t>( args.size() );
+  for( auto i = std::size_t{0}; i < order.size(); ++i ) {
+    order[i] = static_cast<std::uint32_t>(i);
+  }
+  std::stable_sort( order.begin(), order.end(), [&]( std::uint32_t lhs, std::uint32_t rhs ) {
+    return args[lhs].size() < args[rhs].size();
+  });
+
+  auto text_size = std::size_t{0};
+  auto longest   = std::size_t{0};
+  for( const auto& arg : args ) {
+    text_size += arg.size();
+    longest    = std::max( longest, arg.size() );
+  }
+  m_arena.reserve( text_size );
+  m_offsets.reserve( args.size() + 1 );
+  m_length_starts.assign( longest + 2, 0 );
+
+  for( auto index : order ) {
+    const auto& arg = args[index];
+
+    m_offsets.push_back( static_cast<std::uint32_t>(m_arena.size()) );
+    m_arena.insert( m_arena.end(), arg.begin(), arg.end() );
+    ++m_length_starts[arg.size() + 1];
+  }
+  m_offsets.push_back( static_cast<std::uint32_t>(m_arena.size()) );
+
+  // Turn the count of each length into the start of the next length
+  for( auto l = std::size_t{1}; l < m_length_starts.size(); ++l ) {
+    m_length_starts[l] += m_length_starts[l - 1];
+  }
+
+  // Arguments are visited in order, so each list is encoded as it grows
+  struct list_builder
+  {
+    std::uint32_t              gram;
+    std::uint32_t              count;
+    std::uint32_t              last;
+    std::vector<block>         blocks;
+    std::vector<std::uint8_t>  deltas;
+  };
+
+  auto builders = std::vector<list_builder>{};
+
+  // Open-addressed map from each trigram to its builder, plus one
+  auto table = std::vector<std::uint32_t>( 1024, 0 );
+
+  const auto find = [&]( std::uint32_t gram ) -> std::uint32_t& {
+    const auto mask = table.size() - 1;
+    auto i = static_cast<std::size_t>(gram * 2654435761u) & mask;
+    while( table[i] != 0 && builders[table[i] - 1].gram != gram ) {
+      i = (i + 1) & mask;
+    }
+    return table[i];
+  };
+
+  auto grams = std::vector<std::uint32_t>{};
+  for( auto i = std::size_t{0}; i < order.size(); ++i ) {
+    distinct_grams( args[order[i]], &grams );
+
+    // Grow before inserting, so that the table never fills
+    while( (builders.size() + grams.size()) * 2 > table.size() ) {
+      table.assign( table.size() * 2, 0 );
+      for( auto b = std::size_t{0}; b < builders.size(); ++b ) {
+        find( builders[b].gram ) = static_cast<std::uint32_t>(b + 1);
+      }
+    }
+
+    const auto index = static_cast<std::uint32_t>(i);
+    for( auto gram : grams ) {
+      auto& slot = find( gram );
+      if( slot == 0 ) {
+        builders.push_back( list_builder{ gram, 0, 0, {}, {} } );
+        slot = static_cast<std::uint32_t>(builders.size());
+      }
+
+      auto& builder = builders[slot - 1];
+      if( builder.count % block_size == 0 ) {
+        builder.blocks.push_back( block{ index, static_cast<std::uint32_t>(builder.deltas.size()) } );
+      } else {
+        write_varint( &builder.deltas, index - builder.last );
+      }
+      builder.last = index;
+      ++builder.count;
+    }
+  }
+
+  // Lay the lists out in trigram order
+  std::sort( builders.begin(), builders.end(), []( const list_builder& lhs, const list_builder& rhs ) {
+    return lhs.gram < rhs.gram;
+  });
+
+  auto block_count = std::size_t{0};
+  auto delta_count = std::size_t{0};
+  for( const auto& builder : builders ) {
+    block_count += builder.blocks.size();
+    delta_count += builder.deltas.size();
+  }
+  m_grams.reserve( builders.size() );
+  m_lists.reserve( builders.size() );
+  m_blocks.reserve( block_count );
+  m_deltas.reserve( delta_count );
+
+  for( auto& builder : builders ) {
+    const auto base = static_cast<std::uint32_t>(m_deltas.size());
+
+    m_grams.push_back( builder.gram );
+    m_lists.push_back( posting_list{ static_cast<std::uint32_t>(m_blocks.size()), builder.count } );
+    for( const auto& b : builder.blocks ) {
+      m_blocks.push_back( block{ b.first, base + b.offset } );
+    }
+    m_deltas.insert( m_deltas.end(), builder.deltas.begin(), builder.deltas.end() );
+
+    // Release each builder as it is copied, to bound the peak memory
+    builder = list_builder{};
+  }
+}
+
+//----------------------------------------------------------------------------
+
+bool bit::tools::trigram_index
+  ::find_candidates( stl::string_view query,
+                     size_type max,
+                     std::uint32_t first,
+                     std::uint32_t last,
+                     std::vector<std::uint32_t>* candidates )
+  const
+{
+  auto grams = std::vector<std::uint32_t>{};
+  distinct_grams( query, &grams );
+
+  const auto lost = grams_per_edit * max;
+  if( grams.size() <= lost ) return false;
+
+  const auto threshold = static_cast<std::uint32_t>(grams.size() - lost);
+
+  // A trigram that no argument has is an empty list, and is the shortest
+  auto lists = std::vector<const posting_list*>{};
+  for( auto gram : grams ) {
+    const auto it = std::lower_bound( m_grams.begin(), m_grams.end(), gram );
+    if( it != m_grams.end() && *it == gram ) {
+      lists.push_back( &m_lists[static_cast<std::size_t>(it - m_grams.begin())] );
+    }
+  }
+  std::sort( lists.begin(), lists.end(), []( const posting_list* lhs, const posting_list* rhs ) {
+    return lhs->count < rhs->count;
+  });
+
+  // Gather the arguments in the lost + 1 shortest lists, with the number of
+  // those lists each appears in
+  const auto absent = grams.size() - lists.size();
+  if( absent > lost ) return true;
+
+  const auto short_lists = lost + 1 - absent;
+
+  // Only the blocks that overlap [first, last) are decoded
+  std::uint32_t buffer[block_size];
+  auto gathered = std::vector<std::uint32_t>{};
+  for( auto l = std::size_t{0}; l < short_lists; ++l ) {
+    const auto& list  = *lists[l];
+    const auto blocks = (list.count + block_size - 1) / block_size;
+
+    for( auto b = find_block( list, 0, first ); b < blocks; ++b ) {
+      if( m_blocks[list.first_block + b].first >= last ) break;
+
+      const auto count = decode( buffer, list, b );
+      for( auto i = size_type{0}; i < count; ++i ) {
+        if( buffer[i] >= first && buffer[i] < last ) {
+          gathered.push_back( buffer[i] );
+        }
+      }
+    }
+  }
+  std::sort( gathered.begin(), gathered.end() );
+
+  auto& result = *candidates;
+  auto counts  = std::vector<std::uint32_t>{};
+  for( auto i = std::size_t{0}; i < gathered.size(); ) {
+    auto j = i + 1;
+    while( j < gathered.size() && gathered[j] == gathered[i] ) ++j;
+
+    result.push_back( gathered[i] );
+    counts.push_back( static_cast<std::uint32_t>(j - i) );
+    i = j;
+  }
+
+  // Drops the candidates that the remaining lists cannot bring to the
+  // threshold
+  const auto prune = [&]( std::size_t remaining ) {
+    auto kept = std::size_t{0};
+    for( auto i = std::size_t{0}; i < result.size(); ++i ) {
+      if( counts[i] + remaining < threshold ) continue;
+
+      result[kept] = result[i];
+      counts[kept] = counts[i];
+      ++kept;
+    }
+    result.resize( kept );
+    counts.resize( kept );
+  };
+
+  auto remaining = lists.size() - short_lists;
+  prune( remaining );
+
+  // Count the candidates in each longer list, jumping straight to the
+  // block that would hold the next candidate
+  for( auto l = short_lists; l < lists.size() && !result.empty(); ++l ) {
+    const auto& list  = *lists[l];
+    const auto blocks = (list.count + block_size - 1) / block_size;
+
+    auto b = size_type{0};
+    for( auto c = std::size_t{0}; c < result.size(); ) {
+      b = find_block( list, b, result[c] );
+
+      const auto end = (b + 1 < blocks) ? m_blocks[list.first_block + b + 1].first
+                                        : ~std::uint32_t{0};
+      auto stop = c;
+      while( stop < result.size() && result[stop] < end ) ++stop;
+
+      const auto count = decode( buffer, list, b );
+      count_common( result.data() + c, stop - c, buffer, count, counts.data() + c );
+      c = stop;
+    }
+
+    prune( --remaining );
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+
+bit::tools::trigram_index::size_type
+  bit::tools::trigram_index::find_block( const posting_list& list,
+                                         size_type from,
+                                         std::uint32_t index )
+  const noexcept
+{
+  const auto blocks = (list.count + block_size - 1) / block_size;
+  const auto begin  = m_blocks.begin() + static_cast<std::ptrdiff_t>(list.first_block);
+  const auto end    = begin + static_cast<std::ptrdiff_t>(blocks);
+
+  // The last block that starts at or before index
+  const auto it = std::upper_bound( begin + static_cast<std::ptrdiff_t>(from), end, index,
+                                    []( std::uint32_t lhs, const block& rhs ) {
+    return lhs < rhs.first;
+  });
+  const auto b = static_cast<size_type>(it - begin);
+  return (b > from) ? (b - 1) : from;
+}
+
+//----------------------------------------------------------------------------
+
+bit::tools::trigram_index::size_type
+  bit::tools::trigram_index::decode( std::uint32_t* indices,
+                                     const posting_list& list,
+                                     size_type b )
+  const noexcept
+{
+  const auto& current = m_blocks[list.first_block + b];
+  const auto count = std::min( block_size, size_type{list.count} - b * block_size );
+
+  auto in    = m_deltas.data() + current.offset;
+  auto index = current.first;
+
+  indices[0] = index;
+  for( auto i = size_type{1}; i < count; ++i ) {
+    index += read_varint( in );
+    indices[i] = index;
+  }
+  return count;
+}
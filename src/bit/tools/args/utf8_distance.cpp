@@ -0,0 +1,272 @@
+#include <bit/tools/args/distance_metric.hpp>
+
+#include <algorithm> // std::max
+#include <cstdint>   // std::uint32_t, std::uint64_t
+#include <cstring>   // std::memcpy
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define BIT_TOOLS_ARGS_HAS_SSE2 1
+# include <emmintrin.h>
+#endif
+
+namespace {
+
+  using u32string_view = bit::stl::basic_string_view<char32_t>;
+
+  //--------------------------------------------------------------------------
+  // ASCII Detection
+  //--------------------------------------------------------------------------
+
+  /// \brief Returns whether every byte of \p str is below 0x80
+  ///
+  /// The bytes are OR-ed together 16 at a time, and only the high bit of
+  /// the result is tested, once per 64 bytes. Shorter runs are tested 8
+  /// bytes at a time, as flags usually are.
+  ///
+  /// \param str the string to test
+  /// \return \c true if \p str is ASCII
+  bool is_ascii( bit::stl::string_view str )
+    noexcept
+  {
+    auto i = std::size_t{0};
+
+#ifdef BIT_TOOLS_ARGS_HAS_SSE2
+    const auto load = [&]( std::size_t offset ) {
+      return _mm_loadu_si128( reinterpret_cast<const __m128i*>(str.data() + offset) );
+    };
+
+    for( ; i + 64 <= str.size(); i += 64 ) {
+      const auto bits = _mm_or_si128( _mm_or_si128( load( i ), load( i + 16 ) ),
+                                      _mm_or_si128( load( i + 32 ), load( i + 48 ) ) );
+      if( _mm_movemask_epi8( bits ) ) return false;
+    }
+    for( ; i + 16 <= str.size(); i += 16 ) {
+      if( _mm_movemask_epi8( load( i ) ) ) return false;
+    }
+#endif
+    auto bits = std::uint64_t{0};
+    for( ; i + 8 <= str.size(); i += 8 ) {
+      auto word = std::uint64_t{};
+      std::memcpy( &word, str.data() + i, sizeof(word) );
+      bits |= word;
+    }
+    for( ; i < str.size(); ++i ) {
+      bits |= static_cast<unsigned char>(str[i]);
+    }
+    return (bits & 0x8080808080808080ull) == 0;
+  }
+
+  //--------------------------------------------------------------------------
+  // Decoding
+  //--------------------------------------------------------------------------
+
+  /// \brief Decodes the UTF-8 \p str into \p dst
+  ///
+  /// Each byte that does not begin a well-formed sequence, such as a stray
+  /// continuation byte, an overlong encoding or an encoded surrogate, is
+  /// decoded on its own as U+DC80 to U+DCFF. These never occur in valid
+  /// text, so invalid bytes still compare equal only to themselves, and
+  /// each costs one edit.
+  ///
+  /// \param dst storage for at least <tt>str.size()</tt> code points
+  /// \param str the string to decode
+  /// \return the number of code points decoded
+  std::size_t decode_utf8( char32_t* dst, bit::stl::string_view str )
+    noexcept
+  {
+    const auto* const src = reinterpret_cast<const unsigned char*>(str.data());
+    const auto n = str.size();
+
+    const auto continuation = [&]( std::size_t i ) {
+      return i < n && (src[i] & 0xc0u) == 0x80u;
+    };
+
+    auto count = std::size_t{0};
+    auto i     = std::size_t{0};
+    while( i < n ) {
+      const auto c = std::uint32_t{src[i]};
+
+      if( c < 0x80u ) {
+        dst[count++] = static_cast<char32_t>(c);
+        ++i;
+        continue;
+      }
+
+      // The bounds of the second byte exclude overlong encodings,
+      // surrogates, and values beyond U+10FFFF
+      auto length = std::size_t{0};
+      auto low    = 0x80u;
+      auto high   = 0xbfu;
+      if( c >= 0xc2u && c <= 0xdfu ) {
+        length = 2;
+      } else if( c >= 0xe0u && c <= 0xefu ) {
+        length = 3;
+        if( c == 0xe0u ) low  = 0xa0u;
+        if( c == 0xedu ) high = 0x9fu;
+      } else if( c >= 0xf0u && c <= 0xf4u ) {
+        length = 4;
+        if( c == 0xf0u ) low  = 0x90u;
+        if( c == 0xf4u ) high = 0x8fu;
+      }
+
+      auto valid = length != 0 && i + 1 < n && src[i + 1] >= low && src[i + 1] <= high;
+      for( auto k = std::size_t{2}; valid && k < length; ++k ) {
+        valid = continuation( i + k );
+      }
+
+      if( !valid ) {
+        dst[count++] = static_cast<char32_t>(0xdc00u + c);
+        ++i;
+        continue;
+      }
+
+      auto cp = c & (0x7fu >> length);
+      for( auto k = std::size_t{1}; k < length; ++k ) {
+        cp = (cp << 6) | (src[i + k] & 0x3fu);
+      }
+      dst[count++] = static_cast<char32_t>(cp);
+      i += length;
+    }
+    return count;
+  }
+
+  //--------------------------------------------------------------------------
+
+  /// \brief Returns whether byte \p i of \p str is a continuation byte
+  inline bool is_continuation( bit::stl::string_view str, std::size_t i )
+    noexcept
+  {
+    return i < str.size() && (static_cast<unsigned char>(str[i]) & 0xc0u) == 0x80u;
+  }
+
+  /// \brief Removes the common prefix and suffix of \p lhs and \p rhs,
+  ///        keeping the whole of any code point that differs
+  ///
+  /// A multi-byte sequence is a lead byte followed only by continuation
+  /// bytes, so a boundary that falls on neither string's continuation byte
+  /// never splits a sequence, and both sides decode as they would have in
+  /// the whole string.
+  ///
+  /// \param lhs the first string
+  /// \param rhs the second string
+  void trim_utf8_affixes( bit::stl::string_view& lhs,
+                          bit::stl::string_view& rhs )
+    noexcept
+  {
+    auto l = lhs;
+    auto r = rhs;
+    bit::tools::detail::trim_affixes( l, r );
+
+    auto prefix = static_cast<std::size_t>(l.data() - lhs.data());
+    auto suffix = lhs.size() - prefix - l.size();
+
+    while( prefix > 0 && (is_continuation( lhs, prefix ) || is_continuation( rhs, prefix )) ) {
+      --prefix;
+    }
+    // The suffix is common, so only one side needs testing
+    while( suffix > 0 && is_continuation( lhs, lhs.size() - suffix ) ) {
+      --suffix;
+    }
+
+    lhs = lhs.substr( prefix, lhs.size() - prefix - suffix );
+    rhs = rhs.substr( prefix, rhs.size() - prefix - suffix );
+  }
+
+  //--------------------------------------------------------------------------
+
+  /// \brief Computes the distance of \p lhs and \p rhs by code point,
+  ///        unless both are ASCII
+  ///
+  /// \param lhs the first string
+  /// \param rhs the second string
+  /// \param max the largest distance of interest
+  /// \param bytes the distance of byte strings
+  /// \param code_points the distance of code point strings
+  /// \return the distance, or \p max + 1 if it exceeds \p max
+  template<typename ByteDistance, typename CodePointDistance>
+  std::size_t utf8_distance( bit::stl::string_view lhs,
+                             bit::stl::string_view rhs,
+                             std::size_t max,
+                             ByteDistance&& bytes,
+                             CodePointDistance&& code_points )
+    noexcept
+  {
+    // A byte is a code point in ASCII, so the byte kernels are exact
+    if( is_ascii( lhs ) && is_ascii( rhs ) ) {
+      return bytes( lhs, rhs, max );
+    }
+
+    // Only the part that differs needs to be decoded
+    trim_utf8_affixes( lhs, rhs );
+
+    // Neither string decodes to more code points than it has bytes
+    auto* const storage = bit::tools::detail::scratch_storage<char32_t>( lhs.size() + rhs.size() );
+    const auto lhs_size = decode_utf8( storage, lhs );
+    const auto rhs_size = decode_utf8( storage + lhs_size, rhs );
+
+    return code_points( u32string_view{ storage, lhs_size },
+                        u32string_view{ storage + lhs_size, rhs_size },
+                        max );
+  }
+
+} // anonymous namespace
+
+//----------------------------------------------------------------------------
+// UTF-8 metrics
+//----------------------------------------------------------------------------
+
+constexpr bit::tools::utf8_levenshtein_metric::size_type
+  bit::tools::utf8_levenshtein_metric::default_max_distance;
+
+constexpr bit::tools::utf8_damerau_levenshtein_metric::size_type
+  bit::tools::utf8_damerau_levenshtein_metric::default_max_distance;
+
+//----------------------------------------------------------------------------
+// UTF-8 levenshtein distances
+//----------------------------------------------------------------------------
+
+std::size_t bit::tools::utf8_levenshtein_distance( stl::string_view lhs,
+                                                   stl::string_view rhs )
+  noexcept
+{
+  return utf8_levenshtein_distance( lhs, rhs, std::max( lhs.size(), rhs.size() ) );
+}
+
+std::size_t bit::tools::utf8_levenshtein_distance( stl::string_view lhs,
+                                                   stl::string_view rhs,
+                                                   std::size_t max )
+  noexcept
+{
+  return utf8_distance( lhs, rhs, max,
+    []( stl::string_view l, stl::string_view r, std::size_t m ) {
+      return levenshtein_distance( l, r, m );
+    },
+    []( u32string_view l, u32string_view r, std::size_t m ) {
+      return levenshtein_distance( l, r, m );
+    }
+  );
+}
+
+//----------------------------------------------------------------------------
+
+std::size_t bit::tools::utf8_damerau_levenshtein_distance( stl::string_view lhs,
+                                                           stl::string_view rhs )
+  noexcept
+{
+  return utf8_damerau_levenshtein_distance( lhs, rhs, std::max( lhs.size(), rhs.size() ) );
+}
+
+std::size_t bit::tools::utf8_damerau_levenshtein_distance( stl::string_view lhs,
+                                                           stl::string_view rhs,
+                                                           std::size_t max )
+  noexcept
+{
+  return utf8_distance( lhs, rhs, max,
+    []( stl::string_view l, stl::string_view r, std::size_t m ) {
+      return damerau_levenshtein_distance( l, r, m );
+    },
+    []( u32string_view l, u32string_view r, std::size_t m ) {
+      return damerau_levenshtein_distance( l, r, m );
+    }
+  );
+}
@@ -0,0 +1,242 @@
+#include <bit/tools/args/weighted_distance.hpp>
+
+#include <bit/tools/args/distance_metric.hpp>
+#include <bit/tools/args/edit_distance.hpp>
+
+#include <algorithm> // std::min, std::max, std::equal, std::swap
+
+namespace {
+
+  /// The costs of keyboard_distance, built at compile time
+  constexpr auto qwerty_costs = bit::tools::make_qwerty_cost_table();
+
+  /// The number of cells per row that are kept on the stack before falling
+  /// back to per-thread scratch storage
+  constexpr std::size_t stack_cells = bit::tools::detail::distance_stack_cells;
+
+  /// The smallest number of insertions or deletions within the bound for
+  /// which the unweighted distance is computed first, to reject pairs
+  /// before building the band
+  constexpr std::size_t min_prefilter_reach = 4;
+
+  //--------------------------------------------------------------------------
+  // Weighted optimal string alignment distance
+  //--------------------------------------------------------------------------
+
+  /// \brief Computes the weighted optimal string alignment distance of
+  ///        \p lhs and \p rhs, if it does not exceed \p max, within the
+  ///        diagonal band of \p reach insertions or deletions
+  ///
+  /// \p rhs must be the shorter string, and must be no more than \p reach
+  /// shorter than \p lhs.
+  ///
+  /// \param lhs the longer string
+  /// \param rhs the shorter string
+  /// \param costs the costs of each edit
+  /// \param max the maximum distance of interest
+  /// \param reach the number of insertions or deletions that \p max affords
+  /// \param band storage for <tt>3 * (2 * reach + 3)</tt> cells
+  /// \return the distance, or \p max + 1 if it exceeds \p max
+  std::size_t weighted_band( bit::stl::string_view lhs,
+                             bit::stl::string_view rhs,
+                             const bit::tools::edit_cost_table& costs,
+                             std::size_t max,
+                             std::size_t reach,
+                             std::size_t* band )
+    noexcept
+  {
+    const auto n      = lhs.size();
+    const auto m      = rhs.size();
+    const auto limit  = max + 1;
+    const auto width  = 2 * reach + 1;
+    const auto stride = width + 2;
+    const auto edit   = std::size_t{costs.edit()};
+    const auto swap   = std::size_t{costs.transposition()};
+    const auto target = m + reach - n; // The diagonal of row n, column m
+
+    const auto steps = []( std::size_t from, std::size_t to ) {
+      return (from < to) ? (to - from) : (from - to);
+    };
+
+    // Rows i-2, i-1 and i, each with a sentinel on either side. Cell d of
+    // row i is column j = i + d - reach
+    auto* before   = band + 1;
+    auto* previous = before + stride;
+    auto* current  = previous + stride;
+
+    for( auto d = std::size_t{0}; d <= width; ++d ) {
+      before[d]   = limit;
+      previous[d] = (d < reach) ? limit : std::min( (d - reach) * edit, limit );
+    }
+    before[-1] = previous[-1] = current[-1] = limit;
+    current[width] = limit;
+
+    auto before_min   = limit;
+    auto previous_min = std::size_t{0};
+    auto cheapest     = reach; // The diagonal of the cheapest cell of row i-1
+
+    // A row is a cone when each cell costs what its cheapest cell does,
+    // plus the insertions or deletions between them, after the cut-off
+    // below; no other path to any cell then costs less
+    const auto is_cone = [&]( const std::size_t* row ) {
+      for( auto d = std::size_t{0}; d < width; ++d ) {
+        const auto value = row[cheapest] + steps( d, cheapest ) * edit;
+        if( row[d] != ((value + steps( d, target ) * edit > max) ? limit : value) ) return false;
+      }
+      return true;
+    };
+
+    for( auto i = std::size_t{1}; i <= n; ++i ) {
+      // While rows i-2 and i-1 are the same cone, a match on the diagonal
+      // of its cheapest cell leaves row i the same cone too, so the whole
+      // run of matches is skipped at once. Rows that reach past either end
+      // of rhs are left to the loop below
+      if( i > reach && i + reach <= m && previous_min <= max &&
+          lhs[i - 1] == rhs[i + cheapest - reach - 1] &&
+          std::equal( previous, previous + width, before ) && is_cone( previous ) ) {
+        auto k = i;
+        while( k <= n && k + reach <= m && lhs[k - 1] == rhs[k + cheapest - reach - 1] ) {
+          ++k;
+        }
+        i = k;
+        if( i > n ) break;
+      }
+
+      // No cell costs less than the cheapest of the two rows above, and
+      // only the diagonals that many edits from the one of the result can
+      // lead to it (Ukkonen's cut-off)
+      const auto spread = (max - std::min( before_min, previous_min )) / edit;
+      const auto low    = (target > spread) ? (target - spread) : std::size_t{0};
+      const auto high   = std::min( width, target + spread + 1 );
+
+      // Cells before column 0 or after column m lie outside the table
+      const auto first = (i < reach) ? (reach - i) : std::size_t{0};
+      const auto last  = std::min( high, m + reach + 1 - i );
+
+      auto d = std::size_t{0};
+      for( ; d < std::max( first, low ); ++d ) {
+        current[d] = limit;
+      }
+
+      const auto a = lhs[i - 1];
+      auto row_min = limit;
+      cheapest = d;
+
+      if( i <= reach && d == first ) {
+        current[d] = std::min( i * edit, limit );
+        row_min    = current[d];
+        ++d;
+      }
+
+      for( ; d < last; ++d ) {
+        const auto j = i + d - reach;
+        const auto b = rhs[j - 1];
+
+        // Diagonal d is row i-1, column j-1; d+1 is row i-1, column j;
+        // and d-1 is row i, column j-1
+        auto value = std::min( std::min( previous[d + 1], current[d - 1] ) + edit,
+                               previous[d] + costs.substitution( a, b ) );
+
+        // Row i-2, column j-2 lies on the same diagonal
+        if( i > 1 && j > 1 && a != b && a == rhs[j - 2] && lhs[i - 2] == b ) {
+          value = std::min( value, before[d] + swap );
+        }
+
+        // Only insertions or deletions lead from this diagonal to the one
+        // of the result
+        if( value + steps( d, target ) * edit > max ) value = limit;
+
+        current[d] = value;
+        if( value < row_min ) {
+          row_min  = value;
+          cheapest = d;
+        }
+      }
+
+      for( ; d < width; ++d ) {
+        current[d] = limit;
+      }
+
+      // A transposition may be cheaper than the substitutions it skips, so
+      // it takes two rows in which every cell exceeds the limit for the
+      // result to exceed it too
+      if( row_min > max && previous_min > max ) return limit;
+      before_min   = previous_min;
+      previous_min = row_min;
+
+      const auto oldest = before;
+      before   = previous;
+      previous = current;
+      current  = oldest;
+      current[width] = limit;
+    }
+    return previous[target];
+  }
+
+} // anonymous namespace
+
+//----------------------------------------------------------------------------
+// Weighted distances
+//----------------------------------------------------------------------------
+
+std::size_t bit::tools::weighted_distance( stl::string_view lhs,
+                                           stl::string_view rhs,
+                                           const edit_cost_table& costs )
+  noexcept
+{
+  // Every character can be deleted from one side and inserted on the other
+  return weighted_distance( lhs, rhs, costs, (lhs.size() + rhs.size()) * costs.edit() );
+}
+
+std::size_t bit::tools::weighted_distance( stl::string_view lhs,
+                                           stl::string_view rhs,
+                                           const edit_cost_table& costs,
+                                           std::size_t max )
+  noexcept
+{
+  detail::trim_affixes( lhs, rhs );
+
+  if( lhs.size() < rhs.size() ) std::swap( lhs, rhs );
+
+  const auto reach = max / costs.edit();
+
+  // Each character of difference in length requires an insertion
+  if( lhs.size() - rhs.size() > reach ) return max + 1;
+
+  if( rhs.empty() ) return std::min( lhs.size() * costs.edit(), max + 1 );
+
+  // Every edit costs at least 1, so the weighted distance is never less
+  // than the unweighted one, which the bit-parallel kernel bounds in O(n)
+  // words. A narrow band, or one that covers most of a short table, is as
+  // cheap as the kernel and rejects as early, so this is only worth it in
+  // between
+  if( reach >= min_prefilter_reach && rhs.size() >= 4 * reach &&
+      damerau_levenshtein_distance( lhs, rhs, max ) > max ) {
+    return max + 1;
+  }
+
+  const auto band_cells = 3 * (2 * reach + 3);
+
+  if( band_cells <= stack_cells * 3 ) {
+    std::size_t band[stack_cells * 3];
+    return weighted_band( lhs, rhs, costs, max, reach, band );
+  }
+  return weighted_band( lhs, rhs, costs, max, reach, detail::scratch_storage<std::size_t>( band_cells ) );
+}
+
+//----------------------------------------------------------------------------
+
+std::size_t bit::tools::keyboard_distance( stl::string_view lhs,
+                                           stl::string_view rhs )
+  noexcept
+{
+  return weighted_distance( lhs, rhs, qwerty_costs );
+}
+
+std::size_t bit::tools::keyboard_distance( stl::string_view lhs,
+                                           stl::string_view rhs,
+                                           std::size_t max )
+  noexcept
+{
+  return weighted_distance( lhs, rhs, qwerty_costs, max );
+}